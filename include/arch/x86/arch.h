@@ -43,6 +43,9 @@ extern "C" {
 #ifdef CONFIG_INT_LATENCY_BENCHMARK
 void _int_latency_start(void);
 void _int_latency_stop(void);
+void int_latency_init(void);
+void int_latency_show(void);
+u32_t int_latency_max_get(void);
 #else
 #define _int_latency_start()  do { } while (0)
 #define _int_latency_stop()   do { } while (0)
@@ -14,6 +14,9 @@
 #include <zephyr/types.h>
 #include <stddef.h>
 
+#define CRC16_CCITT_POLY 0x1021
+#define CRC16_ANSI_POLY 0x8005
+
 /**
  * @brief Generic function for computing CRC 16
  *
@@ -31,6 +34,25 @@
 u16_t crc16(const u8_t *src, size_t len, u16_t polynomial,
 	       u16_t initial_value);
 
+/**
+ * @brief Continue a CRC 16 computation
+ *
+ * Update a CRC 16, as returned by crc16(), with more input bytes: the CRC
+ * of the concatenation of two buffers is the CRC of the first one updated
+ * with the second one. The CCITT and ANSI polynomials are table driven,
+ * unless CONFIG_CRC_BITWISE is set, other polynomials are computed one bit
+ * at a time.
+ *
+ * @param crc CRC of the preceding input bytes
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ * @param polynomial The polynomial to use omitting the leading x^16
+ *        coefficient
+ *
+ * @return The updated CRC16 value
+ */
+u16_t crc16_update(u16_t crc, const u8_t *src, size_t len, u16_t polynomial);
+
 /**
  * @brief Compute CCITT variant of CRC 16
  *
@@ -44,7 +66,23 @@ u16_t crc16(const u8_t *src, size_t len, u16_t polynomial,
  */
 static inline u16_t crc16_ccitt(const u8_t *src, size_t len)
 {
-	return crc16(src, len, 0x1021, 0xffff);
+	return crc16(src, len, CRC16_CCITT_POLY, 0xffff);
+}
+
+/**
+ * @brief Continue a CCITT variant of CRC 16 computation
+ *
+ * @param crc CRC of the preceding input bytes, as returned by crc16_ccitt()
+ *        or by a previous call
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The updated CRC16 value
+ */
+static inline u16_t crc16_ccitt_update(u16_t crc, const u8_t *src,
+				       size_t len)
+{
+	return crc16_update(crc, src, len, CRC16_CCITT_POLY);
 }
 
 /**
@@ -60,7 +98,22 @@ static inline u16_t crc16_ccitt(const u8_t *src, size_t len)
  */
 static inline u16_t crc16_ansi(const u8_t *src, size_t len)
 {
-	return crc16(src, len, 0x8005, 0xffff);
+	return crc16(src, len, CRC16_ANSI_POLY, 0xffff);
+}
+
+/**
+ * @brief Continue an ANSI variant of CRC 16 computation
+ *
+ * @param crc CRC of the preceding input bytes, as returned by crc16_ansi()
+ *        or by a previous call
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The updated CRC16 value
+ */
+static inline u16_t crc16_ansi_update(u16_t crc, const u8_t *src, size_t len)
+{
+	return crc16_update(crc, src, len, CRC16_ANSI_POLY);
 }
 
 #endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2017 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief CRC 32 computation functions
+ */
+
+#ifndef __CRC32_H
+#define __CRC32_H
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+/**
+ * @brief Continue an IEEE 802.3 CRC 32 computation
+ *
+ * Update a CRC 32, as returned by crc32_ieee(), with more input bytes: the
+ * CRC of the concatenation of two buffers is the CRC of the first one
+ * updated with the second one. Pass 0 to start a new computation.
+ *
+ * @param crc CRC of the preceding input bytes
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The updated CRC32 value
+ */
+u32_t crc32_ieee_update(u32_t crc, const u8_t *src, size_t len);
+
+/**
+ * @brief Compute IEEE 802.3 CRC 32
+ *
+ * IEEE 802.3 CRC 32, as used by Ethernet, zlib and PNG, is using 0x04c11db7
+ * as its polynomial, processes bits LSB first, and both starts from and is
+ * inverted with 0xffffffff.
+ *
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The computed CRC32 value
+ */
+static inline u32_t crc32_ieee(const u8_t *src, size_t len)
+{
+	return crc32_ieee_update(0, src, len);
+}
+
+/**
+ * @brief Continue a CRC 32C computation
+ *
+ * Update a CRC 32C, as returned by crc32c(), with more input bytes. Pass 0
+ * to start a new computation.
+ *
+ * @param crc CRC of the preceding input bytes
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The updated CRC32C value
+ */
+u32_t crc32c_update(u32_t crc, const u8_t *src, size_t len);
+
+/**
+ * @brief Compute CRC 32C
+ *
+ * CRC 32C (Castagnoli), as used by iSCSI, SCTP and ext4, is using
+ * 0x1edc6f41 as its polynomial and is otherwise computed like the IEEE
+ * 802.3 CRC 32.
+ *
+ * @param src Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The computed CRC32C value
+ */
+static inline u32_t crc32c(const u8_t *src, size_t len)
+{
+	return crc32c_update(0, src, len);
+}
+
+#endif
@@ -98,17 +98,19 @@ typedef sys_dlist_t _wait_q_t;
 #endif
 
 #ifdef CONFIG_POLL
-#define _POLL_EVENT_OBJ_INIT \
-	.poll_event = NULL,
-#define _POLL_EVENT struct k_poll_event *poll_event
+#define _POLL_EVENT_OBJ_INIT(obj) \
+	.poll_events = SYS_DLIST_STATIC_INIT(&obj.poll_events),
+#define _POLL_EVENT sys_dlist_t poll_events
 #else
-#define _POLL_EVENT_OBJ_INIT
+#define _POLL_EVENT_OBJ_INIT(obj)
 #define _POLL_EVENT
 #endif
 
 struct k_thread;
 struct k_mutex;
+struct k_rwlock;
 struct k_sem;
+struct k_event;
 struct k_alert;
 struct k_msgq;
 struct k_mbox;
@@ -130,10 +132,24 @@ typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
 	sys_dnode_t node;
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+	/* leftmost child when queued in the timeout heap */
+	struct _timeout *child;
+	/* absolute expiry, in ticks of the timeout queue clock */
+	u32_t expiry;
+	/* insertion order, to expire timeouts on the same tick in FIFO */
+	u32_t seq;
+#endif
 	struct k_thread *thread;
 	sys_dlist_t *wait_q;
 	s32_t delta_ticks_from_prev;
 	_timeout_func_t func;
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* ticks the expiry may be delayed by, to share a wakeup */
+	s32_t slack;
+	/* ticks the current expiry was delayed by */
+	s32_t slack_delay;
+#endif
 };
 
 extern s32_t _timeout_remaining_get(struct _timeout *timeout);
@@ -189,9 +205,28 @@ struct _thread_base {
 		u16_t preempt;
 	};
 
+#ifdef CONFIG_SCHED_DEADLINE
+	/* absolute deadline, in hardware cycles */
+	u32_t deadline;
+#endif
+
 	/* data returned by APIs */
 	void *swap_data;
 
+	/* contended mutexes owned, for priority inheritance */
+	sys_dlist_t contended_mutexes;
+
+	/* mutex waited on, for transitive priority inheritance */
+	struct k_mutex *pended_mutex;
+
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+	/* reader-writer locks held to write, for priority inheritance */
+	sys_dlist_t write_rwlocks;
+#endif
+
+	/* priority set for the thread, not inherited from lock waiters */
+	int orig_prio;
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 	/* this thread's entry in a timeout queue */
 	struct _timeout timeout;
@@ -248,6 +283,11 @@ struct k_thread {
 	struct _thread_stack_info stack_info;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/* hardware cycles spent running, up to the last switch out */
+	u64_t runtime;
+#endif
+
 	/* arch-specifics: must always be at the end */
 	struct _thread_arch arch;
 };
@@ -286,6 +326,73 @@ enum execution_context_types {
  */
 extern void k_call_stacks_analyze(void);
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/**
+ * @brief CPU usage since boot, in hardware cycles
+ */
+struct k_cpu_stats {
+	/* cycles spent running threads other than the idle thread */
+	u64_t busy_cycles;
+	/* cycles spent running the idle thread */
+	u64_t idle_cycles;
+};
+
+/**
+ * @brief Get the execution time of a thread.
+ *
+ * This routine returns the number of hardware cycles @a thread has spent
+ * running since it was started, including the time spent in interrupts
+ * taken while it was running.
+ *
+ * @param thread ID of thread.
+ *
+ * @return Execution time, in hardware cycles.
+ */
+extern u64_t k_thread_runtime_get(k_tid_t thread);
+
+/**
+ * @brief Get the CPU usage of the system.
+ *
+ * This routine splits the hardware cycles elapsed since boot between the
+ * idle thread and all other threads.
+ *
+ * @param stats Structure to fill with the CPU usage.
+ *
+ * @return N/A
+ */
+extern void k_cpu_stats_get(struct k_cpu_stats *stats);
+#endif
+
+#ifdef CONFIG_SYS_CLOCK_WAKEUP_STATS
+/**
+ * @brief System clock activity since boot
+ */
+struct k_wakeup_stats {
+	/* system clock interrupts announcing ticks to the kernel */
+	u32_t announcements;
+	/* announcements that woke the system up from idle */
+	u32_t idle_wakeups;
+	/* announcements that expired at least one timeout */
+	u32_t expirations;
+	/* timeouts expired */
+	u32_t timeouts;
+};
+
+/**
+ * @brief Get the system clock activity.
+ *
+ * This routine counts the system clock interrupts, the times they woke
+ * the system up from idle and the timeouts they expired since boot. With
+ * tickless idle, the rate of idle wakeups is a good measure of the power
+ * spent waking up.
+ *
+ * @param stats Structure to fill with the system clock activity.
+ *
+ * @return N/A
+ */
+extern void k_wakeup_stats_get(struct k_wakeup_stats *stats);
+#endif
+
 /**
  * @} end defgroup profiling_apis
  */
@@ -577,13 +684,35 @@ extern int  k_thread_priority_get(k_tid_t thread);
  * @param thread ID of thread whose priority is to be set.
  * @param prio New priority.
  *
- * @warning Changing the priority of a thread currently involved in mutex
- * priority inheritance may result in undefined behavior.
+ * A thread that holds a mutex, or a reader-writer lock to write, keeps the
+ * priority it inherited from the threads waiting on it if that is higher.
  *
  * @return N/A
  */
 extern void k_thread_priority_set(k_tid_t thread, int prio);
 
+#ifdef CONFIG_SCHED_DEADLINE
+/**
+ * @brief Set a thread's deadline.
+ *
+ * This routine sets the deadline of @a thread to @a deadline hardware cycles
+ * from now. Among the ready threads of priority CONFIG_SCHED_DEADLINE_PRIO,
+ * the one with the earliest deadline is scheduled first, and preempts a
+ * thread of that priority with a later deadline. The deadline has no effect
+ * on threads of other priorities, and nothing happens when it is missed.
+ *
+ * A periodic thread would typically set the deadline of its next job just
+ * before sleeping until that job is released. Until it is set, the deadline
+ * of a thread is the time it was started.
+ *
+ * @param thread ID of thread whose deadline is to be set.
+ * @param deadline Deadline, in hardware cycles from now.
+ *
+ * @return N/A
+ */
+extern void k_thread_deadline_set(k_tid_t thread, int deadline);
+#endif
+
 /**
  * @brief Suspend a thread.
  *
@@ -1018,6 +1147,25 @@ extern void k_timer_init(struct k_timer *timer,
 extern void k_timer_start(struct k_timer *timer,
 			  s32_t duration, s32_t period);
 
+/**
+ * @brief Set the slack of a timer.
+ *
+ * This routine lets @a timer expire up to @a slack milliseconds after its
+ * due time, so that the kernel can expire it along with other timeouts and
+ * wake the system up once for all of them. The slack applies from the next
+ * time the timer is started, and to each of its periods; the period of a
+ * periodic timer is kept on average.
+ *
+ * The slack is ignored unless CONFIG_TIMEOUT_SLACK is enabled.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Maximum delay of the expiry (in milliseconds), should be
+ *                  smaller than the period of a periodic timer.
+ *
+ * @return N/A
+ */
+extern void k_timer_slack_set(struct k_timer *timer, s32_t slack);
+
 /**
  * @brief Stop a timer.
  *
@@ -1249,7 +1397,7 @@ struct k_queue {
 	{ \
 	.wait_q = SYS_DLIST_STATIC_INIT(&obj.wait_q), \
 	.data_q = SYS_SLIST_STATIC_INIT(&obj.data_q), \
-	_POLL_EVENT_OBJ_INIT \
+	_POLL_EVENT_OBJ_INIT(obj) \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -1374,6 +1522,33 @@ extern void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 extern void *k_queue_get(struct k_queue *queue, s32_t timeout);
 
+/**
+ * @brief Get a batch of elements from a queue.
+ *
+ * This routine removes up to @a max data items from the head of @a queue,
+ * or all of its data items if @a max is 0, in one operation, and appends
+ * them in order to @a list. If @a queue is empty, it waits up to @a timeout
+ * for a first data item, then removes as many of the data items added in
+ * the meantime as allowed by @a max.
+ *
+ * The first 32 bits of the data items are reserved for the kernel's use,
+ * as for k_queue_get(), and link the data items in @a list.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param queue Address of the queue.
+ * @param list Pointer to an initialized sys_slist_t object.
+ * @param max Maximum number of data items to remove, or 0 for all of them.
+ * @param timeout Waiting period to obtain a first data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+extern int k_queue_get_batch(struct k_queue *queue, sys_slist_t *list,
+			     int max, s32_t timeout);
+
 /**
  * @brief Query a queue to see if it has data available.
  *
@@ -1517,6 +1692,30 @@ struct k_fifo {
 #define k_fifo_get(fifo, timeout) \
 	k_queue_get((struct k_queue *) fifo, timeout)
 
+/**
+ * @brief Get a batch of elements from a fifo.
+ *
+ * This routine removes up to @a max data items from @a fifo, or all of its
+ * data items if @a max is 0, in one operation, and appends them in "first
+ * in, first out" order to @a list. If @a fifo is empty, it waits up to
+ * @a timeout for a first data item. The first 32 bits of the data items are
+ * reserved for the kernel's use.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param fifo Address of the fifo.
+ * @param list Pointer to an initialized sys_slist_t object.
+ * @param max Maximum number of data items to remove, or 0 for all of them.
+ * @param timeout Waiting period to obtain a first data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+#define k_fifo_get_batch(fifo, list, max, timeout) \
+	k_queue_get_batch((struct k_queue *) fifo, list, max, timeout)
+
 /**
  * @brief Query a fifo to see if it has data available.
  *
@@ -1884,6 +2083,41 @@ static inline int k_work_pending(struct k_work *work)
 extern void k_work_q_start(struct k_work_q *work_q, char *stack,
 			   size_t stack_size, int prio);
 
+/**
+ * @brief Start a workqueue served by a pool of threads.
+ *
+ * This routine starts workqueue @a work_q with @a num_threads work
+ * processing threads, which run forever. Work items submitted to the
+ * workqueue are processed by the first idle thread, so a handler that
+ * blocks or runs for a long time only delays the other work items once
+ * all the threads are busy.
+ *
+ * The threads use consecutive stacks of @a stack_size bytes starting at
+ * @a stacks, typically declared as a two-dimensional array:
+ *
+ * @code
+ * static char __stack stacks[NUM_THREADS][STACK_SIZE];
+ *
+ * k_work_q_pool_start(&work_q, stacks[0], STACK_SIZE, NUM_THREADS, prio);
+ * @endcode
+ *
+ * @warning
+ * Unlike with a single threaded workqueue, the handlers of different work
+ * items, or of a work item resubmitted while being processed, may run
+ * concurrently.
+ *
+ * @param work_q Address of workqueue.
+ * @param stacks Pointer to the work queue threads' stack space.
+ * @param stack_size Size of each work queue thread's stack (in bytes),
+ *                   a multiple of STACK_ALIGN.
+ * @param num_threads Number of work queue threads.
+ * @param prio Priority of the work queue's threads.
+ *
+ * @return N/A
+ */
+extern void k_work_q_pool_start(struct k_work_q *work_q, char *stacks,
+				size_t stack_size, int num_threads, int prio);
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -1951,6 +2185,24 @@ extern int k_delayed_work_submit_to_queue(struct k_work_q *work_q,
  */
 extern int k_delayed_work_cancel(struct k_delayed_work *work);
 
+/**
+ * @brief Set the slack of a delayed work item.
+ *
+ * This routine lets the countdown of delayed work item @a work complete up
+ * to @a slack milliseconds after its delay, so that the kernel can expire
+ * it along with other timeouts and wake the system up once for all of
+ * them. The slack applies from the next submission of the work item.
+ *
+ * The slack is ignored unless CONFIG_TIMEOUT_SLACK is enabled.
+ *
+ * @param work Address of delayed work item.
+ * @param slack Maximum delay of the submission (in milliseconds).
+ *
+ * @return N/A
+ */
+extern void k_delayed_work_slack_set(struct k_delayed_work *work,
+				     s32_t slack);
+
 /**
  * @brief Submit a work item to the system workqueue.
  *
@@ -2041,9 +2293,11 @@ static inline s32_t k_delayed_work_remaining_get(struct k_delayed_work *work)
 
 struct k_mutex {
 	_wait_q_t wait_q;
-	struct k_thread *owner;
+	/* owning thread, flagged while threads wait on the mutex */
+	atomic_t owner;
 	u32_t lock_count;
-	int owner_orig_prio;
+	/* entry in the list of contended mutexes of the owner */
+	sys_dnode_t owner_node;
 
 	_OBJECT_TRACING_NEXT_PTR(k_mutex);
 };
@@ -2051,9 +2305,8 @@ struct k_mutex {
 #define K_MUTEX_INITIALIZER(obj) \
 	{ \
 	.wait_q = SYS_DLIST_STATIC_INIT(&obj.wait_q), \
-	.owner = NULL, \
+	.owner = ATOMIC_INIT(0), \
 	.lock_count = 0, \
-	.owner_orig_prio = K_LOWEST_THREAD_PRIO, \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -2138,6 +2391,162 @@ extern void k_mutex_unlock(struct k_mutex *mutex);
  * @cond INTERNAL_HIDDEN
  */
 
+struct k_rwlock {
+	struct {
+		_wait_q_t readers; /* Reader wait queue */
+		_wait_q_t writers; /* Writer wait queue */
+	} wait_q;
+
+	struct k_thread *writer;	/* Thread holding the lock to write */
+	u32_t readers;			/* # threads holding it to read */
+
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+	/* entry in the list of locks held to write by the writer */
+	sys_dnode_t writer_node;
+#endif
+
+#ifdef CONFIG_POLL
+	/* pollers waiting for the lock to be free, or free to read */
+	sys_dlist_t poll_events;
+	sys_dlist_t read_poll_events;
+#endif
+
+	_OBJECT_TRACING_NEXT_PTR(k_rwlock);
+};
+
+#ifdef CONFIG_POLL
+#define _RWLOCK_POLL_EVENTS_INIT(obj) \
+	.poll_events = SYS_DLIST_STATIC_INIT(&obj.poll_events), \
+	.read_poll_events = SYS_DLIST_STATIC_INIT(&obj.read_poll_events),
+#else
+#define _RWLOCK_POLL_EVENTS_INIT(obj)
+#endif
+
+#define K_RWLOCK_INITIALIZER(obj) \
+	{ \
+	.wait_q.readers = SYS_DLIST_STATIC_INIT(&obj.wait_q.readers), \
+	.wait_q.writers = SYS_DLIST_STATIC_INIT(&obj.wait_q.writers), \
+	.writer = NULL, \
+	.readers = 0, \
+	_RWLOCK_POLL_EVENTS_INIT(obj) \
+	_OBJECT_TRACING_INIT \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The reader-writer lock can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name) \
+	struct k_rwlock name \
+		__in_section(_k_rwlock, static, name) = \
+		K_RWLOCK_INITIALIZER(name)
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * This routine initializes a reader-writer lock object, prior to its first
+ * use.
+ *
+ * Upon completion, the reader-writer lock is free.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return N/A
+ */
+extern void k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock to read.
+ *
+ * This routine locks @a rwlock for reading, along with any other thread
+ * reading. If a thread holds the lock to write, or waits to lock it to
+ * write, the calling thread waits until the lock is released by all the
+ * writers or until a timeout occurs.
+ *
+ * A thread holding the lock to read must not lock it again, since it would
+ * wait forever on itself if a writer started waiting in between.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock locked to read.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_rwlock_read_lock(struct k_rwlock *rwlock, s32_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock locked to read.
+ *
+ * This routine releases @a rwlock, locked to read by the calling thread.
+ * Once the last reader releases it, the lock goes to the highest priority
+ * thread waiting to write, if any.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return N/A
+ */
+extern void k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock to write.
+ *
+ * This routine locks @a rwlock for the exclusive use of the calling thread.
+ * If any thread holds the lock, the calling thread waits until it is
+ * released or until a timeout occurs. Threads waiting to write have
+ * precedence over threads waiting to read.
+ *
+ * If CONFIG_RWLOCK_PRIO_INHERIT is enabled, a thread holding the lock to
+ * write inherits the priority of the threads waiting on the lock.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the lock (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock locked to write.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_rwlock_write_lock(struct k_rwlock *rwlock, s32_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock locked to write.
+ *
+ * This routine releases @a rwlock, locked to write by the calling thread.
+ * The lock goes to the highest priority thread waiting to write, if any,
+ * or else to all the threads waiting to read.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return N/A
+ */
+extern void k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @} end defgroup rwlock_apis
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
 struct k_sem {
 	_wait_q_t wait_q;
 	unsigned int count;
@@ -2152,7 +2561,7 @@ struct k_sem {
 	.wait_q = SYS_DLIST_STATIC_INIT(&obj.wait_q), \
 	.count = initial_count, \
 	.limit = count_limit, \
-	_POLL_EVENT_OBJ_INIT \
+	_POLL_EVENT_OBJ_INIT(obj) \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -2265,6 +2674,156 @@ static inline unsigned int k_sem_count_get(struct k_sem *sem)
  * @} end defgroup semaphore_apis
  */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	u32_t events;
+
+	_OBJECT_TRACING_NEXT_PTR(k_event);
+};
+
+#define K_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = SYS_DLIST_STATIC_INIT(&obj.wait_q), \
+	.events = 0, \
+	_OBJECT_TRACING_INIT \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/** Wait for any of the events (default). */
+#define K_EVENT_WAIT_ANY 0
+
+/** Wait for all of the events. */
+#define K_EVENT_WAIT_ALL BIT(0)
+
+/** Clear the events waited for when the wait completes. */
+#define K_EVENT_WAIT_CLEAR BIT(1)
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	struct k_event name \
+		__in_section(_k_event, static, name) = \
+		K_EVENT_INITIALIZER(name)
+
+/**
+ * @brief Initialize an event object.
+ *
+ * This routine initializes an event object, prior to its first use.
+ *
+ * Upon completion, all the events of the object are cleared.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+extern void k_event_init(struct k_event *event);
+
+/**
+ * @brief Post events to an event object.
+ *
+ * This routine sets the events of @a events in @a event, keeping the other
+ * events as they are, and wakes up every thread whose wait condition is
+ * then met.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to post.
+ *
+ * @return N/A
+ */
+extern void k_event_post(struct k_event *event, u32_t events);
+
+/**
+ * @brief Set the events of an event object.
+ *
+ * This routine replaces all the events of @a event by @a events, and wakes
+ * up every thread whose wait condition is then met.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events.
+ *
+ * @return N/A
+ */
+extern void k_event_set(struct k_event *event, u32_t events);
+
+/**
+ * @brief Clear events of an event object.
+ *
+ * This routine clears the events of @a events in @a event.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to clear.
+ *
+ * @return Set of events of the object before they were cleared.
+ */
+extern u32_t k_event_clear(struct k_event *event, u32_t events);
+
+/**
+ * @brief Wait for events of an event object.
+ *
+ * This routine waits until any of the events of @a events is set in
+ * @a event, or all of them if @a options contains K_EVENT_WAIT_ALL. If
+ * @a options contains K_EVENT_WAIT_CLEAR, the events of @a events that are
+ * set are cleared when the wait completes, after every thread waiting on
+ * them has been woken up.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to wait for.
+ * @param options Combination of K_EVENT_WAIT_ALL and K_EVENT_WAIT_CLEAR,
+ *                or K_EVENT_WAIT_ANY.
+ * @param timeout Waiting period (in milliseconds), or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Set of events of @a events that were set when the wait
+ *         completed, or 0 if the events were not set in time.
+ */
+extern u32_t k_event_wait(struct k_event *event, u32_t events,
+			  u32_t options, s32_t timeout);
+
+/**
+ * @brief Get the events of an event object.
+ *
+ * @param event Address of the event object.
+ *
+ * @return Set of events of the object.
+ */
+static inline u32_t k_event_get(struct k_event *event)
+{
+	return event->events;
+}
+
+/**
+ * @} end defgroup event_apis
+ */
+
 /**
  * @defgroup alert_apis Alert APIs
  * @ingroup kernel_apis
@@ -2412,6 +2971,8 @@ struct k_msgq {
 	char *read_ptr;
 	char *write_ptr;
 	u32_t used_msgs;
+	u8_t reserved;
+	u8_t borrowed;
 
 	_OBJECT_TRACING_NEXT_PTR(k_msgq);
 };
@@ -2426,6 +2987,8 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	.reserved = 0, \
+	.borrowed = 0, \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -2505,6 +3068,46 @@ extern void k_msgq_init(struct k_msgq *q, char *buffer,
  */
 extern int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Reserve a message slot in a message queue.
+ *
+ * This routine reserves the slot of message queue @a q that the next
+ * message sent is stored in, so that the message can be written in place
+ * instead of being copied. The message is sent by calling k_msgq_commit().
+ *
+ * Only one slot of a message queue can be reserved at a time, and the
+ * message queue must not be sent to by other means until the message is
+ * committed; zero-copy sending is meant for a message queue with a single
+ * sending thread.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param slot Address of a pointer set to the reserved slot.
+ * @param timeout Waiting period to reserve a slot (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Slot reserved.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_msgq_reserve(struct k_msgq *q, void **slot, s32_t timeout);
+
+/**
+ * @brief Send the message written in a reserved message slot.
+ *
+ * This routine sends the message written in the slot reserved by
+ * k_msgq_reserve(). The message is given to a waiting thread, if one
+ * exists, or stays in place in the message queue's ring buffer.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param q Address of the message queue.
+ *
+ * @return N/A
+ */
+extern void k_msgq_commit(struct k_msgq *q);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -2524,6 +3127,47 @@ extern int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
  */
 extern int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Borrow the first message of a message queue.
+ *
+ * This routine gives access to the first message of message queue @a q in
+ * its ring buffer slot, so that it can be read in place instead of being
+ * copied. The message stays in the message queue, and its slot can not be
+ * reused, until it is released by calling k_msgq_release().
+ *
+ * Only one message of a message queue can be borrowed at a time, and the
+ * message queue must not be received from or purged until the message is
+ * released; zero-copy receiving is meant for a message queue with a single
+ * receiving thread.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param slot Address of a pointer set to the slot of the message.
+ * @param timeout Waiting period to receive the message (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message borrowed.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_msgq_peek(struct k_msgq *q, void **slot, s32_t timeout);
+
+/**
+ * @brief Release a borrowed message.
+ *
+ * This routine removes the message borrowed by k_msgq_peek() from message
+ * queue @a q, and gives its slot to the first thread waiting to send a
+ * message, if one exists.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param q Address of the message queue.
+ *
+ * @return N/A
+ */
+extern void k_msgq_release(struct k_msgq *q);
+
 /**
  * @brief Purge a message queue.
  *
@@ -2541,7 +3185,7 @@ extern void k_msgq_purge(struct k_msgq *q);
  * @brief Get the amount of free space in a message queue.
  *
  * This routine returns the number of unused entries in a message queue's
- * ring buffer.
+ * ring buffer. A reserved entry is not unused.
  *
  * @param q Address of the message queue.
  *
@@ -2549,7 +3193,7 @@ extern void k_msgq_purge(struct k_msgq *q);
  */
 static inline u32_t k_msgq_num_free_get(struct k_msgq *q)
 {
-	return q->max_msgs - q->used_msgs;
+	return q->max_msgs - q->used_msgs - q->reserved;
 }
 
 /**
@@ -2912,6 +3556,72 @@ extern int k_pipe_get(struct k_pipe *pipe, void *data,
 		      size_t bytes_to_read, size_t *bytes_read,
 		      size_t min_xfer, s32_t timeout);
 
+/**
+ * @brief Pipe data segment.
+ *
+ * An array of segments describes data scattered over several buffers,
+ * such as the fragments of a network buffer, for k_pipe_putv() and
+ * k_pipe_getv().
+ */
+struct k_pipe_iovec {
+	/** Address of the segment. */
+	void *base;
+	/** Size of the segment (in bytes). */
+	size_t len;
+};
+
+/**
+ * @brief Write scattered data to a pipe.
+ *
+ * This routine writes up to the total size of the @a iovcnt segments
+ * of @a iov to @a pipe, in order. The data is copied directly into the
+ * buffers of waiting readers, or into the pipe's ring buffer, without being
+ * gathered into a flat buffer first.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments holding the data to write.
+ * @param iovcnt Number of segments in @a iov.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EIO Returned without waiting; zero data bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ */
+extern int k_pipe_putv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		       int iovcnt, size_t *bytes_written,
+		       size_t min_xfer, s32_t timeout);
+
+/**
+ * @brief Read data from a pipe into scattered buffers.
+ *
+ * This routine reads up to the total size of the @a iovcnt segments of
+ * @a iov from @a pipe, filling the segments in order. The data is copied
+ * directly from the buffers of waiting writers, or from the pipe's ring
+ * buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to place the data read from pipe.
+ * @param iovcnt Number of segments in @a iov.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EIO Returned without waiting; zero data bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ */
+extern int k_pipe_getv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		       int iovcnt, size_t *bytes_read,
+		       size_t min_xfer, s32_t timeout);
+
 /**
  * @brief Write memory block to a pipe.
  *
@@ -2942,12 +3652,26 @@ struct k_mem_slab {
 	u32_t num_blocks;
 	size_t block_size;
 	char *buffer;
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	/* generation count in upper 16 bits, head block index + 1 in lower */
+	atomic_t free_list;
+	atomic_t num_used;
+#else
 	char *free_list;
 	u32_t num_used;
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab);
 };
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+#define _MEM_SLAB_FREE_LIST_INIT 0
+#define _MEM_SLAB_MAX_BLOCKS 0xffff
+#else
+#define _MEM_SLAB_FREE_LIST_INIT NULL
+#define _MEM_SLAB_MAX_BLOCKS 0xffffffff
+#endif
+
 #define K_MEM_SLAB_INITIALIZER(obj, slab_buffer, slab_block_size, \
 			       slab_num_blocks) \
 	{ \
@@ -2955,7 +3679,7 @@ struct k_mem_slab {
 	.num_blocks = slab_num_blocks, \
 	.block_size = slab_block_size, \
 	.buffer = slab_buffer, \
-	.free_list = NULL, \
+	.free_list = _MEM_SLAB_FREE_LIST_INIT, \
 	.num_used = 0, \
 	_OBJECT_TRACING_INIT \
 	}
@@ -2979,6 +3703,9 @@ struct k_mem_slab {
  * aligned to this boundary, @a slab_block_size must also be a multiple of
  * @a slab_align.
  *
+ * With CONFIG_MEM_SLAB_LOCKLESS, a memory slab can have at most 65535
+ * blocks; more fail the build.
+ *
  * The memory slab can be accessed outside the module where it is defined
  * using:
  *
@@ -2992,6 +3719,8 @@ struct k_mem_slab {
 #define K_MEM_SLAB_DEFINE(name, slab_block_size, slab_num_blocks, slab_align) \
 	char __noinit __aligned(slab_align) \
 		_k_mem_slab_buf_##name[(slab_num_blocks) * (slab_block_size)]; \
+	BUILD_ASSERT_MSG((slab_num_blocks) <= _MEM_SLAB_MAX_BLOCKS, \
+			 "too many blocks for memory slab " #name); \
 	struct k_mem_slab name \
 		__in_section(_k_mem_slab, static, name) = \
 		K_MEM_SLAB_INITIALIZER(name, _k_mem_slab_buf_##name, \
@@ -3008,15 +3737,19 @@ struct k_mem_slab {
  * To ensure that each memory block is similarly aligned to this boundary,
  * @a slab_block_size must also be a multiple of N.
  *
+ * With CONFIG_MEM_SLAB_LOCKLESS, a memory slab can have at most 65535
+ * blocks.
+ *
  * @param slab Address of the memory slab.
  * @param buffer Pointer to buffer used for the memory blocks.
  * @param block_size Size of each memory block (in bytes).
  * @param num_blocks Number of memory blocks.
  *
- * @return N/A
+ * @retval 0 Memory slab initialized.
+ * @retval -EINVAL Too many memory blocks.
  */
-extern void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
-			   size_t block_size, u32_t num_blocks);
+extern int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
+			  size_t block_size, u32_t num_blocks);
 
 /**
  * @brief Allocate memory from a memory slab.
@@ -3102,6 +3835,8 @@ struct k_mem_pool {
 	u16_t n_max;
 	u8_t n_levels;
 	u8_t max_inline_level;
+	/* bit l is set when the free list of level l is not empty */
+	u32_t free_levels;
 	struct k_mem_pool_lvl *levels;
 	_wait_q_t wait_q;
 };
@@ -3282,6 +4017,39 @@ extern void *k_malloc(size_t size);
  */
 extern void k_free(void *ptr);
 
+/**
+ * @brief Heap memory pool usage statistics.
+ *
+ * All sizes include the allocator's per-allocation overhead, since that
+ * memory is lost to the application as well.
+ */
+struct k_malloc_stats {
+	/** Bytes currently allocated. */
+	size_t used_bytes;
+	/** Highest value ever reached by @a used_bytes. */
+	size_t max_used_bytes;
+	/** Bytes currently free, constant once added to @a used_bytes. */
+	size_t free_bytes;
+	/** Size of the largest free block. */
+	size_t largest_free_block;
+};
+
+#if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+/**
+ * @brief Get heap memory pool usage statistics.
+ *
+ * This routine takes a snapshot of the heap memory pool usage. Comparing
+ * @a free_bytes with @a largest_free_block tells how fragmented the heap
+ * is: a request larger than the largest free block fails even if the total
+ * free space would be enough.
+ *
+ * @param stats Structure filled with the heap statistics.
+ *
+ * @return N/A
+ */
+extern void k_malloc_stats_get(struct k_malloc_stats *stats);
+#endif
+
 /**
  * @} end defgroup heap_apis
  */
@@ -3289,7 +4057,7 @@ extern void k_free(void *ptr);
 /* polling API - PRIVATE */
 
 #ifdef CONFIG_POLL
-#define _INIT_OBJ_POLL_EVENT(obj) do { (obj)->poll_event = NULL; } while ((0))
+#define _INIT_OBJ_POLL_EVENT(obj) sys_dlist_init(&(obj)->poll_events)
 #else
 #define _INIT_OBJ_POLL_EVENT(obj) do { } while ((0))
 #endif
@@ -3313,6 +4081,12 @@ enum _poll_types_bits {
 	/* queue/fifo/lifo data availability */
 	_POLL_TYPE_DATA_AVAILABLE,
 
+	/* reader-writer lock free to lock for writing */
+	_POLL_TYPE_RWLOCK_WRITABLE,
+
+	/* reader-writer lock free to lock for reading */
+	_POLL_TYPE_RWLOCK_READABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -3323,9 +4097,6 @@ enum _poll_states_bits {
 	/* default state when creating event */
 	_POLL_STATE_NOT_READY,
 
-	/* there was another poller already on the object */
-	_POLL_STATE_EADDRINUSE,
-
 	/* signaled by k_poll_signal() */
 	_POLL_STATE_SIGNALED,
 
@@ -3335,6 +4106,12 @@ enum _poll_states_bits {
 	/* data is available to read on queue/fifo/lifo */
 	_POLL_STATE_DATA_AVAILABLE,
 
+	/* reader-writer lock can be locked for writing */
+	_POLL_STATE_RWLOCK_WRITABLE,
+
+	/* reader-writer lock can be locked for reading */
+	_POLL_STATE_RWLOCK_READABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -3369,6 +4146,8 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_SEM_AVAILABLE _POLL_TYPE_BIT(_POLL_TYPE_SEM_AVAILABLE)
 #define K_POLL_TYPE_DATA_AVAILABLE _POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
+#define K_POLL_TYPE_RWLOCK_WRITABLE _POLL_TYPE_BIT(_POLL_TYPE_RWLOCK_WRITABLE)
+#define K_POLL_TYPE_RWLOCK_READABLE _POLL_TYPE_BIT(_POLL_TYPE_RWLOCK_READABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -3380,16 +4159,19 @@ enum k_poll_modes {
 
 /* public - values for k_poll_event.state bitfield */
 #define K_POLL_STATE_NOT_READY 0
-#define K_POLL_STATE_EADDRINUSE _POLL_STATE_BIT(_POLL_STATE_EADDRINUSE)
 #define K_POLL_STATE_SIGNALED _POLL_STATE_BIT(_POLL_STATE_SIGNALED)
 #define K_POLL_STATE_SEM_AVAILABLE _POLL_STATE_BIT(_POLL_STATE_SEM_AVAILABLE)
 #define K_POLL_STATE_DATA_AVAILABLE _POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
+#define K_POLL_STATE_RWLOCK_WRITABLE \
+	_POLL_STATE_BIT(_POLL_STATE_RWLOCK_WRITABLE)
+#define K_POLL_STATE_RWLOCK_READABLE \
+	_POLL_STATE_BIT(_POLL_STATE_RWLOCK_READABLE)
 
 /* public - poll signal object */
 struct k_poll_signal {
 	/* PRIVATE - DO NOT TOUCH */
-	struct k_poll_event *poll_event;
+	sys_dlist_t poll_events;
 
 	/*
 	 * 1 if the event has been signaled, 0 otherwise. Stays set to 1 until
@@ -3401,14 +4183,17 @@ struct k_poll_signal {
 	int result;
 };
 
-#define K_POLL_SIGNAL_INITIALIZER() \
+#define K_POLL_SIGNAL_INITIALIZER(obj) \
 	{ \
-	.poll_event = NULL, \
+	.poll_events = SYS_DLIST_STATIC_INIT(&obj.poll_events), \
 	.signaled = 0, \
 	.result = 0, \
 	}
 
 struct k_poll_event {
+	/* PRIVATE - DO NOT TOUCH */
+	sys_dnode_t _node;
+
 	/* PRIVATE - DO NOT TOUCH */
 	struct _poller *poller;
 
@@ -3434,6 +4219,7 @@ struct k_poll_event {
 		struct k_sem *sem;
 		struct k_fifo *fifo;
 		struct k_queue *queue;
+		struct k_rwlock *rwlock;
 	};
 };
 
@@ -3495,16 +4281,18 @@ extern void k_poll_event_init(struct k_poll_event *event, u32_t type,
  * reason, the k_poll() call is more effective when the objects being polled
  * only have one thread, the polling thread, trying to acquire them.
  *
- * Only one thread can be polling for a particular object at a given time. If
- * another thread tries to poll on it, the k_poll() call returns -EADDRINUSE
- * and returns as soon as it has finished handling the other events. This means
- * that k_poll() can return -EADDRINUSE and have the state value of some events
- * be non-K_POLL_STATE_NOT_READY. When this condition occurs, the @a timeout
- * parameter is ignored.
+ * Any number of threads can be polling for a particular object at the same
+ * time. When a semaphore is given or data is put in a fifo, either the
+ * polling thread of highest priority (the one that started polling first
+ * among threads of equal priority) or all the polling threads are notified,
+ * depending on CONFIG_POLL_WAKE_ONE and CONFIG_POLL_WAKE_ALL. A thread
+ * notified with CONFIG_POLL_WAKE_ONE is expected to acquire the object,
+ * since the other polling threads are only notified by the next give or
+ * put. All the threads polling for a poll signal are always notified.
  *
- * When k_poll() returns 0 or -EADDRINUSE, the caller should loop on all the
- * events that were passed to k_poll() and check the state field for the values
- * that were expected and take the associated actions.
+ * When k_poll() returns 0, the caller should loop on all the events that
+ * were passed to k_poll() and check the state field for the values that
+ * were expected and take the associated actions.
  *
  * Before being reused for another call to k_poll(), the user has to reset the
  * state field to K_POLL_STATE_NOT_READY.
@@ -3515,7 +4303,6 @@ extern void k_poll_event_init(struct k_poll_event *event, u32_t type,
  *                or one of the special values K_NO_WAIT and K_FOREVER.
  *
  * @retval 0 One or more events are ready.
- * @retval -EADDRINUSE One or more objects already had a poller.
  * @retval -EAGAIN Waiting period timed out.
  */
 
@@ -3538,8 +4325,8 @@ extern void k_poll_signal_init(struct k_poll_signal *signal);
  * @brief Signal a poll signal object.
  *
  * This routine makes ready a poll signal, which is basically a poll event of
- * type K_POLL_TYPE_SIGNAL. If a thread was polling on that event, it will be
- * made ready to run. A @a result value can be specified.
+ * type K_POLL_TYPE_SIGNAL. All the threads polling on that event are made
+ * ready to run. A @a result value can be specified.
  *
  * The poll signal contains a 'signaled' field that, when set by
  * k_poll_signal(), stays set until the user sets it back to 0. It thus has to
@@ -3550,14 +4337,13 @@ extern void k_poll_signal_init(struct k_poll_signal *signal);
  * @param result The value to store in the result field of the signal.
  *
  * @retval 0 The signal was delivered successfully.
- * @retval -EAGAIN The polling thread's timeout is in the process of expiring.
+ * @retval -EAGAIN A polling thread's timeout is in the process of expiring.
  */
 
 extern int k_poll_signal(struct k_poll_signal *signal, int result);
 
 /* private internal function */
-extern int _handle_obj_poll_event(struct k_poll_event **obj_poll_event,
-				  u32_t state);
+extern int _handle_obj_poll_events(sys_dlist_t *events, u32_t state);
 
 /**
  * @} end defgroup poll_apis
@@ -0,0 +1,296 @@
+/* byte_ring.h: Single producer, single consumer byte ring API */
+
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef __BYTE_RING_H__
+#define __BYTE_RING_H__
+
+#include <kernel.h>
+#include <misc/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A structure to represent a byte ring
+ *
+ * The head is only written by the producer and the tail only by the
+ * consumer. Both count bytes from the initialization of the ring and wrap
+ * around at 2^32, so that the ring can be filled completely.
+ */
+struct byte_ring {
+	u32_t head;	/**< Number of bytes put in the ring */
+	u32_t tail;	/**< Number of bytes got from the ring */
+	u32_t mask;	/**< Size of buf minus 1, the size is a power of 2 */
+	u8_t *buf;	/**< Memory region for stored bytes */
+#ifdef CONFIG_POLL
+	/** Raised when bytes are put in the empty ring */
+	struct k_poll_signal signal;
+#endif
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+#ifdef CONFIG_POLL
+#define _BYTE_RING_SIGNAL_INIT(name) \
+	.signal = K_POLL_SIGNAL_INITIALIZER(name.signal),
+#else
+#define _BYTE_RING_SIGNAL_INIT(name)
+#endif
+
+/*
+ * The producer publishes the bytes it wrote by storing the head with
+ * release semantics, and the consumer loads the head with acquire
+ * semantics before reading them; the same goes for the tail in the other
+ * direction, so that bytes are not overwritten before being read.
+ */
+static inline u32_t _byte_ring_index_get(u32_t *index)
+{
+	return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void _byte_ring_index_set(u32_t *index, u32_t value)
+{
+	__atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup byte_ring_apis Byte Ring APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a byte ring.
+ *
+ * This macro establishes a byte ring of 2^pow bytes, where @a pow is the
+ * specified byte ring size exponent.
+ *
+ * The byte ring can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct byte_ring <name>; @endcode
+ *
+ * @param name Name of the byte ring.
+ * @param pow Byte ring size exponent.
+ */
+#define SYS_BYTE_RING_DECLARE_POW2(name, pow) \
+	static u8_t _byte_ring_data_##name[1 << (pow)]; \
+	struct byte_ring name = { \
+		.mask = (1 << (pow)) - 1, \
+		.buf = _byte_ring_data_##name, \
+		_BYTE_RING_SIGNAL_INIT(name) \
+	}
+
+/**
+ * @brief Initialize a byte ring.
+ *
+ * This routine initializes a byte ring, prior to its first use. It is only
+ * used for byte rings not defined using SYS_BYTE_RING_DECLARE_POW2.
+ *
+ * @param ring Address of byte ring.
+ * @param size Byte ring size (in bytes), must be a power of 2.
+ * @param data Byte ring data area.
+ */
+static inline void sys_byte_ring_init(struct byte_ring *ring, u32_t size,
+				      u8_t *data)
+{
+	__ASSERT(is_power_of_two(size), "size must be a power of 2");
+
+	ring->head = 0;
+	ring->tail = 0;
+	ring->mask = size - 1;
+	ring->buf = data;
+#ifdef CONFIG_POLL
+	k_poll_signal_init(&ring->signal);
+#endif
+}
+
+/**
+ * @brief Get the number of bytes in a byte ring.
+ *
+ * @param ring Address of byte ring.
+ *
+ * @return Number of bytes that can be got from the byte ring.
+ */
+static inline u32_t sys_byte_ring_used_get(struct byte_ring *ring)
+{
+	return _byte_ring_index_get(&ring->head) -
+	       _byte_ring_index_get(&ring->tail);
+}
+
+/**
+ * @brief Get the free space in a byte ring.
+ *
+ * @param ring Address of byte ring.
+ *
+ * @return Number of bytes that can be put in the byte ring.
+ */
+static inline u32_t sys_byte_ring_space_get(struct byte_ring *ring)
+{
+	return ring->mask + 1 - sys_byte_ring_used_get(ring);
+}
+
+/**
+ * @brief Determine if a byte ring is empty.
+ *
+ * @param ring Address of byte ring.
+ *
+ * @return 1 if the byte ring is empty, or 0 if not.
+ */
+static inline int sys_byte_ring_is_empty(struct byte_ring *ring)
+{
+	return sys_byte_ring_used_get(ring) == 0;
+}
+
+/**
+ * @brief Claim a contiguous region of free space in a byte ring.
+ *
+ * This routine gives the producer direct access to the free space at the
+ * head of byte ring @a ring, for instance to receive data by DMA. The
+ * region claimed ends at the free space or at the end of the data area,
+ * whichever comes first, so a second claim may be needed to reach the
+ * free space at the start of the data area. The bytes written in the
+ * region are put in the byte ring by sys_byte_ring_put_commit().
+ *
+ * @param ring Address of byte ring.
+ * @param data Address of a pointer set to the start of the region.
+ * @param size Maximum size of the region (in bytes).
+ *
+ * @return Size of the region (in bytes), 0 if the byte ring is full.
+ */
+u32_t sys_byte_ring_put_claim(struct byte_ring *ring, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Put bytes written in place in a byte ring.
+ *
+ * This routine makes @a size bytes written at the head of byte ring
+ * @a ring, in regions obtained by sys_byte_ring_put_claim(), available to
+ * the consumer.
+ *
+ * @param ring Address of byte ring.
+ * @param size Number of bytes to put, at most the free space of the ring.
+ */
+void sys_byte_ring_put_commit(struct byte_ring *ring, u32_t size);
+
+/**
+ * @brief Claim a contiguous region of data in a byte ring.
+ *
+ * This routine gives the consumer direct access to the data at the tail of
+ * byte ring @a ring. The region claimed ends at the end of the data or at
+ * the end of the data area, whichever comes first. The bytes read from
+ * the region are removed from the byte ring by sys_byte_ring_get_commit().
+ *
+ * @param ring Address of byte ring.
+ * @param data Address of a pointer set to the start of the region.
+ * @param size Maximum size of the region (in bytes).
+ *
+ * @return Size of the region (in bytes), 0 if the byte ring is empty.
+ */
+u32_t sys_byte_ring_get_claim(struct byte_ring *ring, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Remove bytes read in place from a byte ring.
+ *
+ * This routine frees the space of @a size bytes read at the tail of byte
+ * ring @a ring, in regions obtained by sys_byte_ring_get_claim().
+ *
+ * @param ring Address of byte ring.
+ * @param size Number of bytes to remove, at most the data in the ring.
+ */
+void sys_byte_ring_get_commit(struct byte_ring *ring, u32_t size);
+
+/**
+ * @brief Write bytes to a byte ring.
+ *
+ * This routine copies as many bytes from @a data as fit in byte ring
+ * @a ring.
+ *
+ * @warning
+ * A byte ring supports one producer and one consumer, which can be an ISR
+ * and a thread, without locking. Use cases involving multiple producers
+ * must prevent concurrent write operations.
+ *
+ * @param ring Address of byte ring.
+ * @param data Address of the bytes to write.
+ * @param size Number of bytes to write.
+ *
+ * @return Number of bytes written.
+ */
+u32_t sys_byte_ring_put(struct byte_ring *ring, const u8_t *data,
+			u32_t size);
+
+/**
+ * @brief Read bytes from a byte ring.
+ *
+ * This routine copies up to @a size bytes from byte ring @a ring to
+ * @a data.
+ *
+ * @warning
+ * A byte ring supports one producer and one consumer, which can be an ISR
+ * and a thread, without locking. Use cases involving multiple consumers
+ * must prevent concurrent read operations.
+ *
+ * @param ring Address of byte ring.
+ * @param data Area to store the bytes read.
+ * @param size Size of the area (in bytes).
+ *
+ * @return Number of bytes read.
+ */
+u32_t sys_byte_ring_get(struct byte_ring *ring, u8_t *data, u32_t size);
+
+#ifdef CONFIG_POLL
+/**
+ * @brief Prepare to poll on a byte ring.
+ *
+ * The signal of a byte ring is raised by the producer when it puts bytes
+ * in the empty ring, and stays raised until reset. This routine resets the
+ * signal of byte ring @a ring and then checks if the ring is empty, so
+ * that bytes put after the check raise the signal again. A consumer must
+ * call it before polling on the signal along with other objects, and poll
+ * only if the ring is empty.
+ *
+ * @param ring Address of byte ring.
+ *
+ * @return 1 if the byte ring is empty, or 0 if not.
+ */
+int sys_byte_ring_poll_prepare(struct byte_ring *ring);
+
+/**
+ * @brief Wait for data in a byte ring.
+ *
+ * This routine waits until byte ring @a ring is not empty.
+ *
+ * @param ring Address of byte ring.
+ * @param timeout Waiting period (in milliseconds), or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 The byte ring is not empty.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_byte_ring_wait(struct byte_ring *ring, s32_t timeout);
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BYTE_RING_H__ */
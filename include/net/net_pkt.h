@@ -78,7 +78,10 @@ struct net_pkt {
 				 * Used only if defined(CONFIG_NET_ROUTE)
 				 */
 	u8_t family     : 4;	/* IPv4 vs IPv6 */
-	u8_t _unused    : 4;
+	u8_t sacked     : 1;	/* Is this selectively acknowledged
+				 * Used only if defined(CONFIG_NET_TCP)
+				 */
+	u8_t _unused    : 3;
 
 #if defined(CONFIG_NET_IPV6)
 	u8_t ipv6_hop_limit;	/* IPv6 hop limit for this network packet. */
@@ -195,6 +198,16 @@ static inline void net_pkt_set_sent(struct net_pkt *pkt, bool sent)
 {
 	pkt->sent = sent;
 }
+
+static inline u8_t net_pkt_sacked(struct net_pkt *pkt)
+{
+	return pkt->sacked;
+}
+
+static inline void net_pkt_set_sacked(struct net_pkt *pkt, bool sacked)
+{
+	pkt->sacked = sacked;
+}
 #endif
 
 #if defined(CONFIG_NET_ROUTE)
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel event object.
+ *
+ * An event object holds a set of 32 events that threads and ISRs post, and
+ * that threads wait for, any or all of a set at once. Posting events wakes
+ * up every waiting thread whose condition is met in a single pass over the
+ * wait queue, with at most one context switch at the end.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/object_tracing_common.h>
+#include <toolchain.h>
+#include <sections.h>
+#include <wait_q.h>
+#include <misc/dlist.h>
+#include <ksched.h>
+#include <init.h>
+
+extern struct k_event _k_event_list_start[];
+extern struct k_event _k_event_list_end[];
+
+struct k_event *_trace_list_k_event;
+
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+extern volatile int _handling_timeouts;
+#endif
+
+/* wait condition of a thread, pointed to by its swap_data */
+struct event_waiter {
+	u32_t events;
+	u32_t options;
+	u32_t matched;
+};
+
+#ifdef CONFIG_OBJECT_TRACING
+
+/*
+ * Complete initialization of statically defined event objects.
+ */
+static int init_event_module(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	struct k_event *event;
+
+	for (event = _k_event_list_start; event < _k_event_list_end; event++) {
+		SYS_TRACING_OBJ_INIT(k_event, event);
+	}
+	return 0;
+}
+
+SYS_INIT(init_event_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+#endif /* CONFIG_OBJECT_TRACING */
+
+void k_event_init(struct k_event *event)
+{
+	sys_dlist_init(&event->wait_q);
+	event->events = 0;
+
+	SYS_TRACING_OBJ_INIT(k_event, event);
+}
+
+/* returns the events waited for that are set, 0 if the wait goes on */
+static u32_t match_events(u32_t current, u32_t events, u32_t options)
+{
+	u32_t matched = current & events;
+
+	if ((options & K_EVENT_WAIT_ALL) && matched != events) {
+		return 0;
+	}
+
+	return matched;
+}
+
+/*
+ * Wake up the threads whose condition is met by the current events, then
+ * clear the events they asked to.
+ *
+ * Must be called with interrupts locked, returns 1 if a reschedule must
+ * take place, 0 otherwise.
+ */
+static int wake_waiters(struct k_event *event)
+{
+	struct k_thread *thread, *next;
+	u32_t clear = 0;
+	int woken = 0;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&event->wait_q, thread, next,
+					  base.k_q_node) {
+		struct event_waiter *waiter = thread->base.swap_data;
+
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+		/* the timeout handling wakes up these threads itself */
+		if (_handling_timeouts && _is_thread_timeout_expired(thread)) {
+			continue;
+		}
+#endif
+
+		waiter->matched = match_events(event->events, waiter->events,
+					       waiter->options);
+		if (waiter->matched) {
+			if (waiter->options & K_EVENT_WAIT_CLEAR) {
+				clear |= waiter->matched;
+			}
+
+			_unpend_thread(thread);
+			_abort_thread_timeout(thread);
+			_ready_thread(thread);
+			_set_thread_return_value(thread, 0);
+			woken = 1;
+		}
+	}
+
+	event->events &= ~clear;
+
+	return woken && !_is_in_isr() && _must_switch_threads();
+}
+
+static void update_events(struct k_event *event, u32_t events, u32_t mask)
+{
+	unsigned int key = irq_lock();
+
+	event->events = (event->events & ~mask) | events;
+
+	if (wake_waiters(event)) {
+		_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+}
+
+void k_event_post(struct k_event *event, u32_t events)
+{
+	update_events(event, events, events);
+}
+
+void k_event_set(struct k_event *event, u32_t events)
+{
+	update_events(event, events, ~0);
+}
+
+u32_t k_event_clear(struct k_event *event, u32_t events)
+{
+	unsigned int key = irq_lock();
+	u32_t previous = event->events;
+
+	event->events &= ~events;
+
+	irq_unlock(key);
+
+	return previous;
+}
+
+u32_t k_event_wait(struct k_event *event, u32_t events, u32_t options,
+		   s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(events != 0, "no events to wait for");
+
+	struct event_waiter waiter;
+	unsigned int key = irq_lock();
+
+	waiter.matched = match_events(event->events, events, options);
+	if (waiter.matched) {
+		if (options & K_EVENT_WAIT_CLEAR) {
+			event->events &= ~waiter.matched;
+		}
+		irq_unlock(key);
+		return waiter.matched;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		irq_unlock(key);
+		return 0;
+	}
+
+	waiter.events = events;
+	waiter.options = options;
+	_current->base.swap_data = &waiter;
+
+	_pend_current_thread(&event->wait_q, timeout);
+
+	return _Swap(key) ? 0 : waiter.matched;
+}
@@ -64,12 +64,31 @@ struct _ready_q {
 	/* bitmap of priorities that contain at least one ready thread */
 	u32_t prio_bmap[K_NUM_PRIO_BITMAPS];
 
+#if (K_NUM_PRIO_BITMAPS > 1)
+	/* bitmap of prio_bmap words that are not empty */
+	u32_t prio_bmap_summary;
+#endif
+
 	/* ready queues, one per priority */
 	sys_dlist_t q[K_NUM_PRIORITIES];
 };
 
 typedef struct _ready_q _ready_q_t;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+struct _timeout_heap {
+
+	/* timeout expiring first, NULL if the heap is empty */
+	struct _timeout *root;
+
+	/* ticks announced to the timeout queue so far */
+	u32_t now;
+
+	/* sequence number given to the next timeout queued */
+	u32_t seq;
+};
+#endif
+
 struct _kernel {
 
 	/* nested interrupt count */
@@ -83,8 +102,12 @@ struct _kernel {
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 	/* queue of timeouts */
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+	struct _timeout_heap timeout_q;
+#else
 	sys_dlist_t timeout_q;
 #endif
+#endif
 
 #ifdef CONFIG_SYS_POWER_MANAGEMENT
 	s32_t idle; /* Number of ticks for kernel idling */
@@ -114,6 +137,14 @@ struct _kernel {
 	struct k_thread *threads; /* singly linked list of ALL fiber+tasks */
 #endif
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/* cycle count at the last context switch */
+	u32_t runtime_stamp;
+
+	/* cycles elapsed up to the last context switch */
+	u64_t runtime_total;
+#endif
+
 	/* arch-specific part of _kernel */
 	struct _kernel_arch arch;
 };
@@ -172,6 +203,10 @@ static ALWAYS_INLINE struct k_thread *_new_thread_init(char *pStack,
 	thread->stack_info.size = (u32_t)stackSize;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	thread->runtime = 0;
+#endif
+
 	return thread;
 }
 
@@ -24,6 +24,7 @@ extern void _pend_thread(struct k_thread *thread,
 			 _wait_q_t *wait_q, s32_t timeout);
 extern void _pend_current_thread(_wait_q_t *wait_q, s32_t timeout);
 extern void _move_thread_to_end_of_prio_q(struct k_thread *thread);
+extern void _adjust_owner_prio(struct k_thread *thread);
 extern int __must_switch_threads(void);
 extern int _is_thread_time_slicing(struct k_thread *thread);
 extern void _update_time_slice_before_swap(void);
@@ -204,19 +205,13 @@ static inline int _get_highest_ready_prio(void)
 	int bitmap = 0;
 	u32_t ready_range;
 
-#if (K_NUM_PRIORITIES <= 32)
-	ready_range = _ready_q.prio_bmap[0];
-#else
-	for (;; bitmap++) {
-
-		__ASSERT(bitmap < K_NUM_PRIO_BITMAPS, "prio out-of-range\n");
+#if (K_NUM_PRIO_BITMAPS > 1)
+	/* the summary tells which bitmap holds the highest ready priority */
+	__ASSERT(_ready_q.prio_bmap_summary, "no ready thread\n");
 
-		if (_ready_q.prio_bmap[bitmap]) {
-			ready_range = _ready_q.prio_bmap[bitmap];
-			break;
-		}
-	}
+	bitmap = find_lsb_set(_ready_q.prio_bmap_summary) - 1;
 #endif
+	ready_range = _ready_q.prio_bmap[bitmap];
 
 	int abs_prio = (find_lsb_set(ready_range) - 1) + (bitmap << 5);
 
@@ -225,6 +220,21 @@ static inline int _get_highest_ready_prio(void)
 	return abs_prio - _NUM_COOP_PRIO;
 }
 
+#ifdef CONFIG_SCHED_DEADLINE
+/* check if threads of a given prio are scheduled by earliest deadline */
+static inline int _is_deadline_prio(int prio)
+{
+	return prio == CONFIG_SCHED_DEADLINE_PRIO;
+}
+
+/* check if t1's deadline is earlier than t2's */
+static inline int _is_t1_deadline_before_t2(struct k_thread *t1,
+					    struct k_thread *t2)
+{
+	return (s32_t)(t1->base.deadline - t2->base.deadline) < 0;
+}
+#endif
+
 /*
  * Checks if current thread must be context-switched out. The caller must
  * already know that the execution context is a thread.
@@ -21,6 +21,11 @@
 
 #define K_NUM_PRIO_BITMAPS ((K_NUM_PRIORITIES + 31) >> 5)
 
+/* the ready queue summary bitmap has one bit per priority bitmap */
+#if (K_NUM_PRIO_BITMAPS > 32)
+#error "too many priorities: the ready queue supports up to 1024"
+#endif
+
 #ifndef _ASMLANGUAGE
 
 #ifdef __cplusplus
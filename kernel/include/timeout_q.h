@@ -49,6 +49,14 @@ static inline void _init_timeout(struct _timeout *t, _timeout_func_t func)
 	 */
 	t->func = func;
 
+#ifdef CONFIG_TIMEOUT_SLACK
+	/*
+	 * The slack is set by the owner of the timeout, it is only reset here.
+	 */
+	t->slack = 0;
+	t->slack_delay = 0;
+#endif
+
 	/*
 	 * These are initialized when enqueing on the timeout queue:
 	 *
@@ -116,6 +124,28 @@ static inline void _handle_expired_timeouts(sys_dlist_t *expired)
 	}
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+extern void _timeout_heap_insert(struct _timeout *timeout);
+extern void _timeout_heap_remove(struct _timeout *timeout);
+
+/* returns _INACTIVE if the timer is not active */
+static inline int _abort_timeout(struct _timeout *timeout)
+{
+	if (timeout->delta_ticks_from_prev == _INACTIVE) {
+		return _INACTIVE;
+	}
+
+	if (timeout->delta_ticks_from_prev == _EXPIRED) {
+		/* still on the local queue of expired timeouts */
+		sys_dlist_remove(&timeout->node);
+	} else {
+		_timeout_heap_remove(timeout);
+	}
+	timeout->delta_ticks_from_prev = _INACTIVE;
+
+	return 0;
+}
+#else
 /* returns _INACTIVE if the timer is not active */
 static inline int _abort_timeout(struct _timeout *timeout)
 {
@@ -135,6 +165,7 @@ static inline int _abort_timeout(struct _timeout *timeout)
 
 	return 0;
 }
+#endif
 
 /* returns _INACTIVE if the timer has already expired */
 static inline int _abort_thread_timeout(struct k_thread *thread)
@@ -158,6 +189,115 @@ static inline void _dump_timeout(struct _timeout *timeout, int extra_tab)
 #endif
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/*
+ * Delay the expiry of a timeout with slack to the next tick that is a
+ * multiple of the largest power of two not above its slack plus one. Such
+ * ticks are common to every timeout with a similar slack, so timeouts
+ * expiring within a few ticks of each other end up expiring together, and
+ * the system wakes up once for all of them.
+ *
+ * Takes the absolute expiry tick of the timeout, returns the number of
+ * ticks to delay it by, which is at most its slack.
+ *
+ * Must be called with interrupts locked.
+ */
+
+static inline s32_t _timeout_slack_delay(struct _timeout *timeout,
+					 u32_t expiry)
+{
+	u32_t grid;
+
+	if (timeout->slack <= 0) {
+		timeout->slack_delay = 0;
+		return 0;
+	}
+
+	grid = 1 << (find_msb_set(timeout->slack + 1) - 1);
+	timeout->slack_delay = -expiry & (grid - 1);
+
+	return timeout->slack_delay;
+}
+
+/* the slack is rounded down to whole ticks, so that it is never exceeded */
+
+static inline void _set_timeout_slack(struct _timeout *timeout, s32_t slack)
+{
+	timeout->slack = (s64_t)slack * sys_clock_ticks_per_sec / MSEC_PER_SEC;
+}
+#else
+#define _timeout_slack_delay(timeout, expiry) (0)
+#define _set_timeout_slack(timeout, slack) do { } while ((0))
+#endif
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+static inline void _dump_timeout_q(void)
+{
+#ifdef CONFIG_KERNEL_DEBUG
+	K_DEBUG("_timeout_q: %p, root: %p, now: %u\n",
+		&_timeout_q, _timeout_q.root, _timeout_q.now);
+#endif
+}
+
+/*
+ * Add timeout to timeout heap. Record waiting thread and wait queue if any.
+ *
+ * Cannot handle timeout == 0 and timeout == K_FOREVER.
+ *
+ * The timeout is keyed on its absolute expiry tick; timeouts expiring on the
+ * same tick are expired in the order they were added. Insertion is O(1),
+ * removal is O(log n) amortized.
+ *
+ * delta_ticks_from_prev only tracks the state of the timeout in this
+ * implementation: it holds the requested number of ticks while queued.
+ *
+ * Must be called with interrupts locked.
+ */
+
+static inline void _add_timeout(struct k_thread *thread,
+				struct _timeout *timeout,
+				_wait_q_t *wait_q,
+				s32_t timeout_in_ticks)
+{
+	__ASSERT(timeout_in_ticks > 0, "");
+
+	timeout->delta_ticks_from_prev = timeout_in_ticks;
+	timeout->thread = thread;
+	timeout->wait_q = (sys_dlist_t *)wait_q;
+
+	s32_t ticks = timeout_in_ticks;
+
+#ifdef CONFIG_TICKLESS_KERNEL
+	/* see the delta list implementation below */
+	u32_t adjusted_timeout;
+	u32_t program_time = _get_program_time();
+
+	if (program_time > 0) {
+		ticks += _get_elapsed_program_time();
+	}
+#endif
+
+	ticks += _timeout_slack_delay(timeout, _timeout_q.now + ticks);
+
+#ifdef CONFIG_TICKLESS_KERNEL
+	adjusted_timeout = ticks;
+#endif
+
+	timeout->expiry = _timeout_q.now + ticks;
+	timeout->seq = _timeout_q.seq++;
+	_timeout_heap_insert(timeout);
+
+	K_DEBUG("after adding timeout %p\n", timeout);
+	_dump_timeout(timeout, 0);
+	_dump_timeout_q();
+
+#ifdef CONFIG_TICKLESS_KERNEL
+	if (!program_time || (adjusted_timeout < program_time)) {
+		_set_time(adjusted_timeout);
+	}
+#endif
+}
+#else
 static inline void _dump_timeout_q(void)
 {
 #ifdef CONFIG_KERNEL_DEBUG
@@ -224,8 +364,15 @@ static inline void _add_timeout(struct k_thread *thread,
 	if (program_time > 0) {
 		*delta += _get_elapsed_program_time();
 	}
+#endif
+
+	*delta += _timeout_slack_delay(timeout,
+				       (u32_t)_sys_clock_tick_count + *delta);
+
+#ifdef CONFIG_TICKLESS_KERNEL
 	adjusted_timeout = *delta;
 #endif
+
 	SYS_DLIST_FOR_EACH_CONTAINER(&_timeout_q, in_q, node) {
 		if (*delta <= in_q->delta_ticks_from_prev) {
 			in_q->delta_ticks_from_prev -= *delta;
@@ -250,6 +397,7 @@ inserted:
 	}
 #endif
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP */
 
 /*
  * Put thread on timeout queue. Record wait queue if any.
@@ -266,6 +414,23 @@ static inline void _add_thread_timeout(struct k_thread *thread,
 	_add_timeout(thread, &thread->base.timeout, wait_q, timeout_in_ticks);
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+/* find the closest deadline in the timeout queue */
+
+static inline s32_t _get_next_timeout_expiry(void)
+{
+	struct _timeout *t = _timeout_q.root;
+
+	return t ? (s32_t)(t->expiry - _timeout_q.now) : K_FOREVER;
+}
+
+/* ticks until an active timeout expires; must be called with irqs locked */
+
+static inline s32_t _timeout_ticks_remaining(struct _timeout *timeout)
+{
+	return (s32_t)(timeout->expiry - _timeout_q.now);
+}
+#else
 /* find the closest deadline in the timeout queue */
 
 static inline s32_t _get_next_timeout_expiry(void)
@@ -276,6 +441,28 @@ static inline s32_t _get_next_timeout_expiry(void)
 	return t ? t->delta_ticks_from_prev : K_FOREVER;
 }
 
+/* ticks until an active timeout expires; must be called with irqs locked */
+
+static inline s32_t _timeout_ticks_remaining(struct _timeout *timeout)
+{
+	/*
+	 * compute remaining ticks by walking the timeout list
+	 * and summing up the various tick deltas involved
+	 */
+	struct _timeout *t =
+		(struct _timeout *)sys_dlist_peek_head(&_timeout_q);
+	s32_t remaining_ticks = t->delta_ticks_from_prev;
+
+	while (t != timeout) {
+		t = (struct _timeout *)sys_dlist_peek_next(&_timeout_q,
+							   &t->node);
+		remaining_ticks += t->delta_ticks_from_prev;
+	}
+
+	return remaining_ticks;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,7 +97,13 @@ k_tid_t const _idle_thread = (k_tid_t)_idle_stack;
 #endif
 char __noinit __stack _interrupt_stack[CONFIG_ISR_STACK_SIZE];
 
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP)
+	#define initialize_timeouts() do { \
+		_timeout_q.root = NULL; \
+		_timeout_q.now = 0; \
+		_timeout_q.seq = 0; \
+	} while ((0))
+#elif defined(CONFIG_SYS_CLOCK_EXISTS)
 	#include <misc/dlist.h>
 	#define initialize_timeouts() do { \
 		sys_dlist_init(&_timeout_q); \
@@ -111,7 +117,9 @@ extern void idle(void *unused1, void *unused2, void *unused3);
 void k_call_stacks_analyze(void)
 {
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_PRINTK)
-	extern char sys_work_q_stack[CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE];
+	extern char sys_work_q_stack[CONFIG_SYSTEM_WORKQUEUE_THREADS]
+		[ROUND_UP(CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE, STACK_ALIGN)];
+	int i;
 #if defined(CONFIG_ARC) && CONFIG_RGF_NUM_BANKS != 1
 	extern char _firq_stack[CONFIG_FIRQ_STACK_SIZE];
 #endif /* CONFIG_ARC */
@@ -124,8 +132,10 @@ void k_call_stacks_analyze(void)
 #endif /* CONFIG_ARC */
 	stack_analyze("interrupt", _interrupt_stack,
 		      sizeof(_interrupt_stack));
-	stack_analyze("workqueue", sys_work_q_stack,
-		      sizeof(sys_work_q_stack));
+	for (i = 0; i < CONFIG_SYSTEM_WORKQUEUE_THREADS; i++) {
+		stack_analyze("workqueue", sys_work_q_stack[i],
+			      sizeof(sys_work_q_stack[i]));
+	}
 
 #endif /* CONFIG_INIT_STACKS && CONFIG_PRINTK */
 }
@@ -163,6 +163,24 @@ void int_latency_init(void)
 	}
 }
 
+/**
+ *
+ * @brief Get the worst-case time spent with interrupts locked
+ *
+ * Unlike int_latency_show(), this does not print nor reset the metrics, so
+ * that code paths can be compared programmatically. The value does not
+ * include the overhead of the benchmark itself, nor the latency from the
+ * hardware interrupt up to the 'C' interrupt handler.
+ *
+ * @return maximum time interrupts were locked since int_latency_init() or
+ * int_latency_show() was last invoked, in timer clock cycles
+ *
+ */
+u32_t int_latency_max_get(void)
+{
+	return int_locked_latency_max;
+}
+
 /**
  *
  * @brief Dumps interrupt latency values
@@ -19,6 +19,112 @@ extern struct k_mem_slab _k_mem_slab_list_end[];
 
 struct k_mem_slab *_trace_list_k_mem_slab;
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+/*
+ * The free list head packs the index + 1 of the first free block, 0 meaning
+ * the list is empty, with a generation count bumped on each update, so that
+ * a compare-and-swap based on a stale head fails even if the same block made
+ * it back to the head in the meantime (ABA problem). Each free block stores
+ * the index + 1 of the next free block in its first word.
+ */
+#define FREE_LIST_INDEX_MASK 0x0000ffffU
+#define FREE_LIST_GEN_INC 0x00010000U
+
+static inline char *block_ptr(struct k_mem_slab *slab, u32_t index)
+{
+	return slab->buffer + (index - 1) * slab->block_size;
+}
+
+static inline u32_t block_index(struct k_mem_slab *slab, char *block)
+{
+	return (u32_t)(block - slab->buffer) / slab->block_size + 1;
+}
+
+/* next free list head for @a head, pointing to block @a index */
+static inline atomic_val_t free_list_next(atomic_val_t head, u32_t index)
+{
+	/* the generation count wraps around, so compute it unsigned */
+	return (atomic_val_t)((((u32_t)head & ~FREE_LIST_INDEX_MASK) +
+			       FREE_LIST_GEN_INC) | index);
+}
+
+static char *free_list_pop(struct k_mem_slab *slab)
+{
+	atomic_val_t head, next;
+	char *block;
+
+	do {
+		head = atomic_get(&slab->free_list);
+		if (!(head & FREE_LIST_INDEX_MASK)) {
+			return NULL;
+		}
+
+		/*
+		 * The block may be allocated and modified by a preempting
+		 * context before it is read: the generation then differs and
+		 * the compare-and-swap fails.
+		 */
+		block = block_ptr(slab, head & FREE_LIST_INDEX_MASK);
+		next = free_list_next(head, *(u32_t *)block);
+	} while (!atomic_cas(&slab->free_list, head, next));
+
+	atomic_inc(&slab->num_used);
+
+	return block;
+}
+
+static void free_list_push(struct k_mem_slab *slab, char *block)
+{
+	atomic_val_t head, next;
+	u32_t index = block_index(slab, block);
+
+	atomic_dec(&slab->num_used);
+
+	do {
+		head = atomic_get(&slab->free_list);
+		*(u32_t *)block = head & FREE_LIST_INDEX_MASK;
+		next = free_list_next(head, index);
+	} while (!atomic_cas(&slab->free_list, head, next));
+}
+
+/**
+ * @brief Initialize kernel memory slab subsystem.
+ *
+ * Perform any initialization of memory slabs that wasn't done at build time.
+ * Currently this just involves creating the list of free blocks for each slab.
+ *
+ * @return N/A
+ */
+static void create_free_list(struct k_mem_slab *slab)
+{
+	u32_t j;
+
+	for (j = 1; j <= slab->num_blocks; j++) {
+		*(u32_t *)block_ptr(slab, j) = j - 1;
+	}
+
+	atomic_set(&slab->free_list, slab->num_blocks);
+}
+#else
+static inline char *free_list_pop(struct k_mem_slab *slab)
+{
+	char *block = slab->free_list;
+
+	if (block != NULL) {
+		slab->free_list = *(char **)block;
+		slab->num_used++;
+	}
+
+	return block;
+}
+
+static inline void free_list_push(struct k_mem_slab *slab, char *block)
+{
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+	slab->num_used--;
+}
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -41,6 +147,7 @@ static void create_free_list(struct k_mem_slab *slab)
 		p += slab->block_size;
 	}
 }
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 
 /**
  * @brief Complete initialization of statically defined memory slabs.
@@ -67,9 +174,15 @@ static int init_mem_slab_module(struct device *dev)
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
-void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
+int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, u32_t num_blocks)
 {
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	if (num_blocks > _MEM_SLAB_MAX_BLOCKS) {
+		return -EINVAL;
+	}
+#endif
+
 	slab->num_blocks = num_blocks;
 	slab->block_size = block_size;
 	slab->buffer = buffer;
@@ -77,22 +190,37 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	create_free_list(slab);
 	sys_dlist_init(&slab->wait_q);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
+
+	return 0;
 }
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 {
-	unsigned int key = irq_lock();
+	unsigned int key;
 	int result;
 
-	if (slab->free_list != NULL) {
-		/* take a free block */
-		*mem = slab->free_list;
-		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	/* fast path: interrupts need not be locked when a block is free */
+	*mem = free_list_pop(slab);
+	if (*mem != NULL) {
+		return 0;
+	}
+#endif
+
+	key = irq_lock();
+
+	/*
+	 * In the lockless case, try again with interrupts locked so that a
+	 * block freed before we pend is not missed: freeing only hands blocks
+	 * directly to waiting threads once they are on the wait queue.
+	 */
+	*mem = free_list_pop(slab);
+
+	if (*mem != NULL) {
+		/* took a free block */
 		result = 0;
 	} else if (timeout == K_NO_WAIT) {
 		/* don't wait for a free block to become available */
-		*mem = NULL;
 		result = -ENOMEM;
 	} else {
 		/* wait for a free block or timeout */
@@ -109,6 +237,48 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 	return result;
 }
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	struct k_thread *pending_thread;
+	unsigned int key;
+	char *block;
+
+	free_list_push(slab, *mem);
+
+	/* fast path: interrupts need not be locked when nobody is waiting */
+	if (sys_dlist_is_empty(&slab->wait_q)) {
+		return;
+	}
+
+	key = irq_lock();
+
+	/*
+	 * The block may already have been taken by a preempting context, in
+	 * which case the waiting thread keeps waiting.
+	 */
+	block = free_list_pop(slab);
+	if (block == NULL) {
+		irq_unlock(key);
+		return;
+	}
+
+	pending_thread = _unpend_first_thread(&slab->wait_q);
+	if (pending_thread) {
+		_set_thread_return_value_with_data(pending_thread, 0, block);
+		_abort_thread_timeout(pending_thread);
+		_ready_thread(pending_thread);
+		if (_must_switch_threads()) {
+			_Swap(key);
+			return;
+		}
+	} else {
+		free_list_push(slab, block);
+	}
+
+	irq_unlock(key);
+}
+#else
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
 	int key = irq_lock();
@@ -123,10 +293,9 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 			return;
 		}
 	} else {
-		**(char ***)mem = slab->free_list;
-		slab->free_list = *(char **)mem;
-		slab->num_used--;
+		free_list_push(slab, *mem);
 	}
 
 	irq_unlock(key);
 }
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
@@ -41,6 +41,35 @@ static bool level_empty(struct k_mem_pool *p, int l)
 	return sys_dlist_is_empty(&p->levels[l].free_list);
 }
 
+/* Free list updates keep the bitmap of non-empty levels in sync, so that
+ * the allocator finds the best level to allocate from with a single find
+ * most significant bit operation.  Must be called with interrupts locked.
+ */
+static void free_list_add(struct k_mem_pool *p, int l, void *block)
+{
+	sys_dlist_append(&p->levels[l].free_list, block);
+	p->free_levels |= (1U << l);
+}
+
+static void free_list_remove(struct k_mem_pool *p, int l, void *block)
+{
+	sys_dlist_remove(block);
+	if (level_empty(p, l)) {
+		p->free_levels &= ~(1U << l);
+	}
+}
+
+static void *free_list_get(struct k_mem_pool *p, int l)
+{
+	sys_dnode_t *block = sys_dlist_get(&p->levels[l].free_list);
+
+	if (level_empty(p, l)) {
+		p->free_levels &= ~(1U << l);
+	}
+
+	return block;
+}
+
 /* Places a 32 bit output pointer in word, and an integer bit index
  * within that word as the return value
  */
@@ -97,7 +126,10 @@ static void init_mem_pool(struct k_mem_pool *p)
 	size_t buflen = p->n_max * p->max_sz, sz = p->max_sz;
 	u32_t *bits = p->buf + buflen;
 
+	__ASSERT(p->n_levels <= 32, "too many memory pool levels\n");
+
 	sys_dlist_init(&p->wait_q);
+	p->free_levels = 0;
 
 	for (i = 0; i < p->n_levels; i++) {
 		int nblocks = buflen / sz;
@@ -117,7 +149,7 @@ static void init_mem_pool(struct k_mem_pool *p)
 	for (i = 0; i < p->n_max; i++) {
 		void *block = block_ptr(p, p->max_sz, i);
 
-		sys_dlist_append(&p->levels[0].free_list, block);
+		free_list_add(p, 0, block);
 		set_free_bit(p, 0, i);
 	}
 }
@@ -154,7 +186,7 @@ static void *alloc_block(struct k_mem_pool *p, int l, size_t lsz)
 	sys_dnode_t *block;
 	int key = irq_lock();
 
-	block = sys_dlist_get(&p->levels[l].free_list);
+	block = free_list_get(p, l);
 	if (block) {
 		clear_free_bit(p, l, block_num(p, block, lsz));
 	}
@@ -179,7 +211,8 @@ static void free_block(struct k_mem_pool *p, int level, size_t *lsizes, int bn)
 			clear_free_bit(p, level, b);
 			if (b != bn &&
 			    block_fits(p, block_ptr(p, lsz, b), lsz)) {
-				sys_dlist_remove(block_ptr(p, lsz, b));
+				free_list_remove(p, level,
+						 block_ptr(p, lsz, b));
 			}
 		}
 
@@ -189,7 +222,7 @@ static void free_block(struct k_mem_pool *p, int level, size_t *lsizes, int bn)
 	}
 
 	if (block_fits(p, block, lsz)) {
-		sys_dlist_append(&p->levels[level].free_list, block);
+		free_list_add(p, level, block);
 	}
 
 	irq_unlock(key);
@@ -216,7 +249,7 @@ static void *break_block(struct k_mem_pool *p, void *block,
 
 		set_free_bit(p, l + 1, lbn);
 		if (block_fits(p, block2, lsz)) {
-			sys_dlist_append(&p->levels[l + 1].free_list, block2);
+			free_list_add(p, l + 1, block2);
 		}
 	}
 
@@ -229,14 +262,13 @@ static int pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 		      size_t size)
 {
 	size_t lsizes[p->n_levels];
-	int i, alloc_l = -1, free_l = -1, from_l;
+	int i, alloc_l = -1, free_l, from_l;
 	void *blk = NULL;
 
 	/* Walk down through levels, finding the one from which we
-	 * want to allocate and the smallest one with a free entry
-	 * from which we can split an allocation if needed.  Along the
-	 * way, we populate an array of sizes for each level so we
-	 * don't need to waste RAM storing it.
+	 * want to allocate.  Along the way, we populate an array of
+	 * sizes for each level so we don't need to waste RAM storing
+	 * it.
 	 */
 	lsizes[0] = _ALIGN4(p->max_sz);
 	for (i = 0; i < p->n_levels; i++) {
@@ -249,12 +281,20 @@ static int pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 		}
 
 		alloc_l = i;
-		if (!level_empty(p, i)) {
-			free_l = i;
-		}
 	}
 
-	if (alloc_l < 0 || free_l < 0) {
+	if (alloc_l < 0) {
+		block->data = NULL;
+		return -ENOMEM;
+	}
+
+	/* The smallest level with a free entry from which we can
+	 * split an allocation if needed is the most significant bit
+	 * set among the non-empty levels up to alloc_l.
+	 */
+	free_l = find_msb_set(p->free_levels & ((2U << alloc_l) - 1)) - 1;
+
+	if (free_l < 0) {
 		block->data = NULL;
 		return -ENOMEM;
 	}
@@ -364,7 +404,7 @@ void k_mem_pool_free(struct k_mem_block *block)
 	}
 }
 
-#if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+#if (CONFIG_HEAP_MEM_POOL_SIZE > 0) && !defined(CONFIG_HEAP_TLSF)
 
 /*
  * Heap is defined using HEAP_MEM_POOL_SIZE configuration option.
@@ -376,9 +416,24 @@ void k_mem_pool_free(struct k_mem_block *block)
 K_MEM_POOL_DEFINE(_heap_mem_pool, 64, CONFIG_HEAP_MEM_POOL_SIZE, 1, 4);
 #define _HEAP_MEM_POOL (&_heap_mem_pool)
 
+static size_t heap_used_bytes;
+static size_t heap_max_used_bytes;
+
+static size_t heap_level_size(int level)
+{
+	size_t sz = _ALIGN4(_HEAP_MEM_POOL->max_sz);
+
+	while (level--) {
+		sz = _ALIGN4(sz / 4);
+	}
+
+	return sz;
+}
+
 void *k_malloc(size_t size)
 {
 	struct k_mem_block block;
+	unsigned int key;
 
 	/*
 	 * get a block large enough to hold an initial (hidden) block
@@ -389,6 +444,13 @@ void *k_malloc(size_t size)
 		return NULL;
 	}
 
+	key = irq_lock();
+	heap_used_bytes += heap_level_size(block.id.level);
+	if (heap_used_bytes > heap_max_used_bytes) {
+		heap_max_used_bytes = heap_used_bytes;
+	}
+	irq_unlock(key);
+
 	/* save the block descriptor info at the start of the actual block */
 	memcpy(block.data, &block, sizeof(struct k_mem_block));
 
@@ -399,12 +461,35 @@ void *k_malloc(size_t size)
 
 void k_free(void *ptr)
 {
+	struct k_mem_block *block;
+	unsigned int key;
+
 	if (ptr != NULL) {
 		/* point to hidden block descriptor at start of block */
-		ptr = (char *)ptr - sizeof(struct k_mem_block);
+		block = (struct k_mem_block *)((char *)ptr -
+					       sizeof(struct k_mem_block));
+
+		key = irq_lock();
+		heap_used_bytes -= heap_level_size(block->id.level);
+		irq_unlock(key);
 
 		/* return block to the heap memory pool */
-		k_mem_pool_free(ptr);
+		k_mem_pool_free(block);
 	}
 }
+
+void k_malloc_stats_get(struct k_malloc_stats *stats)
+{
+	unsigned int key = irq_lock();
+	int level = find_lsb_set(_HEAP_MEM_POOL->free_levels) - 1;
+
+	stats->used_bytes = heap_used_bytes;
+	stats->max_used_bytes = heap_max_used_bytes;
+	stats->free_bytes = buf_size(_HEAP_MEM_POOL) - heap_used_bytes;
+
+	/* the largest free blocks are on the first non-empty level */
+	stats->largest_free_block = level < 0 ? 0 : heap_level_size(level);
+
+	irq_unlock(key);
+}
 #endif
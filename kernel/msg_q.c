@@ -56,13 +56,87 @@ void k_msgq_init(struct k_msgq *q, char *buffer,
 	q->read_ptr = buffer;
 	q->write_ptr = buffer;
 	q->used_msgs = 0;
+	q->reserved = 0;
+	q->borrowed = 0;
 	sys_dlist_init(&q->wait_q);
 	SYS_TRACING_OBJ_INIT(k_msgq, q);
 }
 
+/*
+ * Threads waiting to reserve or peek a message slot, instead of copying a
+ * message, pend with no data pointer and get the slot as their swap data.
+ */
+static inline int is_zero_copy(struct k_thread *thread)
+{
+	return !thread->base.swap_data;
+}
+
+static inline char *next_slot(struct k_msgq *q, char *slot)
+{
+	slot += q->msg_size;
+
+	return slot == q->buffer_end ? q->buffer_start : slot;
+}
+
+static void wake_thread(struct k_thread *thread, void *slot)
+{
+	_set_thread_return_value_with_data(thread, 0, slot);
+	_abort_thread_timeout(thread);
+	_ready_thread(thread);
+}
+
+/* returns 1 if a thread waiting to write was woken up, 0 otherwise */
+static int handle_pending_writer(struct k_msgq *q)
+{
+	struct k_thread *pending_thread = _unpend_first_thread(&q->wait_q);
+
+	if (!pending_thread) {
+		return 0;
+	}
+
+	if (is_zero_copy(pending_thread)) {
+		/* the thread fills the free slot in place */
+		q->reserved = 1;
+		wake_thread(pending_thread, q->write_ptr);
+	} else {
+		/* add thread's message to queue */
+		memcpy(q->write_ptr, pending_thread->base.swap_data,
+		       q->msg_size);
+		q->write_ptr = next_slot(q, q->write_ptr);
+		q->used_msgs++;
+		wake_thread(pending_thread, pending_thread->base.swap_data);
+	}
+
+	return 1;
+}
+
+/*
+ * Gives a message to a thread waiting to read; the message is in the slot
+ * at the write pointer when src is NULL.
+ */
+static void give_to_reader(struct k_msgq *q, struct k_thread *reader,
+			   void *src)
+{
+	if (is_zero_copy(reader)) {
+		/* the queue is empty, queue the message and lend it */
+		if (src) {
+			memcpy(q->write_ptr, src, q->msg_size);
+		}
+		q->write_ptr = next_slot(q, q->write_ptr);
+		q->used_msgs++;
+		q->borrowed = 1;
+		wake_thread(reader, q->read_ptr);
+	} else {
+		memcpy(reader->base.swap_data, src ? src : q->write_ptr,
+		       q->msg_size);
+		wake_thread(reader, reader->base.swap_data);
+	}
+}
+
 int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout)
 {
 	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(!q->reserved, "put while a message slot is reserved");
 
 	unsigned int key = irq_lock();
 	struct k_thread *pending_thread;
@@ -73,12 +147,7 @@ int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout)
 		pending_thread = _unpend_first_thread(&q->wait_q);
 		if (pending_thread) {
 			/* give message to waiting thread */
-			memcpy(pending_thread->base.swap_data, data,
-			       q->msg_size);
-			/* wake up waiting thread */
-			_set_thread_return_value(pending_thread, 0);
-			_abort_thread_timeout(pending_thread);
-			_ready_thread(pending_thread);
+			give_to_reader(q, pending_thread, data);
 			if (!_is_in_isr() && _must_switch_threads()) {
 				_Swap(key);
 				return 0;
@@ -86,10 +155,7 @@ int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout)
 		} else {
 			/* put message in queue */
 			memcpy(q->write_ptr, data, q->msg_size);
-			q->write_ptr += q->msg_size;
-			if (q->write_ptr == q->buffer_end) {
-				q->write_ptr = q->buffer_start;
-			}
+			q->write_ptr = next_slot(q, q->write_ptr);
 			q->used_msgs++;
 		}
 		result = 0;
@@ -108,39 +174,79 @@ int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout)
 	return result;
 }
 
-int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout)
+int k_msgq_reserve(struct k_msgq *q, void **slot, s32_t timeout)
 {
 	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(!q->reserved, "a message slot is already reserved");
+
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->used_msgs < q->max_msgs) {
+		/* the slot at the write pointer is free */
+		q->reserved = 1;
+		*slot = q->write_ptr;
+		result = 0;
+	} else if (timeout == K_NO_WAIT) {
+		result = -ENOMSG;
+	} else {
+		/* wait for a free slot, failure, or timeout */
+		_pend_current_thread(&q->wait_q, timeout);
+		_current->base.swap_data = NULL;
+		result = _Swap(key);
+		if (result == 0) {
+			*slot = _current->base.swap_data;
+		}
+		return result;
+	}
+
+	irq_unlock(key);
+
+	return result;
+}
+
+void k_msgq_commit(struct k_msgq *q)
+{
+	__ASSERT(q->reserved, "no message slot reserved");
 
 	unsigned int key = irq_lock();
 	struct k_thread *pending_thread;
+
+	q->reserved = 0;
+
+	pending_thread = _unpend_first_thread(&q->wait_q);
+	if (pending_thread) {
+		/* give message to waiting thread */
+		give_to_reader(q, pending_thread, NULL);
+		if (!_is_in_isr() && _must_switch_threads()) {
+			_Swap(key);
+			return;
+		}
+	} else {
+		/* the message is already in place */
+		q->write_ptr = next_slot(q, q->write_ptr);
+		q->used_msgs++;
+	}
+
+	irq_unlock(key);
+}
+
+int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(!q->borrowed, "get while a message is borrowed");
+
+	unsigned int key = irq_lock();
 	int result;
 
 	if (q->used_msgs > 0) {
 		/* take first available message from queue */
 		memcpy(data, q->read_ptr, q->msg_size);
-		q->read_ptr += q->msg_size;
-		if (q->read_ptr == q->buffer_end) {
-			q->read_ptr = q->buffer_start;
-		}
+		q->read_ptr = next_slot(q, q->read_ptr);
 		q->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = _unpend_first_thread(&q->wait_q);
-		if (pending_thread) {
-			/* add thread's message to queue */
-			memcpy(q->write_ptr, pending_thread->base.swap_data,
-			       q->msg_size);
-			q->write_ptr += q->msg_size;
-			if (q->write_ptr == q->buffer_end) {
-				q->write_ptr = q->buffer_start;
-			}
-			q->used_msgs++;
-
-			/* wake up waiting thread */
-			_set_thread_return_value(pending_thread, 0);
-			_abort_thread_timeout(pending_thread);
-			_ready_thread(pending_thread);
+		if (handle_pending_writer(q)) {
 			if (!_is_in_isr() && _must_switch_threads()) {
 				_Swap(key);
 				return 0;
@@ -162,8 +268,62 @@ int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout)
 	return result;
 }
 
+int k_msgq_peek(struct k_msgq *q, void **slot, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(!q->borrowed, "a message is already borrowed");
+
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->used_msgs > 0) {
+		/* lend first available message */
+		q->borrowed = 1;
+		*slot = q->read_ptr;
+		result = 0;
+	} else if (timeout == K_NO_WAIT) {
+		result = -ENOMSG;
+	} else {
+		/* wait for a message or timeout */
+		_pend_current_thread(&q->wait_q, timeout);
+		_current->base.swap_data = NULL;
+		result = _Swap(key);
+		if (result == 0) {
+			*slot = _current->base.swap_data;
+		}
+		return result;
+	}
+
+	irq_unlock(key);
+
+	return result;
+}
+
+void k_msgq_release(struct k_msgq *q)
+{
+	__ASSERT(q->borrowed, "no message borrowed");
+
+	unsigned int key = irq_lock();
+
+	q->borrowed = 0;
+	q->read_ptr = next_slot(q, q->read_ptr);
+	q->used_msgs--;
+
+	/* handle first thread waiting to write (if any) */
+	if (handle_pending_writer(q)) {
+		if (!_is_in_isr() && _must_switch_threads()) {
+			_Swap(key);
+			return;
+		}
+	}
+
+	irq_unlock(key);
+}
+
 void k_msgq_purge(struct k_msgq *q)
 {
+	__ASSERT(!q->borrowed, "purge while a message is borrowed");
+
 	unsigned int key = irq_lock();
 	struct k_thread *pending_thread;
 
@@ -13,17 +13,20 @@
  * level of the owning thread to match the priority level of the highest
  * priority thread waiting on the mutex.
  *
- * Each mutex that contributes to priority inheritance must be released in the
- * reverse order in which is was acquired.  Furthermore each subsequent mutex
- * that contributes to raising the owning thread's priority level must be
- * acquired at a point after the most recent "bumping" of the priority level.
+ * The inheritance is transitive: if the owning thread itself waits on a
+ * mutex, the owner of that mutex is boosted as well, and so on along the
+ * chain of owners, up to CONFIG_PRIORITY_INHERITANCE_DEPTH threads. Each
+ * thread keeps the list of the mutexes it owns that have waiters, so that
+ * when one of them is released, or one of their waiters times out, its
+ * priority level is recomputed from the remaining waiters, whatever the
+ * order in which the mutexes were acquired and released. The waiters of
+ * the reader-writer locks the thread holds to write count as well, with
+ * CONFIG_RWLOCK_PRIO_INHERIT.
  *
- * For example, if thread A has two mutexes contributing to the raising of its
- * priority level, the second mutex M2 must be acquired by thread A after
- * thread A's priority level was bumped due to owning the first mutex M1.
- * When releasing the mutex, thread A must release M2 before it releases M1.
- * Failure to follow this nested model may result in threads running at
- * unexpected priority levels (too high, or too low).
+ * A mutex that no thread waits on is locked and unlocked with a single
+ * compare-and-swap of its owner, without locking interrupts or the
+ * scheduler. The first thread that waits on it sets the MUTEX_CONTENDED bit
+ * of the owner, which sends the owner to the slow path on unlock.
  */
 
 #include <kernel.h>
@@ -66,14 +69,22 @@ SYS_INIT(init_mutex_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
 #endif /* CONFIG_OBJECT_TRACING */
 
+/* set in the owner word of a mutex while threads wait on it */
+#define MUTEX_CONTENDED 1
+
+BUILD_ASSERT(sizeof(struct k_thread *) == sizeof(atomic_t));
+
+static inline struct k_thread *mutex_owner(struct k_mutex *mutex)
+{
+	return (struct k_thread *)(atomic_get(&mutex->owner) &
+				   ~MUTEX_CONTENDED);
+}
+
 void k_mutex_init(struct k_mutex *mutex)
 {
-	mutex->owner = NULL;
+	atomic_set(&mutex->owner, 0);
 	mutex->lock_count = 0;
 
-	/* initialized upon first use */
-	/* mutex->owner_orig_prio = 0; */
-
 	sys_dlist_init(&mutex->wait_q);
 
 	SYS_TRACING_OBJ_INIT(k_mutex, mutex);
@@ -88,80 +99,168 @@ static int new_prio_for_inheritance(int target, int limit)
 	return new_prio;
 }
 
-static void adjust_owner_prio(struct k_mutex *mutex, int new_prio)
+/* must be called with interrupts locked */
+static void add_contended_mutex(struct k_thread *owner, struct k_mutex *mutex)
+{
+	sys_dlist_append(&owner->base.contended_mutexes, &mutex->owner_node);
+}
+
+/* must be called with interrupts locked */
+static int waiter_prio(_wait_q_t *wait_q, int prio)
+{
+	struct k_thread *waiter = _peek_first_pending_thread(wait_q);
+
+	if (waiter) {
+		prio = new_prio_for_inheritance(waiter->base.prio, prio);
+	}
+
+	return prio;
+}
+
+/* must be called with interrupts locked */
+static int inherited_prio(struct k_thread *thread)
 {
-	if (mutex->owner->base.prio != new_prio) {
+	struct k_mutex *mutex;
+	int new_prio = thread->base.orig_prio;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&thread->base.contended_mutexes, mutex,
+				     owner_node) {
+		new_prio = waiter_prio(&mutex->wait_q, new_prio);
+	}
+
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+	struct k_rwlock *rwlock;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&thread->base.write_rwlocks, rwlock,
+				     writer_node) {
+		new_prio = waiter_prio(&rwlock->wait_q.writers, new_prio);
+		new_prio = waiter_prio(&rwlock->wait_q.readers, new_prio);
+	}
+#endif
+
+	return new_prio;
+}
+
+/* keep a waiter whose priority changed sorted in the mutex wait queue */
+static void requeue_waiter(struct k_mutex *mutex, struct k_thread *thread)
+{
+	sys_dlist_t *wait_q = (sys_dlist_t *)&mutex->wait_q;
+	sys_dnode_t *node;
+
+	sys_dlist_remove(&thread->base.k_q_node);
+
+	SYS_DLIST_FOR_EACH_NODE(wait_q, node) {
+		if (_is_t1_higher_prio_than_t2(thread,
+					       (struct k_thread *)node)) {
+			sys_dlist_insert_before(wait_q, node,
+						&thread->base.k_q_node);
+			return;
+		}
+	}
+
+	sys_dlist_append(wait_q, &thread->base.k_q_node);
+}
+
+/*
+ * Recompute the priority of @a thread from its own priority and the waiters
+ * of the locks it holds, then the one of the owner of the mutex it waits
+ * on, and so on.
+ *
+ * Must be called with interrupts locked.
+ */
+void _adjust_owner_prio(struct k_thread *thread)
+{
+	struct k_mutex *mutex;
+	int depth, new_prio;
+
+	for (depth = 0; depth < CONFIG_PRIORITY_INHERITANCE_DEPTH; depth++) {
+		new_prio = inherited_prio(thread);
+
+		if (thread->base.prio == new_prio) {
+			return;
+		}
 
 		K_DEBUG("%p (ready (y/n): %c) prio changed to %d (was %d)\n",
-			mutex->owner, _is_thread_ready(mutex->owner) ?
-			'y' : 'n',
-			new_prio, mutex->owner->base.prio);
+			thread, _is_thread_ready(thread) ? 'y' : 'n',
+			new_prio, thread->base.prio);
 
-		_thread_priority_set(mutex->owner, new_prio);
+		_thread_priority_set(thread, new_prio);
+
+		mutex = thread->base.pended_mutex;
+		if (!mutex || !_is_thread_pending(thread)) {
+			return;
+		}
+
+		requeue_waiter(mutex, thread);
+		thread = mutex_owner(mutex);
 	}
 }
 
 int k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 {
-	int new_prio, key;
+	struct k_thread *owner;
+	atomic_val_t owner_val;
+	int key;
 
-	_sched_lock();
+	if (likely(atomic_cas(&mutex->owner, 0, (atomic_val_t)_current))) {
+		RECORD_STATE_CHANGE();
 
-	if (likely(mutex->lock_count == 0 || mutex->owner == _current)) {
+		mutex->lock_count = 1;
 
-		RECORD_STATE_CHANGE();
+		K_DEBUG("%p took mutex %p\n", _current, mutex);
 
-		mutex->owner_orig_prio = mutex->lock_count == 0 ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
+		return 0;
+	}
 
+	/* only the owner can change the owner from itself */
+	if (mutex_owner(mutex) == _current) {
 		mutex->lock_count++;
-		mutex->owner = _current;
 
-		K_DEBUG("%p took mutex %p, count: %d, orig prio: %d\n",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+		K_DEBUG("%p took mutex %p, count: %d\n",
+			_current, mutex, mutex->lock_count);
+
+		return 0;
+	}
 
-		k_sched_unlock();
+	key = irq_lock();
 
+	owner_val = atomic_get(&mutex->owner);
+
+	if (unlikely(owner_val == 0)) {
+		/* released since the compare-and-swap */
+		atomic_set(&mutex->owner, (atomic_val_t)_current);
+		mutex->lock_count = 1;
+		irq_unlock(key);
 		return 0;
 	}
 
 	RECORD_CONFLICT();
 
 	if (unlikely(timeout == K_NO_WAIT)) {
-		k_sched_unlock();
+		irq_unlock(key);
 		return -EBUSY;
 	}
 
-#if 0
-	if (_is_prio_higher(_current->prio, mutex->owner->prio)) {
-		new_prio = _current->prio;
+	owner = (struct k_thread *)(owner_val & ~MUTEX_CONTENDED);
+
+	if (!(owner_val & MUTEX_CONTENDED)) {
+		atomic_or(&mutex->owner, MUTEX_CONTENDED);
+		add_contended_mutex(owner, mutex);
 	}
-	new_prio = _get_new_prio_with_ceiling(new_prio);
-#endif
-	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
 
-	key = irq_lock();
+	_current->base.pended_mutex = mutex;
+	_pend_current_thread(&mutex->wait_q, timeout);
 
 	K_DEBUG("adjusting prio up on mutex %p\n", mutex);
 
-	if (_is_prio_higher(new_prio, mutex->owner->base.prio)) {
-		adjust_owner_prio(mutex, new_prio);
-	}
-
-	_pend_current_thread(&mutex->wait_q, timeout);
+	_adjust_owner_prio(owner);
 
 	int got_mutex = _Swap(key);
 
-	K_DEBUG("on mutex %p got_mutex value: %d\n", mutex, got_mutex);
-
 	K_DEBUG("%p got mutex %p (y/n): %c\n", _current, mutex,
-		got_mutex ? 'y' : 'n');
+		got_mutex ? 'n' : 'y');
 
 	if (got_mutex == 0) {
-		k_sched_unlock();
 		return 0;
 	}
 
@@ -169,73 +268,97 @@ int k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 
 	K_DEBUG("%p timeout on mutex %p\n", _current, mutex);
 
-	struct k_thread *waiter =
-		(struct k_thread *)sys_dlist_peek_head(&mutex->wait_q);
+	key = irq_lock();
 
-	new_prio = mutex->owner_orig_prio;
-	new_prio = waiter ? new_prio_for_inheritance(waiter->base.prio,
-						     new_prio) : new_prio;
+	_current->base.pended_mutex = NULL;
 
-	K_DEBUG("adjusting prio down on mutex %p\n", mutex);
+	/*
+	 * The mutex may have been released, or handed over, since the timeout:
+	 * adjust whoever owns it now, if threads still had to wait on it.
+	 */
+	owner_val = atomic_get(&mutex->owner);
 
-	key = irq_lock();
-	adjust_owner_prio(mutex, new_prio);
-	irq_unlock(key);
+	if (owner_val & MUTEX_CONTENDED) {
+		owner = (struct k_thread *)(owner_val & ~MUTEX_CONTENDED);
 
-	k_sched_unlock();
+		if (sys_dlist_is_empty(&mutex->wait_q)) {
+			atomic_set(&mutex->owner, (atomic_val_t)owner);
+			sys_dlist_remove(&mutex->owner_node);
+		}
+
+		K_DEBUG("adjusting prio down on mutex %p\n", mutex);
+
+		_adjust_owner_prio(owner);
+	}
+
+	irq_unlock(key);
 
 	return -EAGAIN;
 }
 
 void k_mutex_unlock(struct k_mutex *mutex)
 {
+	struct k_thread *new_owner;
 	int key;
 
 	__ASSERT(mutex->lock_count > 0, "");
-	__ASSERT(mutex->owner == _current, "");
-
-	_sched_lock();
+	__ASSERT(mutex_owner(mutex) == _current, "");
 
 	RECORD_STATE_CHANGE();
 
-	mutex->lock_count--;
+	if (mutex->lock_count > 1) {
+		mutex->lock_count--;
 
-	K_DEBUG("mutex %p lock_count: %d\n", mutex, mutex->lock_count);
+		K_DEBUG("mutex %p lock_count: %d\n", mutex, mutex->lock_count);
+
+		return;
+	}
+
+	mutex->lock_count = 0;
 
-	if (mutex->lock_count != 0) {
-		k_sched_unlock();
+	if (likely(atomic_cas(&mutex->owner, (atomic_val_t)_current, 0))) {
 		return;
 	}
 
+	/* threads may wait on the mutex */
+
 	key = irq_lock();
 
-	adjust_owner_prio(mutex, mutex->owner_orig_prio);
+	sys_dlist_remove(&mutex->owner_node);
 
-	struct k_thread *new_owner = _unpend_first_thread(&mutex->wait_q);
+	new_owner = _unpend_first_thread(&mutex->wait_q);
 
 	K_DEBUG("new owner of mutex %p: %p (prio: %d)\n",
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
 
 	if (new_owner) {
 		_abort_thread_timeout(new_owner);
-		_ready_thread(new_owner);
+		new_owner->base.pended_mutex = NULL;
 
-		irq_unlock(key);
+		mutex->lock_count = 1;
 
-		_set_thread_return_value(new_owner, 0);
+		if (sys_dlist_is_empty(&mutex->wait_q)) {
+			atomic_set(&mutex->owner, (atomic_val_t)new_owner);
+		} else {
+			atomic_set(&mutex->owner,
+				   (atomic_val_t)new_owner | MUTEX_CONTENDED);
+			add_contended_mutex(new_owner, mutex);
+		}
 
 		/*
-		 * new owner is already of higher or equal prio than first
-		 * waiter since the wait queue is priority-based: no need to
-		 * ajust its priority
+		 * new owner is already of higher or equal prio than the
+		 * remaining waiters since the wait queue is priority-based:
+		 * no need to adjust its priority
 		 */
-		mutex->owner = new_owner;
-		mutex->lock_count++;
-		mutex->owner_orig_prio = new_owner->base.prio;
+
+		_ready_thread(new_owner);
+		_set_thread_return_value(new_owner, 0);
 	} else {
-		irq_unlock(key);
-		mutex->owner = NULL;
+		/* the waiters timed out */
+		atomic_set(&mutex->owner, 0);
 	}
 
-	k_sched_unlock();
+	_adjust_owner_prio(_current);
+
+	_reschedule_threads(key);
 }
@@ -18,9 +18,13 @@
 #include <wait_q.h>
 #include <misc/dlist.h>
 #include <init.h>
+#include <string.h>
 
 struct k_pipe_desc {
-	unsigned char *buffer;           /* Position in src/dest buffer */
+	unsigned char *buffer;           /* Position in src/dest segment */
+	size_t seg_bytes;                /* # bytes left in segment */
+	const struct k_pipe_iovec *iov;  /* Next src/dest segments */
+	int iovcnt;                      /* # next src/dest segments */
 	size_t bytes_to_xfer;            /* # bytes left to transfer */
 #if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
 	struct k_mem_block *block;       /* Pointer to memory block */
@@ -136,6 +140,69 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	SYS_TRACING_OBJ_INIT(k_pipe, pipe);
 }
 
+/**
+ * @brief Describe a flat src/dest buffer
+ *
+ * @return N/A
+ */
+static void _pipe_desc_init(struct k_pipe_desc *desc, void *data,
+			    size_t size)
+{
+	desc->buffer = data;
+	desc->seg_bytes = size;
+	desc->iov = NULL;
+	desc->iovcnt = 0;
+	desc->bytes_to_xfer = size;
+}
+
+/**
+ * @brief Describe a scattered src/dest buffer
+ *
+ * @return N/A
+ */
+static void _pipe_desc_init_iov(struct k_pipe_desc *desc,
+				const struct k_pipe_iovec *iov, int iovcnt)
+{
+	int i;
+
+	_pipe_desc_init(desc, NULL, 0);
+	desc->iov = iov;
+	desc->iovcnt = iovcnt;
+
+	for (i = 0; i < iovcnt; i++) {
+		desc->bytes_to_xfer += iov[i].len;
+	}
+}
+
+/**
+ * @brief Move to the next non-empty segment of @a desc if needed
+ *
+ * @return Number of bytes left in the current segment
+ */
+static size_t _pipe_desc_seg(struct k_pipe_desc *desc)
+{
+	while (desc->seg_bytes == 0 && desc->iovcnt > 0) {
+		desc->buffer = desc->iov->base;
+		desc->seg_bytes = desc->iov->len;
+		desc->iov++;
+		desc->iovcnt--;
+	}
+
+	return desc->seg_bytes;
+}
+
+/**
+ * @brief Account for @a num_bytes transferred in the current segment
+ *
+ * @return N/A
+ */
+static void _pipe_desc_advance(struct k_pipe_desc *desc, size_t num_bytes)
+{
+	desc->buffer        += num_bytes;
+	desc->seg_bytes     -= num_bytes;
+	desc->bytes_to_xfer -= num_bytes;
+}
+
 /**
  * @brief Copy bytes from @a src to @a dest
  *
@@ -145,12 +212,30 @@ static size_t _pipe_xfer(unsigned char *dest, size_t dest_size,
 			 const unsigned char *src, size_t src_size)
 {
 	size_t num_bytes = min(dest_size, src_size);
-	const unsigned char *end = src + num_bytes;
 
-	while (src != end) {
-		*dest = *src;
-		dest++;
-		src++;
+	memcpy(dest, src, num_bytes);
+
+	return num_bytes;
+}
+
+/**
+ * @brief Copy bytes from the segments of @a src to the segments of @a dest
+ *
+ * @return Number of bytes copied
+ */
+static size_t _pipe_desc_xfer(struct k_pipe_desc *dest,
+			      struct k_pipe_desc *src)
+{
+	size_t  bytes_copied;
+	size_t  num_bytes = 0;
+
+	while (_pipe_desc_seg(dest) && _pipe_desc_seg(src)) {
+		bytes_copied = _pipe_xfer(dest->buffer, dest->seg_bytes,
+					  src->buffer, src->seg_bytes);
+
+		_pipe_desc_advance(dest, bytes_copied);
+		_pipe_desc_advance(src, bytes_copied);
+		num_bytes += bytes_copied;
 	}
 
 	return num_bytes;
@@ -164,24 +249,21 @@ static size_t _pipe_xfer(unsigned char *dest, size_t dest_size,
  *
  * @return Number of bytes written to the pipe's circular buffer
  */
-static size_t _pipe_buffer_put(struct k_pipe *pipe,
-			       const unsigned char *src, size_t src_size)
+static size_t _pipe_buffer_put(struct k_pipe *pipe, struct k_pipe_desc *src)
 {
 	size_t  bytes_copied;
 	size_t  run_length;
 	size_t  num_bytes_written = 0;
-	int     i;
-
 
-	for (i = 0; i < 2; i++) {
+	while (pipe->bytes_used < pipe->size && _pipe_desc_seg(src)) {
 		run_length = min(pipe->size - pipe->bytes_used,
 				 pipe->size - pipe->write_index);
 
 		bytes_copied = _pipe_xfer(pipe->buffer + pipe->write_index,
 					  run_length,
-					  src + num_bytes_written,
-					  src_size - num_bytes_written);
+					  src->buffer, src->seg_bytes);
 
+		_pipe_desc_advance(src, bytes_copied);
 		num_bytes_written += bytes_copied;
 		pipe->bytes_used += bytes_copied;
 		pipe->write_index += bytes_copied;
@@ -201,23 +283,21 @@ static size_t _pipe_buffer_put(struct k_pipe *pipe,
  *
  * @return Number of bytes read from the pipe's circular buffer
  */
-static size_t _pipe_buffer_get(struct k_pipe *pipe,
-			       unsigned char *dest, size_t dest_size)
+static size_t _pipe_buffer_get(struct k_pipe *pipe, struct k_pipe_desc *dest)
 {
 	size_t  bytes_copied;
 	size_t  run_length;
 	size_t  num_bytes_read = 0;
-	int     i;
 
-	for (i = 0; i < 2; i++) {
+	while (pipe->bytes_used > 0 && _pipe_desc_seg(dest)) {
 		run_length = min(pipe->bytes_used,
 				 pipe->size - pipe->read_index);
 
-		bytes_copied = _pipe_xfer(dest + num_bytes_read,
-					  dest_size - num_bytes_read,
+		bytes_copied = _pipe_xfer(dest->buffer, dest->seg_bytes,
 					  pipe->buffer + pipe->read_index,
 					  run_length);
 
+		_pipe_desc_advance(dest, bytes_copied);
 		num_bytes_read += bytes_copied;
 		pipe->bytes_used -= bytes_copied;
 		pipe->read_index += bytes_copied;
@@ -382,16 +462,14 @@ static void _pipe_thread_ready(struct k_thread *thread)
  * @brief Internal API used to send data to a pipe
  */
 int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
-			 unsigned char *data, size_t bytes_to_write,
-			 size_t *bytes_written, size_t min_xfer,
-			 s32_t timeout)
+			 struct k_pipe_desc *src, size_t *bytes_written,
+			 size_t min_xfer, s32_t timeout)
 {
 	struct k_thread    *reader;
 	struct k_pipe_desc *desc;
 	sys_dlist_t    xfer_list;
 	unsigned int   key;
-	size_t         num_bytes_written = 0;
-	size_t         bytes_copied;
+	size_t         bytes_to_write = src->bytes_to_xfer;
 
 #if (CONFIG_NUM_PIPE_ASYNC_MSGS == 0)
 	ARG_UNUSED(async_desc);
@@ -431,13 +509,7 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 				  sys_dlist_get(&xfer_list);
 	while (thread) {
 		desc = (struct k_pipe_desc *)thread->base.swap_data;
-		bytes_copied = _pipe_xfer(desc->buffer, desc->bytes_to_xfer,
-					  data + num_bytes_written,
-					  bytes_to_write - num_bytes_written);
-
-		num_bytes_written   += bytes_copied;
-		desc->buffer        += bytes_copied;
-		desc->bytes_to_xfer -= bytes_copied;
+		_pipe_desc_xfer(desc, src);
 
 		/* The thread's read request has been satisfied. Ready it. */
 		key = irq_lock();
@@ -453,13 +525,7 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 	 */
 	if (reader) {
 		desc = (struct k_pipe_desc *)reader->base.swap_data;
-		bytes_copied = _pipe_xfer(desc->buffer, desc->bytes_to_xfer,
-					  data + num_bytes_written,
-					  bytes_to_write - num_bytes_written);
-
-		num_bytes_written   += bytes_copied;
-		desc->buffer        += bytes_copied;
-		desc->bytes_to_xfer -= bytes_copied;
+		_pipe_desc_xfer(desc, src);
 	}
 
 	/*
@@ -467,12 +533,10 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 	 * readers. Add as much as possible to the pipe's circular buffer.
 	 */
 
-	num_bytes_written +=
-		_pipe_buffer_put(pipe, data + num_bytes_written,
-				 bytes_to_write - num_bytes_written);
+	_pipe_buffer_put(pipe, src);
 
-	if (num_bytes_written == bytes_to_write) {
-		*bytes_written = num_bytes_written;
+	if (src->bytes_to_xfer == 0) {
+		*bytes_written = bytes_to_write;
 #if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
 		if (async_desc != NULL) {
 			_pipe_async_finish(async_desc);
@@ -499,13 +563,8 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 	}
 #endif
 
-	struct k_pipe_desc  pipe_desc;
-
-	pipe_desc.buffer         = data + num_bytes_written;
-	pipe_desc.bytes_to_xfer  = bytes_to_write - num_bytes_written;
-
 	if (timeout != K_NO_WAIT) {
-		_current->base.swap_data = &pipe_desc;
+		_current->base.swap_data = src;
 		/*
 		 * Lock interrupts and unlock the scheduler before
 		 * manipulating the writers wait_q.
@@ -518,24 +577,24 @@ int _k_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 		k_sched_unlock();
 	}
 
-	*bytes_written = bytes_to_write - pipe_desc.bytes_to_xfer;
+	*bytes_written = bytes_to_write - src->bytes_to_xfer;
 
-	return _pipe_return_code(min_xfer, pipe_desc.bytes_to_xfer,
+	return _pipe_return_code(min_xfer, src->bytes_to_xfer,
 				 bytes_to_write);
 }
 
-int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
-	       size_t *bytes_read, size_t min_xfer, s32_t timeout)
+/**
+ * @brief Internal API used to receive data from a pipe
+ */
+static int _k_pipe_get_internal(struct k_pipe *pipe, struct k_pipe_desc *dest,
+				size_t *bytes_read, size_t min_xfer,
+				s32_t timeout)
 {
 	struct k_thread    *writer;
 	struct k_pipe_desc *desc;
 	sys_dlist_t    xfer_list;
 	unsigned int   key;
-	size_t         num_bytes_read = 0;
-	size_t         bytes_copied;
-
-	__ASSERT(min_xfer <= bytes_to_read, "");
-	__ASSERT(bytes_read != NULL, "");
+	size_t         bytes_to_read = dest->bytes_to_xfer;
 
 	key = irq_lock();
 
@@ -555,7 +614,7 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 	_sched_lock();
 	irq_unlock(key);
 
-	num_bytes_read = _pipe_buffer_get(pipe, data, bytes_to_read);
+	_pipe_buffer_get(pipe, dest);
 
 	/*
 	 * 1. 'xfer_list' currently contains a list of writer threads that can
@@ -573,15 +632,9 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	struct k_thread *thread = (struct k_thread *)
 				  sys_dlist_get(&xfer_list);
-	while (thread && (num_bytes_read < bytes_to_read)) {
+	while (thread && (dest->bytes_to_xfer > 0)) {
 		desc = (struct k_pipe_desc *)thread->base.swap_data;
-		bytes_copied = _pipe_xfer(data + num_bytes_read,
-					  bytes_to_read - num_bytes_read,
-					  desc->buffer, desc->bytes_to_xfer);
-
-		num_bytes_read       += bytes_copied;
-		desc->buffer         += bytes_copied;
-		desc->bytes_to_xfer  -= bytes_copied;
+		_pipe_desc_xfer(dest, desc);
 
 		/*
 		 * It is expected that the write request will be satisfied.
@@ -589,7 +642,7 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 		 * write request was satisfied, then the write request must
 		 * finish later when writing to the pipe's circular buffer.
 		 */
-		if (num_bytes_read == bytes_to_read) {
+		if (dest->bytes_to_xfer == 0) {
 			break;
 		}
 		_pipe_thread_ready(thread);
@@ -597,15 +650,9 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
 	}
 
-	if (writer && (num_bytes_read < bytes_to_read)) {
+	if (writer && (dest->bytes_to_xfer > 0)) {
 		desc = (struct k_pipe_desc *)writer->base.swap_data;
-		bytes_copied = _pipe_xfer(data + num_bytes_read,
-					  bytes_to_read - num_bytes_read,
-					  desc->buffer, desc->bytes_to_xfer);
-
-		num_bytes_read       += bytes_copied;
-		desc->buffer         += bytes_copied;
-		desc->bytes_to_xfer  -= bytes_copied;
+		_pipe_desc_xfer(dest, desc);
 	}
 
 	/*
@@ -615,11 +662,7 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	while (thread) {
 		desc = (struct k_pipe_desc *)thread->base.swap_data;
-		bytes_copied = _pipe_buffer_put(pipe, desc->buffer,
-						desc->bytes_to_xfer);
-
-		desc->buffer         += bytes_copied;
-		desc->bytes_to_xfer  -= bytes_copied;
+		_pipe_buffer_put(pipe, desc);
 
 		/* Write request has been satsified */
 		_pipe_thread_ready(thread);
@@ -629,30 +672,21 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	if (writer) {
 		desc = (struct k_pipe_desc *)writer->base.swap_data;
-		bytes_copied = _pipe_buffer_put(pipe, desc->buffer,
-						desc->bytes_to_xfer);
-
-		desc->buffer         += bytes_copied;
-		desc->bytes_to_xfer  -= bytes_copied;
+		_pipe_buffer_put(pipe, desc);
 	}
 
-	if (num_bytes_read == bytes_to_read) {
+	if (dest->bytes_to_xfer == 0) {
 		k_sched_unlock();
 
-		*bytes_read = num_bytes_read;
+		*bytes_read = bytes_to_read;
 
 		return 0;
 	}
 
 	/* Not all data was read. */
 
-	struct k_pipe_desc  pipe_desc;
-
-	pipe_desc.buffer        = data + num_bytes_read;
-	pipe_desc.bytes_to_xfer = bytes_to_read - num_bytes_read;
-
 	if (timeout != K_NO_WAIT) {
-		_current->base.swap_data = &pipe_desc;
+		_current->base.swap_data = dest;
 		key = irq_lock();
 		_sched_unlock_no_reschedule();
 		_pend_current_thread(&pipe->wait_q.readers, timeout);
@@ -661,20 +695,69 @@ int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 		k_sched_unlock();
 	}
 
-	*bytes_read = bytes_to_read - pipe_desc.bytes_to_xfer;
+	*bytes_read = bytes_to_read - dest->bytes_to_xfer;
 
-	return _pipe_return_code(min_xfer, pipe_desc.bytes_to_xfer,
+	return _pipe_return_code(min_xfer, dest->bytes_to_xfer,
 				 bytes_to_read);
 }
 
+int k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
+	       size_t *bytes_read, size_t min_xfer, s32_t timeout)
+{
+	struct k_pipe_desc  pipe_desc;
+
+	__ASSERT(min_xfer <= bytes_to_read, "");
+	__ASSERT(bytes_read != NULL, "");
+
+	_pipe_desc_init(&pipe_desc, data, bytes_to_read);
+
+	return _k_pipe_get_internal(pipe, &pipe_desc, bytes_read, min_xfer,
+				    timeout);
+}
+
+int k_pipe_getv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		int iovcnt, size_t *bytes_read, size_t min_xfer,
+		s32_t timeout)
+{
+	struct k_pipe_desc  pipe_desc;
+
+	__ASSERT(bytes_read != NULL, "");
+
+	_pipe_desc_init_iov(&pipe_desc, iov, iovcnt);
+
+	__ASSERT(min_xfer <= pipe_desc.bytes_to_xfer, "");
+
+	return _k_pipe_get_internal(pipe, &pipe_desc, bytes_read, min_xfer,
+				    timeout);
+}
+
 int k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	       size_t *bytes_written, size_t min_xfer, s32_t timeout)
 {
+	struct k_pipe_desc  pipe_desc;
+
 	__ASSERT(min_xfer <= bytes_to_write, "");
 	__ASSERT(bytes_written != NULL, "");
 
-	return _k_pipe_put_internal(pipe, NULL, data,
-				    bytes_to_write, bytes_written,
+	_pipe_desc_init(&pipe_desc, data, bytes_to_write);
+
+	return _k_pipe_put_internal(pipe, NULL, &pipe_desc, bytes_written,
+				    min_xfer, timeout);
+}
+
+int k_pipe_putv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		int iovcnt, size_t *bytes_written, size_t min_xfer,
+		s32_t timeout)
+{
+	struct k_pipe_desc  pipe_desc;
+
+	__ASSERT(bytes_written != NULL, "");
+
+	_pipe_desc_init_iov(&pipe_desc, iov, iovcnt);
+
+	__ASSERT(min_xfer <= pipe_desc.bytes_to_xfer, "");
+
+	return _k_pipe_put_internal(pipe, NULL, &pipe_desc, bytes_written,
 				    min_xfer, timeout);
 }
 
@@ -688,13 +771,14 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 	/* For simplicity, always allocate an asynchronous descriptor */
 	_pipe_async_alloc(&async_desc);
 
+	_pipe_desc_init(&async_desc->desc, block->data, bytes_to_write);
 	async_desc->desc.block = &async_desc->desc.copy_block;
 	async_desc->desc.copy_block = *block;
 	async_desc->desc.sem = sem;
 	async_desc->thread.prio = k_thread_priority_get(_current);
 
-	(void) _k_pipe_put_internal(pipe, async_desc, block->data,
-				    bytes_to_write, &dummy_bytes_written,
-				    bytes_to_write, K_FOREVER);
+	(void) _k_pipe_put_internal(pipe, async_desc, &async_desc->desc,
+				    &dummy_bytes_written, bytes_to_write,
+				    K_FOREVER);
 }
 #endif
@@ -79,6 +79,19 @@ static inline int is_condition_met(struct k_poll_event *event, u32_t *state)
 			return 1;
 		}
 		break;
+	case K_POLL_TYPE_RWLOCK_WRITABLE:
+		if (!event->rwlock->writer && event->rwlock->readers == 0) {
+			*state = K_POLL_STATE_RWLOCK_WRITABLE;
+			return 1;
+		}
+		break;
+	case K_POLL_TYPE_RWLOCK_READABLE:
+		if (!event->rwlock->writer &&
+		    sys_dlist_is_empty(&event->rwlock->wait_q.writers)) {
+			*state = K_POLL_STATE_RWLOCK_READABLE;
+			return 1;
+		}
+		break;
 	case K_POLL_TYPE_IGNORE:
 		return 0;
 	default:
@@ -89,30 +102,60 @@ static inline int is_condition_met(struct k_poll_event *event, u32_t *state)
 	return 0;
 }
 
+/*
+ * Add an event to the list of events polled for on an object, behind the
+ * events of pollers with a higher or equal priority.
+ */
+static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
+			     struct _poller *poller)
+{
+	struct k_poll_event *pending;
+
+	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
+	if (!pending || !_is_t1_higher_prio_than_t2(poller->thread,
+						    pending->poller->thread)) {
+		sys_dlist_append(events, &event->_node);
+		return;
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
+		if (_is_t1_higher_prio_than_t2(poller->thread,
+					       pending->poller->thread)) {
+			sys_dlist_insert_before(events, &pending->_node,
+						&event->_node);
+			return;
+		}
+	}
+
+	sys_dlist_append(events, &event->_node);
+}
+
 /* must be called with interrupts locked */
-static inline int register_event(struct k_poll_event *event)
+static inline void register_event(struct k_poll_event *event,
+				  struct _poller *poller)
 {
+	event->poller = poller;
+
 	switch (event->type) {
 	case K_POLL_TYPE_SEM_AVAILABLE:
 		__ASSERT(event->sem, "invalid semaphore\n");
-		if (event->sem->poll_event) {
-			return -EADDRINUSE;
-		}
-		event->sem->poll_event = event;
+		add_event(&event->sem->poll_events, event, poller);
 		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue, "invalid queue\n");
-		if (event->queue->poll_event) {
-			return -EADDRINUSE;
-		}
-		event->queue->poll_event = event;
+		add_event(&event->queue->poll_events, event, poller);
 		break;
 	case K_POLL_TYPE_SIGNAL:
-		__ASSERT(event->queue, "invalid poll signal\n");
-		if (event->signal->poll_event) {
-			return -EADDRINUSE;
-		}
-		event->signal->poll_event = event;
+		__ASSERT(event->signal, "invalid poll signal\n");
+		add_event(&event->signal->poll_events, event, poller);
+		break;
+	case K_POLL_TYPE_RWLOCK_WRITABLE:
+		__ASSERT(event->rwlock, "invalid reader-writer lock\n");
+		add_event(&event->rwlock->poll_events, event, poller);
+		break;
+	case K_POLL_TYPE_RWLOCK_READABLE:
+		__ASSERT(event->rwlock, "invalid reader-writer lock\n");
+		add_event(&event->rwlock->read_poll_events, event, poller);
 		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -121,27 +164,25 @@ static inline int register_event(struct k_poll_event *event)
 		__ASSERT(0, "invalid event type\n");
 		break;
 	}
-
-	return 0;
 }
 
 /* must be called with interrupts locked */
 static inline void clear_event_registration(struct k_poll_event *event)
 {
+	/* an event that has been signaled is not on its object's list anymore */
+	if (!event->poller) {
+		return;
+	}
+
 	event->poller = NULL;
 
 	switch (event->type) {
 	case K_POLL_TYPE_SEM_AVAILABLE:
-		__ASSERT(event->sem, "invalid semaphore\n");
-		event->sem->poll_event = NULL;
-		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
-		__ASSERT(event->queue, "invalid queue\n");
-		event->queue->poll_event = NULL;
-		break;
 	case K_POLL_TYPE_SIGNAL:
-		__ASSERT(event->signal, "invalid poll signal\n");
-		event->signal->poll_event = NULL;
+	case K_POLL_TYPE_RWLOCK_WRITABLE:
+	case K_POLL_TYPE_RWLOCK_READABLE:
+		sys_dlist_remove(&event->_node);
 		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -176,7 +217,7 @@ int k_poll(struct k_poll_event *events, int num_events, s32_t timeout)
 	__ASSERT(events, "NULL events\n");
 	__ASSERT(num_events > 0, "zero events\n");
 
-	int last_registered = -1, in_use = 0, rc;
+	int last_registered = -1;
 	unsigned int key;
 
 	key = irq_lock();
@@ -184,9 +225,8 @@ int k_poll(struct k_poll_event *events, int num_events, s32_t timeout)
 	irq_unlock(key);
 
 	/*
-	 * We can get by with one poller structure for all events for now:
-	 * if/when we allow multiple threads to poll on the same object, we
-	 * will need one per poll event associated with an object.
+	 * We can get by with one poller structure for all events: each
+	 * event links the poller to the list of pollers of its object.
 	 */
 	struct _poller poller = { .thread = _current };
 
@@ -198,21 +238,9 @@ int k_poll(struct k_poll_event *events, int num_events, s32_t timeout)
 		if (is_condition_met(&events[ii], &state)) {
 			set_event_ready(&events[ii], state);
 			clear_polling_state(_current);
-		} else if (timeout != K_NO_WAIT && is_polling() && !in_use) {
-			rc = register_event(&events[ii]);
-			if (rc == 0) {
-				events[ii].poller = &poller;
-				++last_registered;
-			} else if (rc == -EADDRINUSE) {
-				/* setting in_use also prevents any further
-				 * registrations by the current thread
-				 */
-				in_use = -EADDRINUSE;
-				events[ii].state = K_POLL_STATE_EADDRINUSE;
-				clear_polling_state(_current);
-			} else {
-				__ASSERT(0, "unexpected return code\n");
-			}
+		} else if (timeout != K_NO_WAIT && is_polling()) {
+			register_event(&events[ii], &poller);
+			++last_registered;
 		}
 		irq_unlock(key);
 	}
@@ -222,18 +250,13 @@ int k_poll(struct k_poll_event *events, int num_events, s32_t timeout)
 	/*
 	 * If we're not polling anymore, it means that at least one event
 	 * condition is met, either when looping through the events here or
-	 * because one of the events registered has had its state changed, or
-	 * that one of the objects we wanted to poll on already had a thread
-	 * polling on it. We can remove all registrations and return either
-	 * success or a -EADDRINUSE error. In the case of a -EADDRINUSE error,
-	 * the events that were available are still flagged as such, and it is
-	 * valid for the caller to consider them available, as if this function
-	 * returned success.
+	 * because one of the events registered has had its state changed. We
+	 * can remove all registrations and return success.
 	 */
 	if (!is_polling()) {
 		clear_event_registrations(events, last_registered, key);
 		irq_unlock(key);
-		return in_use;
+		return 0;
 	}
 
 	clear_polling_state(_current);
@@ -265,7 +288,11 @@ int k_poll(struct k_poll_event *events, int num_events, s32_t timeout)
 	return swap_rc;
 }
 
-/* must be called with interrupts locked */
+/*
+ * Must be called with interrupts locked. Returns 0 if the poller gets the
+ * event, -EALREADY if another event woke it up already, -EAGAIN if its
+ * timeout is expiring.
+ */
 static int _signal_poll_event(struct k_poll_event *event, u32_t state,
 			      int *must_reschedule)
 {
@@ -279,6 +306,15 @@ static int _signal_poll_event(struct k_poll_event *event, u32_t state,
 
 	__ASSERT(event->poller->thread, "poller should have a thread\n");
 
+	/*
+	 * A poller that is neither registering its events nor pending has
+	 * been woken up by another event, and has not cleared this one yet.
+	 */
+	if (!_is_thread_polling(thread) && !_is_thread_pending(thread)) {
+		set_event_ready(event, state);
+		return -EALREADY;
+	}
+
 	clear_polling_state(thread);
 
 	if (!_is_thread_pending(thread)) {
@@ -286,6 +322,8 @@ static int _signal_poll_event(struct k_poll_event *event, u32_t state,
 	}
 
 	if (_is_thread_timeout_expired(thread)) {
+		/* the event is off its object's list already */
+		event->poller = NULL;
 		return -EAGAIN;
 	}
 
@@ -306,20 +344,36 @@ ready_event:
 }
 
 /* returns 1 if a reschedule must take place, 0 otherwise */
-/* *obj_poll_event is guaranteed to not be NULL */
-int _handle_obj_poll_event(struct k_poll_event **obj_poll_event, u32_t state)
+int _handle_obj_poll_events(sys_dlist_t *events, u32_t state)
 {
-	struct k_poll_event *poll_event = *obj_poll_event;
-	int must_reschedule;
+	struct k_poll_event *poll_event;
+	int must_reschedule, any_reschedule = 0;
+
+	while ((poll_event = (struct k_poll_event *)sys_dlist_get(events))) {
+		int rc = _signal_poll_event(poll_event, state,
+					    &must_reschedule);
+
+		any_reschedule |= must_reschedule;
+
+#ifdef CONFIG_POLL_WAKE_ONE
+		/*
+		 * skip the pollers whose timeout is expiring and those woken
+		 * up already
+		 */
+		if (rc == 0) {
+			break;
+		}
+#else
+		ARG_UNUSED(rc);
+#endif
+	}
 
-	*obj_poll_event = NULL;
-	(void)_signal_poll_event(poll_event, state, &must_reschedule);
-	return must_reschedule;
+	return any_reschedule;
 }
 
 void k_poll_signal_init(struct k_poll_signal *signal)
 {
-	signal->poll_event = NULL;
+	sys_dlist_init(&signal->poll_events);
 	signal->signaled = 0;
 	/* signal->result is left unitialized */
 }
@@ -327,20 +381,24 @@ void k_poll_signal_init(struct k_poll_signal *signal)
 int k_poll_signal(struct k_poll_signal *signal, int result)
 {
 	unsigned int key = irq_lock();
-	int must_reschedule;
+	struct k_poll_event *poll_event;
+	int must_reschedule, any_reschedule = 0;
+	int rc = 0;
 
 	signal->result = result;
 	signal->signaled = 1;
 
-	if (!signal->poll_event) {
-		irq_unlock(key);
-		return 0;
+	/* a signal stays set, so all its pollers are notified */
+	while ((poll_event = (struct k_poll_event *)
+		sys_dlist_get(&signal->poll_events))) {
+		if (_signal_poll_event(poll_event, K_POLL_STATE_SIGNALED,
+				       &must_reschedule) == -EAGAIN) {
+			rc = -EAGAIN;
+		}
+		any_reschedule |= must_reschedule;
 	}
 
-	int rc = _signal_poll_event(signal->poll_event, K_POLL_STATE_SIGNALED,
-				    &must_reschedule);
-
-	if (must_reschedule) {
+	if (any_reschedule) {
 		(void)_Swap(key);
 	} else {
 		irq_unlock(key);
@@ -70,8 +70,7 @@ static inline int handle_poll_event(struct k_queue *queue)
 #ifdef CONFIG_POLL
 	u32_t state = K_POLL_STATE_DATA_AVAILABLE;
 
-	return queue->poll_event ?
-	       _handle_obj_poll_event(&queue->poll_event, state) : 0;
+	return _handle_obj_poll_events(&queue->poll_events, state);
 #else
 	return 0;
 #endif
@@ -183,3 +182,86 @@ void *k_queue_get(struct k_queue *queue, s32_t timeout)
 
 	return _Swap(key) ? NULL : _current->base.swap_data;
 }
+
+/*
+ * Detach up to max items from the head of the queue, or all of them if max
+ * is 0, and append them to list. Must be called with interrupts locked,
+ * returns with them unlocked. Only the cut of the queue is done with
+ * interrupts locked when detaching all the items; the detached items are
+ * counted afterwards.
+ */
+static int detach_items(struct k_queue *queue, sys_slist_t *list, int max,
+			unsigned int key)
+{
+	sys_snode_t *head = queue->data_q.head;
+	sys_snode_t *tail, *node;
+	int count = 1;
+
+	if (!head) {
+		irq_unlock(key);
+		return 0;
+	}
+
+	if (max == 0) {
+		tail = queue->data_q.tail;
+		sys_slist_init(&queue->data_q);
+		irq_unlock(key);
+
+		for (node = head; node != tail; node = node->next) {
+			count++;
+		}
+	} else {
+		for (tail = head; count < max && tail->next;
+		     tail = tail->next) {
+			count++;
+		}
+
+		queue->data_q.head = tail->next;
+		if (!tail->next) {
+			queue->data_q.tail = NULL;
+		}
+		irq_unlock(key);
+
+		tail->next = NULL;
+	}
+
+	sys_slist_append_list(list, head, tail);
+
+	return count;
+}
+
+int k_queue_get_batch(struct k_queue *queue, sys_slist_t *list, int max,
+		      s32_t timeout)
+{
+	unsigned int key;
+
+	__ASSERT(max >= 0, "invalid max");
+
+	key = irq_lock();
+
+	if (likely(!sys_slist_is_empty(&queue->data_q))) {
+		return detach_items(queue, list, max, key);
+	}
+
+	if (timeout == K_NO_WAIT) {
+		irq_unlock(key);
+		return 0;
+	}
+
+	_pend_current_thread(&queue->wait_q, timeout);
+
+	if (_Swap(key)) {
+		return 0;
+	}
+
+	/* the first item was handed over directly, others may have followed */
+	sys_slist_append(list, _current->base.swap_data);
+
+	if (max == 1) {
+		return 1;
+	}
+
+	key = irq_lock();
+
+	return 1 + detach_items(queue, list, max ? max - 1 : 0, key);
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel reader-writer lock object.
+ *
+ * Any number of threads can hold a reader-writer lock to read, or a single
+ * thread to write. Threads waiting to write have precedence: once a writer
+ * waits, new readers wait behind it, so that a steady flow of readers
+ * cannot starve the writers.
+ *
+ * The lock is handed over directly to the threads it wakes up: the last
+ * reader releasing it gives it to the first waiting writer, and a writer
+ * releasing it gives it to the next waiting writer, or else to all the
+ * waiting readers at once.
+ *
+ * With CONFIG_RWLOCK_PRIO_INHERIT, the writer inherits the priority of the
+ * threads waiting on the lock. The lock goes on the writer's list of locks
+ * held, next to the mutexes it owns, and its priority is computed from the
+ * waiters of all of them.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/object_tracing_common.h>
+#include <toolchain.h>
+#include <sections.h>
+#include <wait_q.h>
+#include <misc/dlist.h>
+#include <ksched.h>
+#include <init.h>
+
+extern struct k_rwlock _k_rwlock_list_start[];
+extern struct k_rwlock _k_rwlock_list_end[];
+
+struct k_rwlock *_trace_list_k_rwlock;
+
+#ifdef CONFIG_OBJECT_TRACING
+
+/*
+ * Complete initialization of statically defined reader-writer locks.
+ */
+static int init_rwlock_module(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	struct k_rwlock *rwlock;
+
+	for (rwlock = _k_rwlock_list_start; rwlock < _k_rwlock_list_end;
+	     rwlock++) {
+		SYS_TRACING_OBJ_INIT(k_rwlock, rwlock);
+	}
+	return 0;
+}
+
+SYS_INIT(init_rwlock_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+#endif /* CONFIG_OBJECT_TRACING */
+
+void k_rwlock_init(struct k_rwlock *rwlock)
+{
+	sys_dlist_init(&rwlock->wait_q.readers);
+	sys_dlist_init(&rwlock->wait_q.writers);
+	rwlock->writer = NULL;
+	rwlock->readers = 0;
+
+#ifdef CONFIG_POLL
+	sys_dlist_init(&rwlock->poll_events);
+	sys_dlist_init(&rwlock->read_poll_events);
+#endif
+
+	SYS_TRACING_OBJ_INIT(k_rwlock, rwlock);
+}
+
+static inline int is_readable(struct k_rwlock *rwlock)
+{
+	return !rwlock->writer && sys_dlist_is_empty(&rwlock->wait_q.writers);
+}
+
+/* returns 1 if a reschedule must take place, 0 otherwise */
+static inline int handle_poll_events(struct k_rwlock *rwlock)
+{
+#ifdef CONFIG_POLL
+	int must_reschedule = 0;
+
+	if (is_readable(rwlock)) {
+		must_reschedule |= _handle_obj_poll_events(
+			&rwlock->read_poll_events,
+			K_POLL_STATE_RWLOCK_READABLE);
+
+		if (rwlock->readers == 0) {
+			must_reschedule |= _handle_obj_poll_events(
+				&rwlock->poll_events,
+				K_POLL_STATE_RWLOCK_WRITABLE);
+		}
+	}
+
+	return must_reschedule;
+#else
+	return 0;
+#endif
+}
+
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+/*
+ * Give the writer holding the lock the priority of the highest priority
+ * thread waiting on it or on the other locks it holds, or its own.
+ *
+ * Must be called with interrupts locked.
+ */
+static void adjust_writer_prio(struct k_rwlock *rwlock)
+{
+	if (rwlock->writer) {
+		_adjust_owner_prio(rwlock->writer);
+	}
+}
+#else
+#define adjust_writer_prio(rwlock) do { } while ((0))
+#endif
+
+/* must be called with interrupts locked */
+static void set_writer(struct k_rwlock *rwlock, struct k_thread *thread)
+{
+	rwlock->writer = thread;
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+	sys_dlist_append(&thread->base.write_rwlocks, &rwlock->writer_node);
+#endif
+}
+
+/* must be called with interrupts locked */
+static void wake_thread(struct k_thread *thread)
+{
+	_abort_thread_timeout(thread);
+	_ready_thread(thread);
+	_set_thread_return_value(thread, 0);
+}
+
+/*
+ * Hand the lock over to the first waiting writer, or else to all the
+ * waiting readers, and notify the pollers if it is still available.
+ *
+ * Must be called with interrupts locked, returns 1 if a reschedule must
+ * take place, 0 otherwise.
+ */
+static int hand_over(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	int must_reschedule = 0;
+
+	if (rwlock->readers == 0 && !rwlock->writer) {
+		thread = _unpend_first_thread(&rwlock->wait_q.writers);
+		if (thread) {
+			set_writer(rwlock, thread);
+			wake_thread(thread);
+
+			/* readers waiting behind a lower priority writer */
+			adjust_writer_prio(rwlock);
+
+			return _must_switch_threads();
+		}
+	}
+
+	if (is_readable(rwlock)) {
+		while ((thread =
+			_unpend_first_thread(&rwlock->wait_q.readers))) {
+			rwlock->readers++;
+			wake_thread(thread);
+			must_reschedule = 1;
+		}
+	}
+
+	must_reschedule |= handle_poll_events(rwlock);
+
+	return must_reschedule && _must_switch_threads();
+}
+
+/* must be called with interrupts locked */
+static int wait_for_lock(struct k_rwlock *rwlock, _wait_q_t *wait_q,
+			 s32_t timeout, unsigned int key)
+{
+	int rc;
+
+	_pend_current_thread(wait_q, timeout);
+
+	adjust_writer_prio(rwlock);
+
+	rc = _Swap(key);
+	if (rc == 0) {
+		return 0;
+	}
+
+	/* timed out: the lock may be available to the other waiters now */
+
+	key = irq_lock();
+
+	adjust_writer_prio(rwlock);
+
+	if (hand_over(rwlock)) {
+		_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return rc;
+}
+
+int k_rwlock_read_lock(struct k_rwlock *rwlock, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr(), "");
+
+	unsigned int key = irq_lock();
+
+	if (likely(is_readable(rwlock))) {
+		rwlock->readers++;
+		irq_unlock(key);
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	return wait_for_lock(rwlock, &rwlock->wait_q.readers, timeout, key);
+}
+
+void k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	unsigned int key = irq_lock();
+
+	__ASSERT(rwlock->readers > 0, "lock not held to read");
+
+	rwlock->readers--;
+
+	if (hand_over(rwlock)) {
+		_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+}
+
+int k_rwlock_write_lock(struct k_rwlock *rwlock, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr(), "");
+
+	unsigned int key = irq_lock();
+
+	__ASSERT(rwlock->writer != _current, "lock already held to write");
+
+	if (likely(!rwlock->writer && rwlock->readers == 0)) {
+		set_writer(rwlock, _current);
+		irq_unlock(key);
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	return wait_for_lock(rwlock, &rwlock->wait_q.writers, timeout, key);
+}
+
+void k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	unsigned int key = irq_lock();
+
+	__ASSERT(rwlock->writer == _current, "lock not held to write");
+
+	rwlock->writer = NULL;
+
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+	/* keep what is inherited from the waiters of the other locks held */
+	sys_dlist_remove(&rwlock->writer_node);
+	_adjust_owner_prio(_current);
+#endif
+
+	if (hand_over(rwlock)) {
+		_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+}
@@ -22,6 +22,10 @@ static void _set_ready_q_prio_bit(int prio)
 	u32_t *bmap = &_ready_q.prio_bmap[bmap_index];
 
 	*bmap |= _get_ready_q_prio_bit(prio);
+
+#if (K_NUM_PRIO_BITMAPS > 1)
+	_ready_q.prio_bmap_summary |= (1U << bmap_index);
+#endif
 }
 #endif
 
@@ -33,6 +37,12 @@ static void _clear_ready_q_prio_bit(int prio)
 	u32_t *bmap = &_ready_q.prio_bmap[bmap_index];
 
 	*bmap &= ~_get_ready_q_prio_bit(prio);
+
+#if (K_NUM_PRIO_BITMAPS > 1)
+	if (!*bmap) {
+		_ready_q.prio_bmap_summary &= ~(1U << bmap_index);
+	}
+#endif
 }
 #endif
 
@@ -58,6 +68,36 @@ static struct k_thread *_get_ready_q_head(void)
 }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+/*
+ * Insert thread in a ready queue scheduled by earliest deadline, after the
+ * threads with an earlier or equal deadline, and update the cache if it
+ * becomes the next thread to run.
+ */
+static void _add_thread_by_deadline(sys_dlist_t *q, struct k_thread *thread)
+{
+	sys_dnode_t *node;
+
+	SYS_DLIST_FOR_EACH_NODE(q, node) {
+		struct k_thread *ready = (struct k_thread *)node;
+
+		if (_is_t1_deadline_before_t2(thread, ready)) {
+			sys_dlist_insert_before(q, node,
+						&thread->base.k_q_node);
+			goto inserted;
+		}
+	}
+
+	sys_dlist_append(q, &thread->base.k_q_node);
+
+inserted:
+	if (sys_dlist_is_head(q, &thread->base.k_q_node) &&
+	    !_is_t1_higher_prio_than_t2(_ready_q.cache, thread)) {
+		_ready_q.cache = thread;
+	}
+}
+#endif
+
 /*
  * Add thread to the ready queue, in the slot for its priority; the thread
  * must not be on a wait queue.
@@ -75,6 +115,14 @@ void _add_thread_to_ready_q(struct k_thread *thread)
 	sys_dlist_t *q = &_ready_q.q[q_index];
 
 	_set_ready_q_prio_bit(thread->base.prio);
+
+#ifdef CONFIG_SCHED_DEADLINE
+	if (_is_deadline_prio(thread->base.prio)) {
+		_add_thread_by_deadline(q, thread);
+		return;
+	}
+#endif
+
 	sys_dlist_append(q, &thread->base.k_q_node);
 
 	struct k_thread **cache = &_ready_q.cache;
@@ -228,18 +276,53 @@ void _pend_current_thread(_wait_q_t *wait_q, s32_t timeout)
 int __must_switch_threads(void)
 {
 #ifdef CONFIG_PREEMPT_ENABLED
+	/* the cache always holds a thread of the highest ready priority */
+	struct k_thread *next = _get_next_ready_thread();
+
 	K_DEBUG("current prio: %d, highest prio: %d\n",
-		_current->base.prio, _get_highest_ready_prio());
+		_current->base.prio, next->base.prio);
 
+#ifdef CONFIG_KERNEL_DEBUG
 	extern void _dump_ready_q(void);
 	_dump_ready_q();
+#endif
 
-	return _is_prio_higher(_get_highest_ready_prio(), _current->base.prio);
+#ifdef CONFIG_SCHED_DEADLINE
+	/* the next thread is ahead of the current one by deadline */
+	if (next != _current && next->base.prio == _current->base.prio &&
+	    _is_deadline_prio(next->base.prio)) {
+		return 1;
+	}
+#endif
+
+	return _is_prio_higher(next->base.prio, _current->base.prio);
 #else
 	return 0;
 #endif
 }
 
+#ifdef CONFIG_SCHED_DEADLINE
+void k_thread_deadline_set(k_tid_t tid, int deadline)
+{
+	struct k_thread *thread = (struct k_thread *)tid;
+	int key = irq_lock();
+
+	thread->base.deadline = k_cycle_get_32() + deadline;
+
+	/* requeue the thread at its new position */
+	if (_is_thread_ready(thread) && _is_deadline_prio(thread->base.prio)) {
+		_remove_thread_from_ready_q(thread);
+		_add_thread_to_ready_q(thread);
+	}
+
+	if (_is_in_isr()) {
+		irq_unlock(key);
+	} else {
+		_reschedule_threads(key);
+	}
+}
+#endif
+
 int  k_thread_priority_get(k_tid_t thread)
 {
 	return thread->base.prio;
@@ -257,7 +340,9 @@ void k_thread_priority_set(k_tid_t tid, int prio)
 	struct k_thread *thread = (struct k_thread *)tid;
 	int key = irq_lock();
 
-	_thread_priority_set(thread, prio);
+	/* a priority inherited from lock waiters is kept if higher */
+	thread->base.orig_prio = prio;
+	_adjust_owner_prio(thread);
 	_reschedule_threads(key);
 }
 
@@ -279,6 +364,18 @@ void _move_thread_to_end_of_prio_q(struct k_thread *thread)
 	}
 
 	sys_dlist_remove(&thread->base.k_q_node);
+
+#ifdef CONFIG_SCHED_DEADLINE
+	if (_is_deadline_prio(thread->base.prio)) {
+		/* only go behind the threads with the same deadline */
+		if (_ready_q.cache == thread) {
+			_ready_q.cache = _get_ready_q_head();
+		}
+		_add_thread_by_deadline(q, thread);
+		return;
+	}
+#endif
+
 	sys_dlist_append(q, &thread->base.k_q_node);
 
 	struct k_thread **cache = &_ready_q.cache;
@@ -364,6 +461,9 @@ k_tid_t k_current_get(void)
 /* debug aid */
 void _dump_ready_q(void)
 {
+#if (K_NUM_PRIO_BITMAPS > 1)
+	K_DEBUG("summary: %x\n", _ready_q.prio_bmap_summary);
+#endif
 	K_DEBUG("bitmaps: ");
 	for (int bitmap = 0; bitmap < K_NUM_PRIO_BITMAPS; bitmap++) {
 		K_DEBUG("%x", _ready_q.prio_bmap[bitmap]);
@@ -73,8 +73,7 @@ static inline int handle_poll_event(struct k_sem *sem)
 #ifdef CONFIG_POLL
 	u32_t state = K_POLL_STATE_SEM_AVAILABLE;
 
-	return sem->poll_event ?
-	       _handle_obj_poll_event(&sem->poll_event, state) : 0;
+	return _handle_obj_poll_events(&sem->poll_events, state);
 #else
 	return 0;
 #endif
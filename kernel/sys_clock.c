@@ -200,6 +200,33 @@ u32_t k_uptime_delta_32(s64_t *reftime)
 	return (u32_t)k_uptime_delta(reftime);
 }
 
+#ifdef CONFIG_SYS_CLOCK_WAKEUP_STATS
+static struct k_wakeup_stats wakeup_stats;
+
+#define count_wakeup_stat(field) (wakeup_stats.field++)
+
+/* the system clock interrupt woke the system up if it preempted idle */
+static inline void count_announcement(void)
+{
+	wakeup_stats.announcements++;
+	if (_current == _idle_thread) {
+		wakeup_stats.idle_wakeups++;
+	}
+}
+
+void k_wakeup_stats_get(struct k_wakeup_stats *stats)
+{
+	unsigned int key = irq_lock();
+
+	*stats = wakeup_stats;
+
+	irq_unlock(key);
+}
+#else
+#define count_wakeup_stat(field) do { } while ((0))
+#define count_announcement() do { } while ((0))
+#endif
+
 /* handle the expired timeouts in the nano timeout queue */
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
@@ -213,12 +240,67 @@ u32_t k_uptime_delta_32(s64_t *reftime)
  * as _EXPIRED so that an ISR preempting us and releasing an object on which
  * a thread was timing out and expired will not give the object to that thread.
  *
+ * Running the expiry functions and readying the threads that timed out is
+ * thus always done in the second phase, with interrupts only locked around
+ * each ready queue update.
+ *
  * Always called from interrupt level, and always only from the system clock
  * interrupt.
  */
 
 volatile int _handling_timeouts;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+static inline void handle_timeouts(s32_t ticks)
+{
+	sys_dlist_t expired;
+	struct _timeout *timeout;
+	unsigned int key;
+
+	/* init before locking interrupts */
+	sys_dlist_init(&expired);
+
+	key = irq_lock();
+
+	_timeout_q.now += ticks;
+
+	K_DEBUG("root: %p, now: %u\n", _timeout_q.root, _timeout_q.now);
+
+	_handling_timeouts = 1;
+
+	/*
+	 * Pop expired timeouts off the heap in expiry order, relieving irq
+	 * lock pressure between each of them. Timeouts expiring on the same
+	 * tick come out in the order they were added, so they are appended
+	 * to the expired queue.
+	 */
+	timeout = _timeout_q.root;
+
+	while (timeout && (s32_t)(timeout->expiry - _timeout_q.now) <= 0) {
+
+		_timeout_heap_remove(timeout);
+		sys_dlist_append(&expired, &timeout->node);
+
+		timeout->delta_ticks_from_prev = _EXPIRED;
+		count_wakeup_stat(timeouts);
+
+		irq_unlock(key);
+		key = irq_lock();
+
+		timeout = _timeout_q.root;
+	}
+
+	if (!sys_dlist_is_empty(&expired)) {
+		count_wakeup_stat(expirations);
+	}
+
+	irq_unlock(key);
+
+	_handle_expired_timeouts(&expired);
+
+	_handling_timeouts = 0;
+}
+#else
 static inline void handle_timeouts(s32_t ticks)
 {
 	sys_dlist_t expired;
@@ -270,6 +352,7 @@ static inline void handle_timeouts(s32_t ticks)
 		sys_dlist_prepend(&expired, next);
 
 		timeout->delta_ticks_from_prev = _EXPIRED;
+		count_wakeup_stat(timeouts);
 
 		irq_unlock(key);
 		key = irq_lock();
@@ -278,12 +361,17 @@ static inline void handle_timeouts(s32_t ticks)
 		timeout = (struct _timeout *)next;
 	}
 
+	if (!sys_dlist_is_empty(&expired)) {
+		count_wakeup_stat(expirations);
+	}
+
 	irq_unlock(key);
 
 	_handle_expired_timeouts(&expired);
 
 	_handling_timeouts = 0;
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP */
 #else
 	#define handle_timeouts(ticks) do { } while ((0))
 #endif
@@ -362,6 +450,8 @@ void _nano_sys_clock_tick_announce(s32_t ticks)
 	_sys_clock_tick_count += ticks;
 	irq_unlock(key);
 #endif
+	count_announcement();
+
 	handle_timeouts(ticks);
 
 	/* time slicing is basically handled like just yet another timeout */
@@ -133,6 +133,56 @@ void _thread_monitor_exit(struct k_thread *thread)
 }
 #endif /* CONFIG_THREAD_MONITOR */
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/*
+ * Charge the outgoing thread with the cycles elapsed since the last context
+ * switch. Called from the architecture's context switch code, with
+ * interrupts locked, while _current is still the outgoing thread. On ARM
+ * that is in __pendsv, once it has raised BASEPRI or set PRIMASK.
+ */
+void _thread_runtime_switch(void)
+{
+	u32_t now = k_cycle_get_32();
+	u32_t delta = now - _kernel.runtime_stamp;
+
+	_kernel.runtime_stamp = now;
+	_kernel.runtime_total += delta;
+	_current->runtime += delta;
+}
+
+u64_t k_thread_runtime_get(k_tid_t thread)
+{
+	unsigned int key = irq_lock();
+	u64_t runtime = thread->runtime;
+
+	if (thread == _current) {
+		runtime += k_cycle_get_32() - _kernel.runtime_stamp;
+	}
+
+	irq_unlock(key);
+
+	return runtime;
+}
+
+void k_cpu_stats_get(struct k_cpu_stats *stats)
+{
+	unsigned int key = irq_lock();
+	u64_t total = _kernel.runtime_total;
+	u64_t idle = _idle_thread->runtime;
+	u32_t delta = k_cycle_get_32() - _kernel.runtime_stamp;
+
+	total += delta;
+	if (_current == _idle_thread) {
+		idle += delta;
+	}
+
+	irq_unlock(key);
+
+	stats->busy_cycles = total - idle;
+	stats->idle_cycles = idle;
+}
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
 /*
  * Common thread entry point function (used by all threads)
  *
@@ -406,8 +456,19 @@ void _init_thread_base(struct _thread_base *thread_base, int priority,
 
 	thread_base->sched_locked = 0;
 
+#ifdef CONFIG_SCHED_DEADLINE
+	thread_base->deadline = k_cycle_get_32();
+#endif
+
 	/* swap_data does not need to be initialized */
 
+	sys_dlist_init(&thread_base->contended_mutexes);
+	thread_base->pended_mutex = NULL;
+#ifdef CONFIG_RWLOCK_PRIO_INHERIT
+	sys_dlist_init(&thread_base->write_rwlocks);
+#endif
+	thread_base->orig_prio = priority;
+
 	_init_thread_timeout(thread_base);
 }
 
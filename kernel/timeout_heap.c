@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief pairing heap implementation of the timeout queue
+ *
+ * Timeouts are keyed on their absolute expiry tick, with ties broken by
+ * insertion order. Inserting is O(1) and removing any timeout, including the
+ * one expiring first, is O(log n) amortized, so the cost of the timeout queue
+ * operations no longer grows linearly with the number of active timeouts.
+ *
+ * While a timeout is in the heap, its dlist node is reused for the heap
+ * links: node.next points to its next sibling and node.prev points to its
+ * parent if it is the leftmost child, or to its previous sibling otherwise.
+ *
+ * All routines must be called with interrupts locked.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+
+#define sibling(t) ((struct _timeout *)(t)->node.next)
+#define left(t) ((struct _timeout *)(t)->node.prev)
+#define set_sibling(t, s) ((t)->node.next = (sys_dnode_t *)(s))
+#define set_left(t, l) ((t)->node.prev = (sys_dnode_t *)(l))
+
+static inline int expires_before(struct _timeout *a, struct _timeout *b)
+{
+	s32_t diff = (s32_t)(a->expiry - b->expiry);
+
+	return diff < 0 || (diff == 0 && (s32_t)(a->seq - b->seq) < 0);
+}
+
+/*
+ * Link two detached heaps, returning the new root: the root that expires
+ * last becomes the leftmost child of the other.
+ */
+static struct _timeout *meld(struct _timeout *a, struct _timeout *b)
+{
+	if (!a) {
+		return b;
+	}
+
+	if (!b) {
+		return a;
+	}
+
+	if (expires_before(b, a)) {
+		struct _timeout *tmp = a;
+
+		a = b;
+		b = tmp;
+	}
+
+	set_sibling(b, a->child);
+	if (a->child) {
+		set_left(a->child, b);
+	}
+	set_left(b, a);
+	a->child = b;
+
+	return a;
+}
+
+/*
+ * Standard two-pass merge of a list of siblings: meld them in pairs from
+ * left to right, then meld the resulting heaps from right to left.
+ */
+static struct _timeout *merge_pairs(struct _timeout *first)
+{
+	struct _timeout *pairs = NULL;
+	struct _timeout *root = NULL;
+
+	while (first) {
+		struct _timeout *a = first;
+		struct _timeout *b = sibling(a);
+
+		first = b ? sibling(b) : NULL;
+
+		set_sibling(a, NULL);
+		set_left(a, NULL);
+		if (b) {
+			set_sibling(b, NULL);
+			set_left(b, NULL);
+		}
+
+		a = meld(a, b);
+
+		/* stack the pairs, the second pass pops them right to left */
+		set_sibling(a, pairs);
+		pairs = a;
+	}
+
+	while (pairs) {
+		struct _timeout *next = sibling(pairs);
+
+		set_sibling(pairs, NULL);
+		root = meld(root, pairs);
+		pairs = next;
+	}
+
+	return root;
+}
+
+void _timeout_heap_insert(struct _timeout *timeout)
+{
+	timeout->child = NULL;
+	set_sibling(timeout, NULL);
+	set_left(timeout, NULL);
+
+	_timeout_q.root = meld(_timeout_q.root, timeout);
+}
+
+void _timeout_heap_remove(struct _timeout *timeout)
+{
+	struct _timeout *subheap;
+
+	if (timeout == _timeout_q.root) {
+		_timeout_q.root = merge_pairs(timeout->child);
+	} else {
+		struct _timeout *prev = left(timeout);
+		struct _timeout *next = sibling(timeout);
+
+		if (prev->child == timeout) {
+			prev->child = next;
+		} else {
+			set_sibling(prev, next);
+		}
+
+		if (next) {
+			set_left(next, prev);
+		}
+
+		subheap = merge_pairs(timeout->child);
+		_timeout_q.root = meld(_timeout_q.root, subheap);
+	}
+
+	timeout->child = NULL;
+	set_sibling(timeout, NULL);
+	set_left(timeout, NULL);
+}
@@ -35,6 +35,19 @@ SYS_INIT(init_timer_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
 #endif /* CONFIG_OBJECT_TRACING */
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/*
+ * Count the next period from the time the timer was due, rather than from
+ * the time its slack delayed it to, so that the slack does not accumulate.
+ */
+static s32_t next_period_ticks(struct k_timer *timer)
+{
+	return max(timer->period - timer->timeout.slack_delay, 1);
+}
+#else
+#define next_period_ticks(timer) ((timer)->period)
+#endif
+
 /**
  * @brief Handle expiration of a kernel timer object.
  *
@@ -55,7 +68,7 @@ void _timer_expiration_handler(struct _timeout *t)
 	if (timer->period > 0) {
 		key = irq_lock();
 		_add_timeout(NULL, &timer->timeout, &timer->wait_q,
-				timer->period);
+				next_period_ticks(timer));
 		irq_unlock(key);
 	}
 
@@ -129,6 +142,12 @@ void k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
 }
 
 
+void k_timer_slack_set(struct k_timer *timer, s32_t slack)
+{
+	_set_timeout_slack(&timer->timeout, slack);
+}
+
+
 void k_timer_stop(struct k_timer *timer)
 {
 	int key = irq_lock();
@@ -208,19 +227,7 @@ s32_t _timeout_remaining_get(struct _timeout *timeout)
 	if (timeout->delta_ticks_from_prev == _INACTIVE) {
 		remaining_ticks = 0;
 	} else {
-		/*
-		 * compute remaining ticks by walking the timeout list
-		 * and summing up the various tick deltas involved
-		 */
-		struct _timeout *t =
-			(struct _timeout *)sys_dlist_peek_head(&_timeout_q);
-
-		remaining_ticks = t->delta_ticks_from_prev;
-		while (t != timeout) {
-			t = (struct _timeout *)sys_dlist_peek_next(&_timeout_q,
-								   &t->node);
-			remaining_ticks += t->delta_ticks_from_prev;
-		}
+		remaining_ticks = _timeout_ticks_remaining(timeout);
 	}
 
 	irq_unlock(key);
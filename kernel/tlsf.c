@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Two-Level Segregated Fit heap
+ *
+ * Implements k_malloc()/k_free() on a Two-Level Segregated Fit allocator,
+ * as described in "TLSF: a New Dynamic Memory Allocator for Real-Time
+ * Systems" (M. Masmano et al.).
+ *
+ * Free blocks are kept in segregated lists: the first level splits sizes in
+ * power of two classes, the second level splits each class linearly into
+ * 2^CONFIG_HEAP_TLSF_SL_INDEX_LOG2 lists. A bitmap per level records which
+ * lists are not empty, so that a suitable free block is found with two find
+ * first set bit operations. Blocks are split on allocation and merged with
+ * their free physical neighbours on free, so both operations run in bounded
+ * constant time, and a request only wastes the rounding to the alignment
+ * plus one word of header, instead of up to the next power of two.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <stddef.h>
+
+#define HEAP_SIZE CONFIG_HEAP_MEM_POOL_SIZE
+
+#define ALIGN_SIZE sizeof(void *)
+#define ALIGN_UP(n) (((n) + ALIGN_SIZE - 1) & ~(ALIGN_SIZE - 1))
+#define ALIGN_DOWN(n) ((n) & ~(ALIGN_SIZE - 1))
+
+#define SL_INDEX_LOG2 CONFIG_HEAP_TLSF_SL_INDEX_LOG2
+#define SL_INDEX_COUNT (1 << SL_INDEX_LOG2)
+
+/* sizes below SMALL_BLOCK_SIZE are all in the first first-level list */
+#define FL_INDEX_SHIFT (SL_INDEX_LOG2 + (ALIGN_SIZE == 8 ? 3 : 2))
+#define SMALL_BLOCK_SIZE (1 << FL_INDEX_SHIFT)
+
+/* no block can be larger than the heap, the compiler folds this */
+#define FL_INDEX_MAX (31 - __builtin_clz(HEAP_SIZE))
+#define FL_INDEX_COUNT (FL_INDEX_MAX - FL_INDEX_SHIFT + 2)
+
+/*
+ * Block header. prev_phys is only valid when the previous physical block is
+ * free: it overlaps the last word of that block's payload. The free list
+ * links are only valid when this block is free: they overlap its payload.
+ * Allocated blocks thus only cost the size word.
+ */
+struct tlsf_block {
+	struct tlsf_block *prev_phys;
+	size_t size;
+	struct tlsf_block *next_free;
+	struct tlsf_block *prev_free;
+};
+
+/* flags in the low bits of the size word, free since sizes are aligned */
+#define BLOCK_FREE 0x1
+#define BLOCK_PREV_FREE 0x2
+#define BLOCK_FLAGS (BLOCK_FREE | BLOCK_PREV_FREE)
+
+#define BLOCK_OVERHEAD sizeof(size_t)
+#define BLOCK_PAYLOAD_OFFSET (offsetof(struct tlsf_block, size) + \
+			      sizeof(size_t))
+#define BLOCK_SIZE_MIN (sizeof(struct tlsf_block) - \
+			sizeof(struct tlsf_block *))
+#define BLOCK_SIZE_MAX ((size_t)1 << FL_INDEX_MAX)
+
+struct tlsf_heap {
+	u32_t fl_bitmap;
+	u32_t sl_bitmap[FL_INDEX_COUNT];
+	struct tlsf_block *blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+	/* statistics, block headers included so that the sum of used_bytes
+	 * and free_bytes does not change
+	 */
+	size_t used_bytes;
+	size_t max_used_bytes;
+	size_t free_bytes;
+};
+
+BUILD_ASSERT_MSG(HEAP_SIZE >= 256,
+		 "CONFIG_HEAP_MEM_POOL_SIZE is too small for the TLSF heap");
+
+static char __aligned(ALIGN_SIZE) heap_mem[HEAP_SIZE];
+static struct tlsf_heap heap;
+
+static inline size_t block_size(struct tlsf_block *block)
+{
+	return block->size & ~BLOCK_FLAGS;
+}
+
+static inline void block_set_size(struct tlsf_block *block, size_t size)
+{
+	block->size = size | (block->size & BLOCK_FLAGS);
+}
+
+static inline bool block_is_free(struct tlsf_block *block)
+{
+	return block->size & BLOCK_FREE;
+}
+
+static inline bool block_is_prev_free(struct tlsf_block *block)
+{
+	return block->size & BLOCK_PREV_FREE;
+}
+
+static inline void *block_to_ptr(struct tlsf_block *block)
+{
+	return (char *)block + BLOCK_PAYLOAD_OFFSET;
+}
+
+static inline struct tlsf_block *block_from_ptr(void *ptr)
+{
+	return (struct tlsf_block *)((char *)ptr - BLOCK_PAYLOAD_OFFSET);
+}
+
+static inline struct tlsf_block *block_next(struct tlsf_block *block)
+{
+	return (struct tlsf_block *)((char *)block_to_ptr(block) +
+				     block_size(block) - BLOCK_OVERHEAD);
+}
+
+/* update the neighbour's view of the block's state */
+static inline void block_mark_free(struct tlsf_block *block)
+{
+	struct tlsf_block *next = block_next(block);
+
+	next->prev_phys = block;
+	next->size |= BLOCK_PREV_FREE;
+	block->size |= BLOCK_FREE;
+}
+
+static inline void block_mark_used(struct tlsf_block *block)
+{
+	block_next(block)->size &= ~BLOCK_PREV_FREE;
+	block->size &= ~BLOCK_FREE;
+}
+
+/* first and second level indexes of the list holding blocks of size */
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+	if (size < SMALL_BLOCK_SIZE) {
+		*fl = 0;
+		*sl = size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+	} else {
+		int msb = find_msb_set(size) - 1;
+
+		*sl = (size >> (msb - SL_INDEX_LOG2)) ^ SL_INDEX_COUNT;
+		*fl = msb - (FL_INDEX_SHIFT - 1);
+	}
+}
+
+/*
+ * Indexes of the first list whose blocks are all at least size bytes:
+ * round the request up to the next list boundary before mapping it.
+ */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+	if (size >= SMALL_BLOCK_SIZE) {
+		size += (1 << (find_msb_set(size) - 1 - SL_INDEX_LOG2)) - 1;
+	}
+
+	mapping_insert(size, fl, sl);
+}
+
+static struct tlsf_block *search_suitable_block(int *fl, int *sl)
+{
+	u32_t sl_map, fl_map;
+
+	if (*fl >= FL_INDEX_COUNT) {
+		return NULL;
+	}
+
+	sl_map = heap.sl_bitmap[*fl] & (~0U << *sl);
+	if (!sl_map) {
+		/* no block in this class, take one from a larger class */
+		fl_map = *fl + 1 < 32 ? heap.fl_bitmap & (~0U << (*fl + 1)) : 0;
+		if (!fl_map) {
+			return NULL;
+		}
+
+		*fl = find_lsb_set(fl_map) - 1;
+		sl_map = heap.sl_bitmap[*fl];
+	}
+
+	*sl = find_lsb_set(sl_map) - 1;
+
+	return heap.blocks[*fl][*sl];
+}
+
+static void remove_free_block(struct tlsf_block *block, int fl, int sl)
+{
+	struct tlsf_block *prev = block->prev_free;
+	struct tlsf_block *next = block->next_free;
+
+	if (next) {
+		next->prev_free = prev;
+	}
+
+	if (prev) {
+		prev->next_free = next;
+	} else {
+		heap.blocks[fl][sl] = next;
+		if (!next) {
+			heap.sl_bitmap[fl] &= ~(1 << sl);
+			if (!heap.sl_bitmap[fl]) {
+				heap.fl_bitmap &= ~(1 << fl);
+			}
+		}
+	}
+
+	heap.free_bytes -= block_size(block) + BLOCK_OVERHEAD;
+}
+
+static void insert_free_block(struct tlsf_block *block)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(block), &fl, &sl);
+
+	block->prev_free = NULL;
+	block->next_free = heap.blocks[fl][sl];
+	if (block->next_free) {
+		block->next_free->prev_free = block;
+	}
+
+	heap.blocks[fl][sl] = block;
+	heap.sl_bitmap[fl] |= (1 << sl);
+	heap.fl_bitmap |= (1 << fl);
+
+	heap.free_bytes += block_size(block) + BLOCK_OVERHEAD;
+}
+
+static void unlink_free_block(struct tlsf_block *block)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(block), &fl, &sl);
+	remove_free_block(block, fl, sl);
+}
+
+/* absorb next into block; both must be out of the free lists */
+static void block_absorb(struct tlsf_block *block, struct tlsf_block *next)
+{
+	block_set_size(block, block_size(block) + block_size(next) +
+		       BLOCK_OVERHEAD);
+}
+
+/* split off the end of a free block to the free lists, if large enough */
+static void block_trim(struct tlsf_block *block, size_t size)
+{
+	struct tlsf_block *rest;
+
+	if (block_size(block) < size + sizeof(struct tlsf_block)) {
+		return;
+	}
+
+	rest = (struct tlsf_block *)((char *)block_to_ptr(block) + size -
+				     BLOCK_OVERHEAD);
+	rest->size = block_size(block) - size - BLOCK_OVERHEAD;
+	block_set_size(block, size);
+
+	block_mark_free(rest);
+	insert_free_block(rest);
+}
+
+static int init_heap(struct device *unused)
+{
+	struct tlsf_block *block, *sentinel;
+
+	ARG_UNUSED(unused);
+
+	/*
+	 * The heap starts with a single free block spanning the whole buffer,
+	 * except for the end which holds a zero-sized, used sentinel block,
+	 * so that the last block never merges past the end.
+	 */
+	block = (struct tlsf_block *)heap_mem;
+	block->size = ALIGN_DOWN(HEAP_SIZE - BLOCK_PAYLOAD_OFFSET -
+				 sizeof(struct tlsf_block) + BLOCK_OVERHEAD);
+
+	sentinel = block_next(block);
+	sentinel->size = 0;
+
+	block_mark_free(block);
+	insert_free_block(block);
+
+	return 0;
+}
+
+SYS_INIT(init_heap, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+void *k_malloc(size_t size)
+{
+	struct tlsf_block *block;
+	unsigned int key;
+	int fl, sl;
+
+	if (size > BLOCK_SIZE_MAX) {
+		return NULL;
+	}
+
+	size = ALIGN_UP(max(size, BLOCK_SIZE_MIN));
+	mapping_search(size, &fl, &sl);
+
+	key = irq_lock();
+
+	block = search_suitable_block(&fl, &sl);
+	if (!block) {
+		irq_unlock(key);
+		return NULL;
+	}
+
+	remove_free_block(block, fl, sl);
+	block_trim(block, size);
+	block_mark_used(block);
+
+	heap.used_bytes += block_size(block) + BLOCK_OVERHEAD;
+	if (heap.used_bytes > heap.max_used_bytes) {
+		heap.max_used_bytes = heap.used_bytes;
+	}
+
+	irq_unlock(key);
+
+	return block_to_ptr(block);
+}
+
+void k_free(void *ptr)
+{
+	struct tlsf_block *block, *next;
+	unsigned int key;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	block = block_from_ptr(ptr);
+
+	key = irq_lock();
+
+	__ASSERT(!block_is_free(block), "double free of %p\n", ptr);
+
+	heap.used_bytes -= block_size(block) + BLOCK_OVERHEAD;
+
+	if (block_is_prev_free(block)) {
+		struct tlsf_block *prev = block->prev_phys;
+
+		unlink_free_block(prev);
+		block_absorb(prev, block);
+		block = prev;
+	}
+
+	next = block_next(block);
+	if (block_is_free(next)) {
+		unlink_free_block(next);
+		block_absorb(block, next);
+	}
+
+	block_mark_free(block);
+	insert_free_block(block);
+
+	irq_unlock(key);
+}
+
+void k_malloc_stats_get(struct k_malloc_stats *stats)
+{
+	unsigned int key = irq_lock();
+	struct tlsf_block *block;
+	int fl, sl;
+
+	stats->used_bytes = heap.used_bytes;
+	stats->max_used_bytes = heap.max_used_bytes;
+	stats->free_bytes = heap.free_bytes;
+	stats->largest_free_block = 0;
+
+	/* the largest free block is in the last non-empty list */
+	if (heap.fl_bitmap) {
+		fl = find_msb_set(heap.fl_bitmap) - 1;
+		sl = find_msb_set(heap.sl_bitmap[fl]) - 1;
+
+		for (block = heap.blocks[fl][sl]; block;
+		     block = block->next_free) {
+			stats->largest_free_block =
+				max(stats->largest_free_block,
+				    block_size(block) + BLOCK_OVERHEAD);
+		}
+	}
+
+	irq_unlock(key);
+}
@@ -46,11 +46,30 @@ static void work_q_main(void *work_q_ptr, void *p2, void *p3)
 void k_work_q_start(struct k_work_q *work_q, char *stack,
 		    size_t stack_size, int prio)
 {
+	k_work_q_pool_start(work_q, stack, stack_size, 1, prio);
+}
+
+void k_work_q_pool_start(struct k_work_q *work_q, char *stacks,
+			 size_t stack_size, int num_threads, int prio)
+{
+	int i;
+
+	__ASSERT(num_threads > 0, "a workqueue needs at least one thread");
+	__ASSERT(num_threads == 1 || !(stack_size & (STACK_ALIGN - 1)),
+		 "stack size %zu leaves the stacks unaligned", stack_size);
+
 	k_fifo_init(&work_q->fifo);
 
-	k_thread_spawn(stack, stack_size,
-		       work_q_main, work_q, 0, 0,
-		       prio, 0, 0);
+	/*
+	 * All the threads wait on the workqueue's fifo, which hands each
+	 * submitted work item to the thread that has been idle the longest,
+	 * or queues it for the first thread that becomes idle.
+	 */
+	for (i = 0; i < num_threads; i++) {
+		k_thread_spawn(stacks + i * stack_size, stack_size,
+			       work_q_main, work_q, 0, 0,
+			       prio, 0, 0);
+	}
 }
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
@@ -113,6 +132,11 @@ done:
 	return err;
 }
 
+void k_delayed_work_slack_set(struct k_delayed_work *work, s32_t slack)
+{
+	_set_timeout_slack(&work->timeout, slack);
+}
+
 int k_delayed_work_cancel(struct k_delayed_work *work)
 {
 	int key = irq_lock();
@@ -7,6 +7,7 @@
  */
 
 #include <string.h>
+#include <stdint.h>
 
 /**
  *
@@ -191,6 +192,204 @@ int memcmp(const void *m1, const void *m2, size_t n)
 	return *c1 - *c2;
 }
 
+/*
+ * Word-at-a-time helpers for memmove(), memcpy() and memset()
+ *
+ * Bulk transfers are done one aligned destination word at a time. When the
+ * source has a different alignment, each destination word is merged from
+ * two aligned source words, which never reads outside the aligned words
+ * holding the source bytes. Buffers shorter than MEM_SMALL are handled one
+ * byte at a time, which is cheaper than aligning them.
+ */
+
+typedef unsigned int __attribute__((__may_alias__)) mem_word_t;
+
+#define MEM_WORD_SIZE sizeof(mem_word_t)
+#define MEM_WORD_MASK (MEM_WORD_SIZE - 1)
+#define MEM_WORD_BITS (MEM_WORD_SIZE * 8)
+#define MEM_SMALL (4 * MEM_WORD_SIZE)
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define MEM_MERGE(lo, hi, shift) \
+	(((lo) << (shift)) | ((hi) >> (MEM_WORD_BITS - (shift))))
+#else
+#define MEM_MERGE(lo, hi, shift) \
+	(((lo) >> (shift)) | ((hi) << (MEM_WORD_BITS - (shift))))
+#endif
+
+/* copy n words forward, between word-aligned buffers */
+static inline void copy_words(mem_word_t *d, const mem_word_t *s, size_t n)
+{
+#if defined(CONFIG_X86)
+	__asm__ volatile ("rep movsl"
+			  : "+D" (d), "+S" (s), "+c" (n)
+			  :
+			  : "memory");
+#else
+#if defined(CONFIG_ARMV7_M)
+	size_t blocks = n / 4;
+
+	if (blocks) {
+		__asm__ volatile ("1: ldmia %1!, {r3-r6}\n\t"
+				  "stmia %0!, {r3-r6}\n\t"
+				  "subs %2, %2, #1\n\t"
+				  "bne 1b"
+				  : "+r" (d), "+r" (s), "+r" (blocks)
+				  :
+				  : "r3", "r4", "r5", "r6", "cc", "memory");
+	}
+#else
+	for (; n >= 4; n -= 4, d += 4, s += 4) {
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = s[2];
+		d[3] = s[3];
+	}
+#endif
+	for (n &= 3; n > 0; n--) {
+		*(d++) = *(s++);
+	}
+#endif
+}
+
+/* copy n words backward, ending at word-aligned buffer ends */
+static inline void copy_words_backward(mem_word_t *d, const mem_word_t *s,
+				       size_t n)
+{
+	for (; n >= 4; n -= 4) {
+		d -= 4;
+		s -= 4;
+		d[3] = s[3];
+		d[2] = s[2];
+		d[1] = s[1];
+		d[0] = s[0];
+	}
+
+	while (n-- > 0) {
+		*(--d) = *(--s);
+	}
+}
+
+/*
+ * copy n words forward to a word-aligned destination, from a source which
+ * is not word aligned
+ */
+static void copy_shifted(mem_word_t *d, const unsigned char *s, size_t n)
+{
+	unsigned int shift = ((uintptr_t)s & MEM_WORD_MASK) * 8;
+	const mem_word_t *s_word = (const mem_word_t *)((uintptr_t)s &
+							~MEM_WORD_MASK);
+	mem_word_t lo = *(s_word++), hi;
+
+	for (; n >= 2; n -= 2) {
+		hi = *(s_word++);
+		*(d++) = MEM_MERGE(lo, hi, shift);
+		lo = *(s_word++);
+		*(d++) = MEM_MERGE(hi, lo, shift);
+	}
+
+	if (n) {
+		hi = *s_word;
+		*d = MEM_MERGE(lo, hi, shift);
+	}
+}
+
+/*
+ * copy n words backward to a word-aligned destination end, from a source
+ * end which is not word aligned
+ */
+static void copy_shifted_backward(mem_word_t *d, const unsigned char *s,
+				  size_t n)
+{
+	unsigned int shift = ((uintptr_t)s & MEM_WORD_MASK) * 8;
+	const mem_word_t *s_word = (const mem_word_t *)((uintptr_t)s &
+							~MEM_WORD_MASK);
+	mem_word_t hi = *s_word, lo;
+
+	for (; n >= 2; n -= 2) {
+		lo = *(--s_word);
+		*(--d) = MEM_MERGE(lo, hi, shift);
+		hi = *(--s_word);
+		*(--d) = MEM_MERGE(hi, lo, shift);
+	}
+
+	if (n) {
+		lo = *(--s_word);
+		*(--d) = MEM_MERGE(lo, hi, shift);
+	}
+}
+
+/* forward copy, also safe for overlapping buffers when d is before s */
+static void copy_forward(unsigned char *d, const unsigned char *s, size_t n)
+{
+	size_t words;
+
+	if (n >= MEM_SMALL) {
+		/* do byte-sized copying until the destination is aligned */
+
+		while ((uintptr_t)d & MEM_WORD_MASK) {
+			*(d++) = *(s++);
+			n--;
+		}
+
+		/* do word-sized copying as long as possible */
+
+		words = n / MEM_WORD_SIZE;
+		if ((uintptr_t)s & MEM_WORD_MASK) {
+			copy_shifted((mem_word_t *)d, s, words);
+		} else {
+			copy_words((mem_word_t *)d, (const mem_word_t *)s,
+				   words);
+		}
+
+		d += words * MEM_WORD_SIZE;
+		s += words * MEM_WORD_SIZE;
+		n &= MEM_WORD_MASK;
+	}
+
+	/* do byte-sized copying until finished */
+
+	while (n > 0) {
+		*(d++) = *(s++);
+		n--;
+	}
+}
+
+/* backward copy, safe for overlapping buffers when d is after s */
+static void copy_backward(unsigned char *d, const unsigned char *s, size_t n)
+{
+	size_t words;
+
+	/* work from the ends of the buffers */
+
+	d += n;
+	s += n;
+
+	if (n >= MEM_SMALL) {
+		while ((uintptr_t)d & MEM_WORD_MASK) {
+			*(--d) = *(--s);
+			n--;
+		}
+
+		words = n / MEM_WORD_SIZE;
+		if ((uintptr_t)s & MEM_WORD_MASK) {
+			copy_shifted_backward((mem_word_t *)d, s, words);
+		} else {
+			copy_words_backward((mem_word_t *)d,
+					    (const mem_word_t *)s, words);
+		}
+
+		d -= words * MEM_WORD_SIZE;
+		s -= words * MEM_WORD_SIZE;
+		n &= MEM_WORD_MASK;
+	}
+
+	while (n > 0) {
+		*(--d) = *(--s);
+		n--;
+	}
+}
+
 /**
  *
  * @brief Copy bytes in memory with overlapping areas
@@ -200,27 +399,17 @@ int memcmp(const void *m1, const void *m2, size_t n)
 
 void *memmove(void *d, const void *s, size_t n)
 {
-	char *dest = d;
-	const char *src  = s;
-
 	if ((size_t) (d - s) < n) {
 		/*
 		 * The <src> buffer overlaps with the start of the <dest> buffer.
 		 * Copy backwards to prevent the premature corruption of <src>.
 		 */
 
-		while (n > 0) {
-			n--;
-			dest[n] = src[n];
-		}
+		copy_backward(d, s, n);
 	} else {
 		/* It is safe to perform a forward-copy */
-		while (n > 0) {
-			*dest = *src;
-			dest++;
-			src++;
-			n--;
-		}
+
+		copy_forward(d, s, n);
 	}
 
 	return d;
@@ -235,43 +424,7 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
-
-	unsigned char *d_byte = (unsigned char *)d;
-	const unsigned char *s_byte = (const unsigned char *)s;
-
-	if ((((unsigned int)d ^ (unsigned int)s_byte) & 0x3) == 0) {
-
-		/* do byte-sized copying until word-aligned or finished */
-
-		while (((unsigned int)d_byte) & 0x3) {
-			if (n == 0) {
-				return d;
-			}
-			*(d_byte++) = *(s_byte++);
-			n--;
-		};
-
-		/* do word-sized copying as long as possible */
-
-		unsigned int *d_word = (unsigned int *)d_byte;
-		const unsigned int *s_word = (const unsigned int *)s_byte;
-
-		while (n >= sizeof(unsigned int)) {
-			*(d_word++) = *(s_word++);
-			n -= sizeof(unsigned int);
-		}
-
-		d_byte = (unsigned char *)d_word;
-		s_byte = (unsigned char *)s_word;
-	}
-
-	/* do byte-sized copying until finished */
-
-	while (n > 0) {
-		*(d_byte++) = *(s_byte++);
-		n--;
-	}
+	copy_forward(d, s, n);
 
 	return d;
 }
@@ -285,36 +438,50 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 
 void *memset(void *buf, int c, size_t n)
 {
-	/* do byte-sized initialization until word-aligned or finished */
-
 	unsigned char *d_byte = (unsigned char *)buf;
 	unsigned char c_byte = (unsigned char)c;
 
-	while (((unsigned int)d_byte) & 0x3) {
-		if (n == 0) {
-			return buf;
-		}
-		*(d_byte++) = c_byte;
-		n--;
-	};
+	if (n >= MEM_SMALL) {
+		/* do byte-sized initialization until word-aligned */
 
-	/* do word-sized initialization as long as possible */
-
-	unsigned int *d_word = (unsigned int *)d_byte;
-	unsigned int c_word = (unsigned int)(unsigned char)c;
+		while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
+			*(d_byte++) = c_byte;
+			n--;
+		}
 
-	c_word |= c_word << 8;
-	c_word |= c_word << 16;
+		/* do word-sized initialization as long as possible */
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		mem_word_t c_word = (mem_word_t)c_byte;
+		size_t words = n / MEM_WORD_SIZE;
+
+		c_word |= c_word << 8;
+		c_word |= c_word << 16;
+
+		d_byte += words * MEM_WORD_SIZE;
+		n &= MEM_WORD_MASK;
+
+#if defined(CONFIG_X86)
+		__asm__ volatile ("rep stosl"
+				  : "+D" (d_word), "+c" (words)
+				  : "a" (c_word)
+				  : "memory");
+#else
+		for (; words >= 4; words -= 4, d_word += 4) {
+			d_word[0] = c_word;
+			d_word[1] = c_word;
+			d_word[2] = c_word;
+			d_word[3] = c_word;
+		}
 
-	while (n >= sizeof(unsigned int)) {
-		*(d_word++) = c_word;
-		n -= sizeof(unsigned int);
+		while (words-- > 0) {
+			*(d_word++) = c_word;
+		}
+#endif
 	}
 
 	/* do byte-sized initialization until finished */
 
-	d_byte = (unsigned char *)d_word;
-
 	while (n > 0) {
 		*(d_byte++) = c_byte;
 		n--;
@@ -0,0 +1,139 @@
+/* byte_ring.c: Single producer, single consumer byte ring API */
+
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <misc/byte_ring.h>
+#include <string.h>
+
+u32_t sys_byte_ring_put_claim(struct byte_ring *ring, u8_t **data,
+			      u32_t size)
+{
+	u32_t head = ring->head;
+	u32_t offset = head & ring->mask;
+	u32_t space;
+
+	space = ring->mask + 1 - (head - _byte_ring_index_get(&ring->tail));
+
+	*data = ring->buf + offset;
+
+	return min(size, min(space, ring->mask + 1 - offset));
+}
+
+void sys_byte_ring_put_commit(struct byte_ring *ring, u32_t size)
+{
+	u32_t head = ring->head;
+
+	__ASSERT(size <= ring->mask + 1 -
+		 (head - _byte_ring_index_get(&ring->tail)),
+		 "put more than the free space");
+
+	_byte_ring_index_set(&ring->head, head + size);
+
+#ifdef CONFIG_POLL
+	/*
+	 * The full barrier orders the store of the head before the load of
+	 * the tail, against the opposite order in
+	 * sys_byte_ring_poll_prepare(): either the consumer sees the new
+	 * head, or the producer sees that the ring was empty and raises the
+	 * signal after the consumer reset it.
+	 */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	if (size && __atomic_load_n(&ring->tail, __ATOMIC_RELAXED) == head) {
+		k_poll_signal(&ring->signal, 0);
+	}
+#endif
+}
+
+u32_t sys_byte_ring_get_claim(struct byte_ring *ring, u8_t **data,
+			      u32_t size)
+{
+	u32_t tail = ring->tail;
+	u32_t offset = tail & ring->mask;
+	u32_t used;
+
+	used = _byte_ring_index_get(&ring->head) - tail;
+
+	*data = ring->buf + offset;
+
+	return min(size, min(used, ring->mask + 1 - offset));
+}
+
+void sys_byte_ring_get_commit(struct byte_ring *ring, u32_t size)
+{
+	u32_t tail = ring->tail;
+
+	__ASSERT(size <= _byte_ring_index_get(&ring->head) - tail,
+		 "got more than the data");
+
+	_byte_ring_index_set(&ring->tail, tail + size);
+}
+
+u32_t sys_byte_ring_put(struct byte_ring *ring, const u8_t *data,
+			u32_t size)
+{
+	u32_t head = ring->head;
+	u32_t offset = head & ring->mask;
+	u32_t space, first;
+
+	space = ring->mask + 1 - (head - _byte_ring_index_get(&ring->tail));
+	size = min(size, space);
+
+	/* the bytes may wrap around the end of the data area */
+	first = min(size, ring->mask + 1 - offset);
+	memcpy(ring->buf + offset, data, first);
+	memcpy(ring->buf, data + first, size - first);
+
+	sys_byte_ring_put_commit(ring, size);
+
+	return size;
+}
+
+u32_t sys_byte_ring_get(struct byte_ring *ring, u8_t *data, u32_t size)
+{
+	u32_t tail = ring->tail;
+	u32_t offset = tail & ring->mask;
+	u32_t used, first;
+
+	used = _byte_ring_index_get(&ring->head) - tail;
+	size = min(size, used);
+
+	/* the bytes may wrap around the end of the data area */
+	first = min(size, ring->mask + 1 - offset);
+	memcpy(data, ring->buf + offset, first);
+	memcpy(data + first, ring->buf, size - first);
+
+	_byte_ring_index_set(&ring->tail, tail + size);
+
+	return size;
+}
+
+#ifdef CONFIG_POLL
+int sys_byte_ring_poll_prepare(struct byte_ring *ring)
+{
+	ring->signal.signaled = 0;
+
+	/* see sys_byte_ring_put_commit() */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	return __atomic_load_n(&ring->head, __ATOMIC_RELAXED) == ring->tail;
+}
+
+int sys_byte_ring_wait(struct byte_ring *ring, s32_t timeout)
+{
+	struct k_poll_event event;
+
+	if (!sys_byte_ring_poll_prepare(ring)) {
+		return 0;
+	}
+
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &ring->signal);
+
+	return k_poll(&event, 1, timeout);
+}
+#endif /* CONFIG_POLL */
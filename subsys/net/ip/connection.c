@@ -50,272 +50,137 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
  */
 #define NET_CONN_HDR(pkt) ((struct net_udp_hdr *)(net_pkt_udp_data(pkt)))
 
-#if defined(CONFIG_NET_CONN_CACHE)
-
-/* Cache the connection so that we do not have to go
- * through the full list of connections when receiving
- * a network packet. The cache contains an index to
- * corresponding entry in conns array.
- *
- * Hash value is constructed like this:
+/* Connections are looked up in hash tables of CONFIG_NET_MAX_CONN buckets,
+ * so that the expected cost of demultiplexing a packet does not depend on
+ * the number of connections:
  *
- *   bit      description
- *   0  - 3   bits from remote port
- *   4  - 7   bits from local port
- *   8  - 18  bits from remote address
- *   19 - 29  bits from local address
- *   30       family
- *   31       protocol
+ *   - connected end points, with a specific remote address, a remote port
+ *     and a local port, are hashed on the remote address and both ports,
+ *     and found with an exact match of the packet addresses and ports
+ *   - listeners, with a local port but no specific remote end point, are
+ *     hashed on the local port, and the most specific one matching the
+ *     packet is selected by rank
+ *   - the few handlers without a local port match any packet of their
+ *     protocol and are kept in a single list checked with the listeners
  */
-struct conn_hash {
-	u32_t value;
-	s32_t idx;
-};
-
-struct conn_hash_neg {
-	u32_t value;
-};
+#define NET_CONN_BUCKETS CONFIG_NET_MAX_CONN
 
-/** Connection cache */
-static struct conn_hash conn_cache[CONFIG_NET_MAX_CONN];
-
-/** Negative cache, we definitely do not have a connection
- * to these hosts.
- */
-static struct conn_hash_neg conn_cache_neg[CONFIG_NET_MAX_CONN];
-
-#define TAKE_BIT(val, bit, max, used)				\
-	(((val & BIT(bit)) >> bit) << (max - used))
-
-static inline u8_t ports_to_hash(u16_t remote_port,
-				    u16_t local_port)
-{
-	/* Note that we do not convert port value to network byte order */
-	return (remote_port & BIT(0)) |
-		((remote_port & BIT(4)) >> 3) |
-		((remote_port & BIT(8)) >> 6) |
-		((remote_port & BIT(15)) >> 12) |
-		(((local_port & BIT(0)) |
-		  ((local_port & BIT(4)) >> 3) |
-		  ((local_port & BIT(8)) >> 6) |
-		  ((local_port & BIT(15)) >> 12)) << 4);
-}
+static sys_slist_t conn_exact[NET_CONN_BUCKETS];
+static sys_slist_t conn_listen[NET_CONN_BUCKETS];
+static sys_slist_t conn_any;
 
-static inline u16_t ipv6_to_hash(struct in6_addr *addr)
+static inline u32_t hash_mix(u32_t hash, u32_t value)
 {
-	/* There is 11 bits available for IPv6 address */
-	/* Use more bits from the lower part of address space */
-	return
-		/* Take 3 bits from higher values */
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[0]), 31, 11, 1) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[0]), 15, 11, 2) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[0]), 7, 11, 3) |
-
-		/* Take 2 bits from higher middle values */
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[1]), 31, 11, 4) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[1]), 15, 11, 5) |
-
-		/* Take 2 bits from lower middle values */
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[2]), 31, 11, 6) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[2]), 15, 11, 7) |
-
-		/* Take 4 bits from lower values */
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[3]), 31, 11, 8) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[3]), 15, 11, 9) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[3]), 7, 11, 10) |
-		TAKE_BIT(UNALIGNED_GET(&addr->s6_addr32[3]), 0, 11, 11);
-}
+	/* Multiplicative hashing by the golden ratio */
+	hash = (hash ^ value) * 0x9e3779b1;
 
-static inline u16_t ipv4_to_hash(struct in_addr *addr)
-{
-	/* There is 11 bits available for IPv4 address */
-	/* Use more bits from the lower part of address space */
-	return
-		TAKE_BIT(addr->s_addr[0], 31, 11, 1) |
-		TAKE_BIT(addr->s_addr[0], 27, 11, 2) |
-		TAKE_BIT(addr->s_addr[0], 21, 11, 3) |
-		TAKE_BIT(addr->s_addr[0], 17, 11, 4) |
-		TAKE_BIT(addr->s_addr[0], 14, 11, 5) |
-		TAKE_BIT(addr->s_addr[0], 11, 11, 6) |
-		TAKE_BIT(addr->s_addr[0], 8, 11, 7) |
-		TAKE_BIT(addr->s_addr[0], 5, 11, 8) |
-		TAKE_BIT(addr->s_addr[0], 3, 11, 9) |
-		TAKE_BIT(addr->s_addr[0], 2, 11, 10) |
-		TAKE_BIT(addr->s_addr[0], 0, 11, 11);
+	return hash ^ (hash >> 15);
 }
 
-/* Return either the first free position in the cache (idx < 0) or
- * the existing cached position (idx >= 0)
- */
-static s32_t check_hash(enum net_ip_protocol proto,
-			  sa_family_t family,
-			  void *remote_addr,
-			  void *local_addr,
-			  u16_t remote_port,
-			  u16_t local_port,
-			  u32_t *cache_value)
+/* Ports are hashed in network byte order, as found in the packets */
+static u32_t hash_exact(u8_t proto, sa_family_t family,
+			const void *remote_addr,
+			u16_t remote_port, u16_t local_port)
 {
-	int i, free_pos = -1;
-	u32_t value = 0;
-
-	value = ports_to_hash(remote_port, local_port);
-
-#if defined(CONFIG_NET_UDP)
-	if (proto == IPPROTO_UDP) {
-		value |= BIT(31);
-	}
-#endif
-
-#if defined(CONFIG_NET_TCP)
-	if (proto == IPPROTO_TCP) {
-		value &= ~BIT(31);
-	}
-#endif
+	u32_t hash = hash_mix(proto, (remote_port << 16) | local_port);
 
 #if defined(CONFIG_NET_IPV6)
 	if (family == AF_INET6) {
-		value |= BIT(30);
-		value |= ipv6_to_hash((struct in6_addr *)remote_addr) << 8;
-		value |= ipv6_to_hash((struct in6_addr *)local_addr) << 19;
+		const struct in6_addr *addr6 = remote_addr;
+		int i;
+
+		for (i = 0; i < 4; i++) {
+			hash = hash_mix(hash,
+					UNALIGNED_GET(&addr6->s6_addr32[i]));
+		}
 	}
 #endif
 
 #if defined(CONFIG_NET_IPV4)
 	if (family == AF_INET) {
-		value &= ~BIT(30);
-		value |= ipv4_to_hash((struct in_addr *)remote_addr) << 8;
-		value |= ipv4_to_hash((struct in_addr *)local_addr) << 19;
-	}
-#endif
-
-	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-		if (conn_cache[i].value == value) {
-			return i;
-		}
+		const struct in_addr *addr4 = remote_addr;
 
-		if (conn_cache[i].idx < 0 && free_pos < 0) {
-			free_pos = i;
-		}
+		hash = hash_mix(hash, UNALIGNED_GET(&addr4->s_addr[0]));
 	}
+#endif
 
-	if (free_pos >= 0) {
-		conn_cache[free_pos].value = value;
-		return free_pos;
-	}
-
-	*cache_value = value;
-
-	return -ENOENT;
+	return hash % NET_CONN_BUCKETS;
 }
 
-static inline s32_t get_conn(enum net_ip_protocol proto,
-			       sa_family_t family,
-			       struct net_pkt *pkt,
-			       u32_t *cache_value)
+static inline u32_t hash_listen(u8_t proto, u16_t local_port)
 {
-#if defined(CONFIG_NET_IPV4)
-	if (family == AF_INET) {
-		return check_hash(proto, family,
-				  &NET_IPV4_HDR(pkt)->src,
-				  &NET_IPV4_HDR(pkt)->dst,
-				  NET_UDP_HDR(pkt)->src_port,
-				  NET_UDP_HDR(pkt)->dst_port,
-				  cache_value);
-	}
-#endif
-
-#if defined(CONFIG_NET_IPV6)
-	if (family == AF_INET6) {
-		return check_hash(proto, family,
-				  &NET_IPV6_HDR(pkt)->src,
-				  &NET_IPV6_HDR(pkt)->dst,
-				  NET_UDP_HDR(pkt)->src_port,
-				  NET_UDP_HDR(pkt)->dst_port,
-				  cache_value);
-	}
-#endif
+	return hash_mix(proto, local_port) % NET_CONN_BUCKETS;
+}
 
-	return -1;
+static inline bool conn_is_connected(struct net_conn *conn)
+{
+	return (conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+		(conn->rank & NET_RANK_REMOTE_SPEC_ADDR) &&
+		(conn->rank & NET_RANK_REMOTE_PORT) &&
+		(conn->rank & NET_RANK_LOCAL_PORT);
 }
 
-static inline void cache_add_neg(u32_t cache_value)
+/* Return the list holding a registered connection */
+static sys_slist_t *conn_list(struct net_conn *conn)
 {
-	int i;
+	u16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	u16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	const void *remote_addr = NULL;
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN && cache_value > 0; i++) {
-		if (conn_cache_neg[i].value) {
-			continue;
+	if (conn_is_connected(conn)) {
+#if defined(CONFIG_NET_IPV6)
+		if (conn->remote_addr.family == AF_INET6) {
+			remote_addr = &net_sin6(&conn->remote_addr)->sin6_addr;
 		}
+#endif
 
-		NET_DBG("Add to neg cache value 0x%x", cache_value);
+#if defined(CONFIG_NET_IPV4)
+		if (conn->remote_addr.family == AF_INET) {
+			remote_addr = &net_sin(&conn->remote_addr)->sin_addr;
+		}
+#endif
 
-		conn_cache_neg[i].value = cache_value;
-		break;
+		return &conn_exact[hash_exact(conn->proto,
+					      conn->remote_addr.family,
+					      remote_addr, remote_port,
+					      local_port)];
 	}
-}
-
-static inline bool cache_check_neg(u32_t cache_value)
-{
-	int i;
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN && cache_value > 0; i++) {
-		if (conn_cache_neg[i].value == cache_value) {
-			NET_DBG("Cache neg [%d] value 0x%x found",
-				i, cache_value);
-			return true;
-		}
+	if (conn->rank & NET_RANK_LOCAL_PORT) {
+		return &conn_listen[hash_listen(conn->proto, local_port)];
 	}
 
-	return false;
+	return &conn_any;
 }
 
-static void cache_clear(void)
+/* Return the list of connected end points a packet may belong to */
+static sys_slist_t *pkt_exact_list(enum net_ip_protocol proto,
+				   struct net_pkt *pkt)
 {
-	int i;
+	const void *remote_addr = NULL;
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-		conn_cache[i].idx = -1;
-		conn_cache_neg[i].value = 0;
+#if defined(CONFIG_NET_IPV6)
+	if (net_pkt_family(pkt) == AF_INET6) {
+		remote_addr = &NET_IPV6_HDR(pkt)->src;
 	}
-}
+#endif
 
-static inline enum net_verdict cache_check(enum net_ip_protocol proto,
-					   struct net_pkt *pkt,
-					   u32_t *cache_value,
-					   s32_t *pos)
-{
-	*pos = get_conn(proto, net_pkt_family(pkt), pkt, cache_value);
-	if (*pos >= 0) {
-		if (conn_cache[*pos].idx >= 0) {
-			/* Connection is in the cache */
-			struct net_conn *conn;
-
-			conn = &conns[conn_cache[*pos].idx];
-
-			NET_DBG("Cache %s listener for pkt %p src port %u "
-				"dst port %u family %d cache[%d] 0x%x",
-				net_proto2str(proto), pkt,
-				ntohs(NET_CONN_HDR(pkt)->src_port),
-				ntohs(NET_CONN_HDR(pkt)->dst_port),
-				net_pkt_family(pkt), *pos,
-				conn_cache[*pos].value);
-
-			return conn->cb(conn, pkt, conn->user_data);
-		}
-	} else if (*cache_value > 0) {
-		if (cache_check_neg(*cache_value)) {
-			NET_DBG("Drop by cache");
-			return NET_DROP;
-		}
+#if defined(CONFIG_NET_IPV4)
+	if (net_pkt_family(pkt) == AF_INET) {
+		remote_addr = &NET_IPV4_HDR(pkt)->src;
 	}
+#endif
 
-	return NET_CONTINUE;
+	return &conn_exact[hash_exact(proto, net_pkt_family(pkt), remote_addr,
+				      NET_CONN_HDR(pkt)->src_port,
+				      NET_CONN_HDR(pkt)->dst_port)];
+}
+
+static inline sys_slist_t *pkt_listen_list(enum net_ip_protocol proto,
+					   struct net_pkt *pkt)
+{
+	return &conn_listen[hash_listen(proto, NET_CONN_HDR(pkt)->dst_port)];
 }
-#else
-#define cache_clear(...)
-#define cache_add_neg(...)
-#define cache_check(...) NET_CONTINUE
-#endif /* CONFIG_NET_CONN_CACHE */
 
 int net_conn_unregister(struct net_conn_handle *handle)
 {
@@ -332,6 +197,8 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("[%zu] connection handler %p removed",
 		(conn - conns) / sizeof(*conn), conn);
 
+	sys_slist_find_and_remove(conn_list(conn), &conn->node);
+
 	conn->flags = 0;
 
 	return 0;
@@ -429,6 +296,12 @@ int net_conn_register(enum net_ip_protocol proto,
 			continue;
 		}
 
+		/* The ports are read back from the addresses, do not
+		 * leave the ones of a previous connection there.
+		 */
+		memset(&conns[i].remote_addr, 0, sizeof(struct sockaddr));
+		memset(&conns[i].local_addr, 0, sizeof(struct sockaddr));
+
 		if (remote_addr) {
 			if (remote_addr->family != AF_INET &&
 			    remote_addr->family != AF_INET6) {
@@ -525,8 +398,7 @@ int net_conn_register(enum net_ip_protocol proto,
 		conns[i].rank = rank;
 		conns[i].proto = proto;
 
-		/* Cache needs to be cleared if new entries are added. */
-		cache_clear();
+		sys_slist_append(conn_list(&conns[i]), &conns[i].node);
 
 #if defined(CONFIG_NET_DEBUG_CONN)
 		do {
@@ -626,110 +498,119 @@ static inline void send_icmp_error(struct net_pkt *pkt)
 	}
 }
 
-enum net_verdict net_conn_input(enum net_ip_protocol proto, struct net_pkt *pkt)
+static bool conn_match(struct net_conn *conn, enum net_ip_protocol proto,
+		       struct net_pkt *pkt)
 {
-	int i, best_match = -1;
-	s16_t best_rank = -1;
-
-#if defined(CONFIG_NET_CONN_CACHE)
-	enum net_verdict verdict;
-	u32_t cache_value = 0;
-	s32_t pos;
-
-	verdict = cache_check(proto, pkt, &cache_value, &pos);
-	if (verdict != NET_CONTINUE) {
-		return verdict;
+	if (!(conn->flags & NET_CONN_IN_USE)) {
+		return false;
 	}
-#endif
 
-	if (IS_ENABLED(CONFIG_NET_DEBUG_CONN)) {
-		u16_t chksum;
+	if (conn->proto != proto) {
+		return false;
+	}
 
-		if (proto == IPPROTO_TCP) {
-			chksum = NET_TCP_HDR(pkt)->chksum;
-		} else {
-			chksum = NET_UDP_HDR(pkt)->chksum;
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port !=
+		    NET_CONN_HDR(pkt)->src_port) {
+			return false;
 		}
-
-		NET_DBG("Check %s listener for pkt %p src port %u dst port %u "
-			"family %d chksum 0x%04x", net_proto2str(proto), pkt,
-			ntohs(NET_CONN_HDR(pkt)->src_port),
-			ntohs(NET_CONN_HDR(pkt)->dst_port),
-			net_pkt_family(pkt), ntohs(chksum));
 	}
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-		if (!(conns[i].flags & NET_CONN_IN_USE)) {
-			continue;
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port !=
+		    NET_CONN_HDR(pkt)->dst_port) {
+			return false;
 		}
+	}
 
-		if (conns[i].proto != proto) {
-			continue;
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!check_addr(pkt, &conn->remote_addr, true)) {
+			return false;
 		}
+	}
 
-		if (net_sin(&conns[i].remote_addr)->sin_port) {
-			if (net_sin(&conns[i].remote_addr)->sin_port !=
-			    NET_CONN_HDR(pkt)->src_port) {
-				continue;
-			}
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!check_addr(pkt, &conn->local_addr, false)) {
+			return false;
 		}
+	}
 
-		if (net_sin(&conns[i].local_addr)->sin_port) {
-			if (net_sin(&conns[i].local_addr)->sin_port !=
-			    NET_CONN_HDR(pkt)->dst_port) {
-				continue;
-			}
-		}
+	return true;
+}
 
-		if (conns[i].flags & NET_CONN_REMOTE_ADDR_SET) {
-			if (!check_addr(pkt, &conns[i].remote_addr, true)) {
-				continue;
-			}
-		}
+/* Return the best match for the packet among the connections of a list
+ * and the best match found so far.
+ */
+static struct net_conn *find_best_match(sys_slist_t *list,
+					enum net_ip_protocol proto,
+					struct net_pkt *pkt,
+					struct net_conn *best_match)
+{
+	struct net_conn *conn;
 
-		if (conns[i].flags & NET_CONN_LOCAL_ADDR_SET) {
-			if (!check_addr(pkt, &conns[i].local_addr, false)) {
-				continue;
-			}
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, node) {
+		if (!conn_match(conn, proto, pkt)) {
+			continue;
 		}
 
 		/* If we have an existing best_match, and that one
 		 * specifies a remote port, then we've matched to a
 		 * LISTENING connection that should not override.
 		 */
-		if (best_match >= 0 &&
-		    net_sin(&conns[best_match].remote_addr)->sin_port) {
+		if (best_match &&
+		    net_sin(&best_match->remote_addr)->sin_port) {
 			continue;
 		}
 
-		if (best_rank < conns[i].rank) {
-			best_rank = conns[i].rank;
-			best_match = i;
+		if (!best_match || best_match->rank < conn->rank) {
+			best_match = conn;
 		}
 	}
 
-	if (best_match >= 0) {
-#if defined(CONFIG_NET_CONN_CACHE)
-		NET_DBG("[%d] match found cb %p ud %p rank 0x%02x cache 0x%x",
-			best_match,
-			conns[best_match].cb,
-			conns[best_match].user_data,
-			conns[best_match].rank,
-			pos < 0 ? 0 : conn_cache[pos].value);
-
-		if (pos >= 0) {
-			conn_cache[pos].idx = best_match;
+	return best_match;
+}
+
+enum net_verdict net_conn_input(enum net_ip_protocol proto, struct net_pkt *pkt)
+{
+	struct net_conn *best_match;
+
+	if (IS_ENABLED(CONFIG_NET_DEBUG_CONN)) {
+		u16_t chksum;
+
+		if (proto == IPPROTO_TCP) {
+			chksum = NET_TCP_HDR(pkt)->chksum;
+		} else {
+			chksum = NET_UDP_HDR(pkt)->chksum;
 		}
-#else
+
+		NET_DBG("Check %s listener for pkt %p src port %u dst port %u "
+			"family %d chksum 0x%04x", net_proto2str(proto), pkt,
+			ntohs(NET_CONN_HDR(pkt)->src_port),
+			ntohs(NET_CONN_HDR(pkt)->dst_port),
+			net_pkt_family(pkt), ntohs(chksum));
+	}
+
+	/* A connected end point matching the packet addresses and ports
+	 * takes precedence over the listeners.
+	 */
+	best_match = find_best_match(pkt_exact_list(proto, pkt), proto, pkt,
+				     NULL);
+	if (!best_match) {
+		best_match = find_best_match(pkt_listen_list(proto, pkt),
+					     proto, pkt, NULL);
+		best_match = find_best_match(&conn_any, proto, pkt,
+					     best_match);
+	}
+
+	if (best_match) {
 		NET_DBG("[%d] match found cb %p ud %p rank 0x%02x",
-			best_match,
-			conns[best_match].cb,
-			conns[best_match].user_data,
-			conns[best_match].rank);
-#endif /* CONFIG_NET_CONN_CACHE */
-
-		if (conns[best_match].cb(&conns[best_match], pkt,
-			     conns[best_match].user_data) == NET_DROP) {
+			(int)(best_match - conns),
+			best_match->cb,
+			best_match->user_data,
+			best_match->rank);
+
+		if (best_match->cb(best_match, pkt,
+				   best_match->user_data) == NET_DROP) {
 			goto drop;
 		}
 
@@ -742,8 +623,6 @@ enum net_verdict net_conn_input(enum net_ip_protocol proto, struct net_pkt *pkt)
 
 	NET_DBG("No match found.");
 
-	cache_add_neg(cache_value);
-
 #if defined(CONFIG_NET_IPV6)
 	/* If the destination address is multicast address,
 	 * we do not send ICMP error as that makes no sense.
@@ -786,13 +665,12 @@ void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 
 void net_conn_init(void)
 {
-#if defined(CONFIG_NET_CONN_CACHE)
-	do {
-		int i;
+	int i;
 
-		for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-			conn_cache[i].idx = -1;
-		}
-	} while (0);
-#endif /* CONFIG_NET_CONN_CACHE */
+	for (i = 0; i < NET_CONN_BUCKETS; i++) {
+		sys_slist_init(&conn_exact[i]);
+		sys_slist_init(&conn_listen[i]);
+	}
+
+	sys_slist_init(&conn_any);
 }
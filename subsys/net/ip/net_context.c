@@ -735,7 +735,7 @@ static inline int send_syn_ack(struct net_context *context,
 }
 
 static inline int send_ack(struct net_context *context,
-			   struct sockaddr *remote)
+			   struct sockaddr *remote, bool force)
 {
 	struct net_pkt *pkt = NULL;
 	int ret;
@@ -743,7 +743,7 @@ static inline int send_ack(struct net_context *context,
 	/* Something (e.g. a data transmission under the user
 	 * callback) already sent the ACK, no need
 	 */
-	if (context->tcp->send_ack == context->tcp->sent_ack) {
+	if (!force && context->tcp->send_ack == context->tcp->sent_ack) {
 		return 0;
 	}
 
@@ -797,8 +797,11 @@ static int tcp_hdr_len(struct net_pkt *pkt)
 NET_CONN_CB(tcp_established)
 {
 	struct net_context *context = (struct net_context *)user_data;
+	struct net_tcp_options opts;
+	struct net_pkt *next;
 	enum net_verdict ret;
 	u8_t tcp_flags;
+	int order;
 
 	NET_ASSERT(context && context->tcp);
 
@@ -810,25 +813,68 @@ NET_CONN_CB(tcp_established)
 
 	net_tcp_print_recv_info("DATA", pkt, NET_TCP_HDR(pkt)->src_port);
 
+	set_appdata_values(pkt, IPPROTO_TCP);
+
+	if (net_tcp_parse_opts(pkt, &opts) < 0) {
+		NET_DBG("Invalid TCP options");
+		return NET_DROP;
+	}
+
+	/* Old duplicate segments are dropped, but ACKed so that the peer
+	 * can resynchronize. Sending an ACK changes the state when
+	 * closing, so only do it when established.
+	 */
+	if (!net_tcp_check_ts(context->tcp, pkt, &opts)) {
+		if (net_tcp_get_state(context->tcp) == NET_TCP_ESTABLISHED) {
+			send_ack(context, &conn->remote_addr, true);
+		}
+
+		return NET_DROP;
+	}
+
 	tcp_flags = NET_TCP_FLAGS(pkt);
 	if (tcp_flags & NET_TCP_ACK) {
-		net_tcp_ack_received(context,
-				     sys_get_be32(NET_TCP_HDR(pkt)->ack));
+		net_tcp_ack_received(context, pkt, &opts);
 	}
 
-	if (sys_get_be32(NET_TCP_HDR(pkt)->seq) - context->tcp->send_ack) {
-		/* Don't try to reorder packets.  If it doesn't
-		 * match the next segment exactly, drop and wait for
-		 * retransmit
+	order = net_tcp_check_seq(context->tcp, pkt);
+	if (order) {
+		/* Keep the data received after a hole until the hole is
+		 * filled, and ACK the data at once so that the duplicate
+		 * ACKs trigger a fast retransmit on the peer (RFC 5681,
+		 * section 4.2). Their SACK blocks tell which data the peer
+		 * does not need to send again.
 		 */
-		return NET_DROP;
+		ret = NET_DROP;
+
+		if (net_pkt_appdatalen(pkt) &&
+		    net_tcp_get_state(context->tcp) == NET_TCP_ESTABLISHED) {
+			if (order > 0 && !net_tcp_ooo_add(context->tcp, pkt)) {
+				ret = NET_OK;
+			}
+
+			send_ack(context, &conn->remote_addr, true);
+		}
+
+		return ret;
 	}
 
-	set_appdata_values(pkt, IPPROTO_TCP);
 	context->tcp->send_ack += net_pkt_appdatalen(pkt);
 
 	ret = packet_received(conn, pkt, context->tcp->recv_user_data);
 
+	/* The segment may fill the hole before segments received out of
+	 * order, deliver them as well.
+	 */
+	while ((next = net_tcp_ooo_get(context->tcp))) {
+		context->tcp->send_ack += net_pkt_appdatalen(next);
+
+		if (packet_received(conn, next,
+				    context->tcp->recv_user_data) == NET_DROP) {
+			net_pkt_unref(next);
+		}
+	}
+
 	if (tcp_flags & NET_TCP_FIN) {
 		/* Sending an ACK in the CLOSE_WAIT state will transition to
 		 * LAST_ACK state
@@ -847,7 +893,7 @@ NET_CONN_CB(tcp_established)
 		}
 	}
 
-	send_ack(context, &conn->remote_addr);
+	send_ack(context, &conn->remote_addr, false);
 
 	if (sys_slist_is_empty(&context->tcp->sent_list)
 	    && context->tcp->fin_rcvd
@@ -893,6 +939,8 @@ NET_CONN_CB(tcp_synack_received)
 		context->tcp->send_ack =
 			sys_get_be32(NET_TCP_HDR(pkt)->seq) + 1;
 		context->tcp->recv_max_ack = context->tcp->send_seq + 1;
+
+		net_tcp_syn_received(context->tcp, pkt);
 	}
 	/*
 	 * If we receive SYN, we send SYN-ACK and go to SYN_RCVD state.
@@ -968,7 +1016,7 @@ NET_CONN_CB(tcp_synack_received)
 		net_tcp_change_state(context->tcp, NET_TCP_ESTABLISHED);
 		net_context_set_state(context, NET_CONTEXT_CONNECTED);
 
-		send_ack(context, raddr);
+		send_ack(context, raddr, false);
 
 		k_sem_give(&context->tcp->connect_wait);
 
@@ -1284,6 +1332,8 @@ NET_CONN_CB(tcp_syn_rcvd)
 			sys_get_be32(NET_TCP_HDR(pkt)->seq) + 1;
 		context->tcp->recv_max_ack = context->tcp->send_seq + 1;
 
+		net_tcp_syn_received(tcp, pkt);
+
 		pkt_get_sockaddr(net_context_get_family(context),
 				 pkt, &pkt_src_addr);
 		send_syn_ack(context, &pkt_src_addr, remote);
@@ -38,6 +38,20 @@ extern u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto);
 extern u16_t net_calc_chksum_ipv4(struct net_pkt *pkt);
 #endif /* CONFIG_NET_IPV4 */
 
+/**
+ * @brief Update a checksum for a change of the data it covers (RFC 1624).
+ *
+ * @param chksum Checksum as stored in the header.
+ * @param old_data Data before the change.
+ * @param new_data Data after the change.
+ * @param len Length of the data, starting at an even offset of the
+ * checksummed data.
+ *
+ * @return Checksum of the changed data, to be stored in the header.
+ */
+extern u16_t net_chksum_update(u16_t chksum, const void *old_data,
+			       const void *new_data, u16_t len);
+
 static inline u16_t net_calc_chksum_icmpv6(struct net_pkt *pkt)
 {
 	return net_calc_chksum(pkt, IPPROTO_ICMPV6);
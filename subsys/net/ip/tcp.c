@@ -42,7 +42,39 @@
 #define NET_MAX_TCP_CONTEXT CONFIG_NET_MAX_CONTEXTS
 static struct net_tcp tcp_context[NET_MAX_TCP_CONTEXT];
 
+/* Retransmission timeout before the first RTT measurement, and bounds of
+ * the timeout computed from the measurements (RFC 6298). Like most stacks,
+ * the lower bound is well below the 1 second suggested by the RFC.
+ */
 #define INIT_RETRY_MS 200
+#define MIN_RETRY_MS 200
+#define MAX_RETRY_MS K_SECONDS(60)
+
+/* Lost segments are being sent again */
+#define LOSS_RECOVERY (NET_TCP_RETRYING | NET_TCP_FAST_RECOVERY)
+
+/* Segment size assumed when the MSS is not known (RFC 1122) */
+#define DEFAULT_MSS 536
+
+/* Extensions announced in our SYN segments */
+#define LOCAL_EXT							\
+	((IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ? NET_TCP_EXT_WSCALE : 0) | \
+	 (IS_ENABLED(CONFIG_NET_TCP_SACK) ? NET_TCP_EXT_SACK : 0) |	\
+	 (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) ? NET_TCP_EXT_TS : 0))
+
+/* Segments received out of order hold RX packets and data buffers until
+ * the hole before them is filled. Leave at least half of each to the
+ * segment that fills the hole and to the other traffic.
+ */
+#define OOO_MAX_RX_PKTS (CONFIG_NET_PKT_RX_COUNT / 2)
+#define OOO_MAX_RX_BUFS (CONFIG_NET_BUF_RX_COUNT / 2)
+
+static struct k_mem_slab *rx_slab;
+static struct net_buf_pool *rx_pool;
+
+/* RX packets and data buffers held by the queues of all connections */
+static atomic_t ooo_rx_pkts;
+static atomic_t ooo_rx_bufs;
 
 /* 2MSL timeout, where "MSL" is arbitrarily 2 minutes in the RFC */
 #if defined(CONFIG_NET_TCP_2MSL_TIME)
@@ -117,7 +149,119 @@ static inline u32_t init_isn(void)
 
 static inline u32_t retry_timeout(const struct net_tcp *tcp)
 {
-	return ((u32_t)1 << tcp->retry_timeout_shift) * INIT_RETRY_MS;
+	return min((u64_t)tcp->rto << tcp->retry_timeout_shift, MAX_RETRY_MS);
+}
+
+/* Update the smoothed RTT and the RTT variation with a new measurement,
+ * then derive the retransmission timeout from them (RFC 6298, section 2).
+ * As usual, srtt is kept scaled by 8 and rttvar by 4.
+ */
+static void rtt_update(struct net_tcp *tcp, u32_t rtt)
+{
+	s32_t delta;
+
+	rtt = max(rtt, 1);
+
+	if (!tcp->srtt) {
+		tcp->srtt = rtt << 3;
+		tcp->rttvar = rtt << 1;
+	} else {
+		delta = rtt - (tcp->srtt >> 3);
+		tcp->srtt += delta;
+
+		if (delta < 0) {
+			delta = -delta;
+		}
+
+		tcp->rttvar += delta - (tcp->rttvar >> 2);
+	}
+
+	tcp->rto = (tcp->srtt >> 3) + tcp->rttvar;
+	tcp->rto = max(tcp->rto, MIN_RETRY_MS);
+	tcp->rto = min(tcp->rto, MAX_RETRY_MS);
+
+	NET_DBG("rtt %u ms srtt %u ms rttvar %u ms rto %u ms", rtt,
+		tcp->srtt >> 3, tcp->rttvar >> 2, tcp->rto);
+}
+
+/* Sender maximum segment size used to size the congestion window */
+static u32_t tcp_smss(const struct net_tcp *tcp)
+{
+	u32_t mss = net_tcp_get_recv_mss(tcp);
+
+	if (tcp->send_mss) {
+		mss = mss ? min(mss, tcp->send_mss) : tcp->send_mss;
+	}
+
+	return mss ? mss : DEFAULT_MSS;
+}
+
+/* Initial congestion window (RFC 5681, section 3.1) */
+static u32_t initial_window(const struct net_tcp *tcp)
+{
+	u32_t smss = tcp_smss(tcp);
+
+	if (smss > 2190) {
+		return 2 * smss;
+	} else if (smss > 1095) {
+		return 3 * smss;
+	}
+
+	return 4 * smss;
+}
+
+/* True if the (signed!) difference "seq1 - seq2" is positive and less
+ * than 2^29.  That is, seq1 is "after" seq2.
+ */
+static inline bool seq_greater(u32_t seq1, u32_t seq2)
+{
+	int d = (int)(seq1 - seq2);
+
+	return d > 0 && d < 0x20000000;
+}
+
+static inline u32_t pkt_seq(struct net_pkt *pkt)
+{
+	return sys_get_be32(NET_TCP_HDR(pkt)->seq);
+}
+
+/* Sequence number of the end of the data sent and not yet acknowledged */
+static u32_t sent_end(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt, *last = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (net_pkt_sent(pkt)) {
+			last = pkt;
+		}
+	}
+
+	if (last) {
+		return pkt_seq(last) + net_pkt_appdatalen(last);
+	}
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt, sent_list);
+
+	return pkt ? pkt_seq(pkt) : tcp->send_seq;
+}
+
+/* Number of bytes sent and not yet acknowledged */
+static u32_t flight_size(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt, sent_list);
+	if (!pkt) {
+		return 0;
+	}
+
+	return sent_end(tcp) - pkt_seq(pkt);
+}
+
+/* Slow start threshold after a loss (RFC 5681, equation 4) */
+static void set_ssthresh(struct net_tcp *tcp)
+{
+	tcp->ssthresh = max(flight_size(tcp) / 2, 2 * tcp_smss(tcp));
 }
 
 #define is_6lo_technology(pkt)						    \
@@ -140,25 +284,117 @@ static inline void do_ref_if_needed(struct net_pkt *pkt)
 	}
 }
 
+/* Send an unack'd packet again */
+static void resend_pkt(struct net_pkt *pkt)
+{
+	/* Packets not sent yet already hold the ref of the send */
+	if (net_pkt_sent(pkt)) {
+		do_ref_if_needed(pkt);
+	}
+
+	if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Send the first unack'd packet again */
+static void resend_head(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt, sent_list);
+
+	tcp->sack_next = pkt_seq(pkt) + net_pkt_appdatalen(pkt);
+
+	resend_pkt(pkt);
+}
+
+/* Send again the first segment that the peer did not receive while it
+ * received segments after it, according to its SACK blocks, and that was
+ * not already sent again during this fast recovery (a simplified form of
+ * RFC 6675). Returns true if a segment was sent.
+ */
+static bool resend_hole(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt, *hole = NULL;
+
+	if (!(tcp->ext & NET_TCP_EXT_SACK)) {
+		return false;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!net_pkt_sent(pkt)) {
+			break;
+		}
+
+		if (net_pkt_sacked(pkt)) {
+			if (hole) {
+				break;
+			}
+
+			continue;
+		}
+
+		if (!hole && !seq_greater(tcp->sack_next, pkt_seq(pkt))) {
+			hole = pkt;
+		}
+	}
+
+	/* The hole is only known to be lost if data after it arrived */
+	if (!hole || !pkt || !net_pkt_sacked(pkt)) {
+		return false;
+	}
+
+	tcp->sack_next = pkt_seq(hole) + net_pkt_appdatalen(hole);
+	resend_pkt(hole);
+
+	return true;
+}
+
 static void tcp_retry_expired(struct k_timer *timer)
 {
 	struct net_tcp *tcp = CONTAINER_OF(timer, struct net_tcp, retry_timer);
 	struct net_pkt *pkt;
 
-	/* Double the retry period for exponential backoff and resent
-	 * the first (only the first!) unack'd packet.
-	 */
 	if (!sys_slist_is_empty(&tcp->sent_list)) {
-		tcp->retry_timeout_shift++;
-		k_timer_start(&tcp->retry_timer, retry_timeout(tcp), 0);
+		/* The segment is lost: keep the slow start threshold at
+		 * half the data in flight for the first timeout only, and
+		 * restart from a loss window of one segment (RFC 5681,
+		 * section 3.1).
+		 */
+		if (!tcp->retry_timeout_shift) {
+			set_ssthresh(tcp);
+		}
 
-		pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
-				   struct net_pkt, sent_list);
+		tcp->cwnd = tcp_smss(tcp);
+		tcp->recover = sent_end(tcp);
+		tcp->dup_acks = 0;
+		tcp->rtt_pending = 0;
+		tcp->flags &= ~NET_TCP_FAST_RECOVERY;
+		tcp->flags |= NET_TCP_RETRYING;
 
-		do_ref_if_needed(pkt);
-		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
-			net_pkt_unref(pkt);
+		/* Double the retry period for exponential backoff */
+		if (retry_timeout(tcp) < MAX_RETRY_MS) {
+			tcp->retry_timeout_shift++;
 		}
+
+		k_timer_start(&tcp->retry_timer, retry_timeout(tcp), 0);
+
+		/* Go back to the first unack'd packet: everything after it
+		 * is sent again as the congestion window opens, as the
+		 * peer may have discarded the data it selectively
+		 * acknowledged (RFC 2018, section 8).
+		 */
+		SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt,
+					     sent_list) {
+			if (net_pkt_sent(pkt)) {
+				do_ref_if_needed(pkt);
+				net_pkt_set_sent(pkt, false);
+				net_pkt_set_sacked(pkt, false);
+			}
+		}
+
+		net_tcp_send_data(tcp->context);
 	} else if (IS_ENABLED(CONFIG_NET_TCP_TIME_WAIT)) {
 		if (tcp->fin_sent && tcp->fin_rcvd) {
 			net_context_unref(tcp->context);
@@ -194,12 +430,51 @@ struct net_tcp *net_tcp_alloc(struct net_context *context)
 
 	tcp_context[i].accept_cb = NULL;
 
+	tcp_context[i].rto = INIT_RETRY_MS;
+	tcp_context[i].ssthresh = UINT32_MAX;
+
 	k_timer_init(&tcp_context[i].retry_timer, tcp_retry_expired, NULL);
 	k_sem_init(&tcp_context[i].connect_wait, 0, UINT_MAX);
 
 	return &tcp_context[i];
 }
 
+/* Number of RX data buffers that hold the data of a packet */
+static int rx_bufs(struct net_pkt *pkt)
+{
+	struct net_buf *frag;
+	int count = 0;
+
+	for (frag = pkt->frags; frag; frag = frag->frags) {
+		if (frag->pool == rx_pool) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static bool ooo_full(struct net_tcp *tcp, int pkts, int bufs)
+{
+	return tcp->ooo_count >= CONFIG_NET_TCP_OOO_QUEUE_LEN ||
+	       atomic_get(&ooo_rx_pkts) + pkts > OOO_MAX_RX_PKTS ||
+	       atomic_get(&ooo_rx_bufs) + bufs > OOO_MAX_RX_BUFS;
+}
+
+static void ooo_remove(struct net_tcp *tcp, struct net_pkt *prev,
+		       struct net_pkt *pkt)
+{
+	sys_slist_remove(&tcp->ooo_list, prev ? &prev->sent_list : NULL,
+			 &pkt->sent_list);
+
+	tcp->ooo_count--;
+	atomic_sub(&ooo_rx_bufs, rx_bufs(pkt));
+
+	if (pkt->slab == rx_slab) {
+		atomic_dec(&ooo_rx_pkts);
+	}
+}
+
 int net_tcp_release(struct net_tcp *tcp)
 {
 	struct net_pkt *pkt;
@@ -213,6 +488,18 @@ int net_tcp_release(struct net_tcp *tcp)
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp->sent_list, pkt, tmp,
 					  sent_list) {
 		sys_slist_remove(&tcp->sent_list, NULL, &pkt->sent_list);
+
+		/* Drop the ref taken for the send that never happened */
+		if (!net_pkt_sent(pkt) && !is_6lo_technology(pkt)) {
+			net_pkt_unref(pkt);
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	while ((pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->ooo_list, pkt,
+						    sent_list))) {
+		ooo_remove(tcp, NULL, pkt);
 		net_pkt_unref(pkt);
 	}
 
@@ -225,7 +512,7 @@ int net_tcp_release(struct net_tcp *tcp)
 	tcp->context = NULL;
 
 	key = irq_lock();
-	tcp->flags &= ~(NET_TCP_IN_USE | NET_TCP_RECV_MSS_SET);
+	tcp->flags &= ~NET_TCP_IN_USE;
 	irq_unlock(key);
 
 	NET_DBG("Disposed of TCP connection state");
@@ -362,20 +649,197 @@ static inline u32_t get_recv_wnd(struct net_tcp *tcp)
 
 	/* We don't queue received data inside the stack, we hand off
 	 * packets to synchronous callbacks (who can queue if they
-	 * want, but it's not our business).  So the available window
-	 * size is always the same.  There are two configurables to
-	 * check though.
+	 * want, but it's not our business), except for the segments
+	 * received out of order which are bounded by the window itself.
+	 * So the available window size is always the same.
 	 */
-	return min(NET_TCP_MAX_WIN, NET_TCP_BUF_MAX_LEN);
+	return CONFIG_NET_TCP_RECV_WINDOW;
 }
 
-/* True if the (signed!) difference "seq1 - seq2" is positive and less
- * than 2^29.  That is, seq1 is "after" seq2.
+/* Receive window as the peer sees it, once scaled to the 16-bit field */
+static inline u32_t get_adv_wnd(struct net_tcp *tcp)
+{
+	return min(get_recv_wnd(tcp) >> tcp->recv_wscale, 0xffff) <<
+		tcp->recv_wscale;
+}
+
+/* Window scale shift that makes our window fit in the 16-bit field */
+static u8_t get_recv_wscale(void)
+{
+	u8_t shift = 0;
+
+	while ((CONFIG_NET_TCP_RECV_WINDOW >> shift) > 0xffff &&
+	       shift < NET_TCP_MAX_WIN_SCALE) {
+		shift++;
+	}
+
+	return shift;
+}
+
+static u8_t *put_timestamps(struct net_tcp *tcp, u8_t *opt)
+{
+	*opt++ = NET_TCP_OPT_TIMESTAMP;
+	*opt++ = NET_TCP_TIMESTAMP_SIZE;
+	sys_put_be32(k_uptime_get_32(), opt);
+	sys_put_be32(tcp->ts_recent, opt + 4);
+
+	return opt + 8;
+}
+
+/* Options of a SYN segment: all the extensions we support in a SYN, the
+ * ones the peer announced as well in a SYN-ACK. They are laid out as
+ * recommended in RFC 7323, appendix A.
  */
-static inline bool seq_greater(u32_t seq1, u32_t seq2)
+static u8_t syn_options(struct net_tcp *tcp, u8_t flags, u8_t *options)
 {
-	int d = (int)(seq1 - seq2);
-	return d > 0 && d < 0x20000000;
+	u8_t ext = (flags & NET_TCP_ACK) ? tcp->ext : LOCAL_EXT;
+	u8_t *opt = options;
+
+	*opt++ = NET_TCP_OPT_MSS;
+	*opt++ = NET_TCP_MSS_SIZE;
+	sys_put_be16(net_tcp_get_recv_mss(tcp), opt);
+	opt += 2;
+
+	if (ext & NET_TCP_EXT_WSCALE) {
+		*opt++ = NET_TCP_OPT_NOP;
+		*opt++ = NET_TCP_OPT_WINDOW;
+		*opt++ = NET_TCP_WINDOW_SIZE;
+		*opt++ = get_recv_wscale();
+	}
+
+	if ((ext & NET_TCP_EXT_SACK) && (ext & NET_TCP_EXT_TS)) {
+		*opt++ = NET_TCP_OPT_SACK_PERM;
+		*opt++ = NET_TCP_SACK_PERM_SIZE;
+		opt = put_timestamps(tcp, opt);
+	} else if (ext & NET_TCP_EXT_SACK) {
+		*opt++ = NET_TCP_OPT_NOP;
+		*opt++ = NET_TCP_OPT_NOP;
+		*opt++ = NET_TCP_OPT_SACK_PERM;
+		*opt++ = NET_TCP_SACK_PERM_SIZE;
+	} else if (ext & NET_TCP_EXT_TS) {
+		*opt++ = NET_TCP_OPT_NOP;
+		*opt++ = NET_TCP_OPT_NOP;
+		opt = put_timestamps(tcp, opt);
+	}
+
+	return opt - options;
+}
+
+/* Get the block of contiguous data in the out of order queue that starts
+ * with *pkt, and move *pkt to the segment after the block.
+ */
+static void next_sack_block(struct net_pkt **pkt, u32_t *left, u32_t *right)
+{
+	struct net_pkt *next = *pkt;
+
+	*left = pkt_seq(next);
+	*right = *left + net_pkt_appdatalen(next);
+
+	while ((next = SYS_SLIST_PEEK_NEXT_CONTAINER(next, sent_list)) &&
+	       !seq_greater(pkt_seq(next), *right)) {
+		if (seq_greater(pkt_seq(next) + net_pkt_appdatalen(next),
+				*right)) {
+			*right = pkt_seq(next) + net_pkt_appdatalen(next);
+		}
+	}
+
+	*pkt = next;
+}
+
+/* SACK option reporting the out of order data held, the block with the
+ * last segment received first (RFC 2018, section 4).
+ */
+static u8_t *put_sack(struct net_tcp *tcp, u8_t *opt, int max_blocks)
+{
+	u8_t *start = opt;
+	struct net_pkt *pkt;
+	u32_t left, right, first = 0;
+	int blocks = 0;
+
+	opt += 4;
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->ooo_list, pkt, sent_list);
+	while (pkt) {
+		next_sack_block(&pkt, &left, &right);
+
+		if (!seq_greater(left, tcp->ooo_last) &&
+		    seq_greater(right, tcp->ooo_last)) {
+			sys_put_be32(left, opt);
+			sys_put_be32(right, opt + 4);
+			opt += 8;
+			first = left;
+			blocks++;
+			break;
+		}
+	}
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->ooo_list, pkt, sent_list);
+	while (pkt && blocks < max_blocks) {
+		next_sack_block(&pkt, &left, &right);
+
+		if (opt - start > 4 && left == first) {
+			continue;
+		}
+
+		sys_put_be32(left, opt);
+		sys_put_be32(right, opt + 4);
+		opt += 8;
+		blocks++;
+	}
+
+	start[0] = NET_TCP_OPT_NOP;
+	start[1] = NET_TCP_OPT_NOP;
+	start[2] = NET_TCP_OPT_SACK;
+	start[3] = 2 + 8 * blocks;
+
+	return opt;
+}
+
+/* Options of a segment other than a SYN. The SACK blocks are only sent
+ * in segments without data, as data segments may be sent much later
+ * than they are prepared.
+ */
+static u8_t segment_options(struct net_tcp *tcp, bool sack, u8_t *options)
+{
+	u8_t *opt = options;
+
+	if (tcp->ext & NET_TCP_EXT_TS) {
+		*opt++ = NET_TCP_OPT_NOP;
+		*opt++ = NET_TCP_OPT_NOP;
+		opt = put_timestamps(tcp, opt);
+	}
+
+	if (sack && (tcp->ext & NET_TCP_EXT_SACK) &&
+	    !sys_slist_is_empty(&tcp->ooo_list)) {
+		opt = put_sack(tcp, opt, (tcp->ext & NET_TCP_EXT_TS) ?
+			       NET_TCP_MAX_SACK_BLOCKS - 1 :
+			       NET_TCP_MAX_SACK_BLOCKS);
+	}
+
+	return opt - options;
+}
+
+/* Find an option in a TCP header built by this stack */
+static u8_t *find_option(struct net_tcp_hdr *tcphdr, u8_t kind)
+{
+	u8_t *opt = (u8_t *)tcphdr + NET_TCPH_LEN;
+	u8_t *end = (u8_t *)tcphdr + 4 * (tcphdr->offset >> 4);
+
+	while (opt < end && *opt != NET_TCP_OPT_END) {
+		if (*opt == kind) {
+			return opt;
+		}
+
+		if (*opt == NET_TCP_OPT_NOP) {
+			opt++;
+		} else if (opt + 1 < end && opt[1] >= 2) {
+			opt += opt[1];
+		} else {
+			break;
+		}
+	}
+
+	return NULL;
 }
 
 int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
@@ -384,6 +848,8 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 			    const struct sockaddr *remote,
 			    struct net_pkt **send_pkt)
 {
+	u8_t opts[NET_TCP_MAX_OPT_SIZE];
+	u8_t opts_len;
 	u32_t seq;
 	u16_t wnd;
 	struct tcp_segment segment = { 0 };
@@ -429,7 +895,21 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 		seq++;
 	}
 
-	wnd = get_recv_wnd(tcp);
+	/* The window of a SYN segment is never scaled (RFC 7323) */
+	if (flags & NET_TCP_SYN) {
+		wnd = min(get_recv_wnd(tcp), 0xffff);
+		opts_len = syn_options(tcp, flags, opts);
+	} else {
+		wnd = get_adv_wnd(tcp) >> tcp->recv_wscale;
+		opts_len = segment_options(tcp, !*send_pkt, opts);
+	}
+
+	if (options && optlen) {
+		NET_ASSERT(opts_len + optlen <= NET_TCP_MAX_OPT_SIZE);
+
+		memcpy(opts + opts_len, options, optlen);
+		opts_len += optlen;
+	}
 
 	segment.src_addr = (struct sockaddr_ptr *)local;
 	segment.dst_addr = remote;
@@ -437,8 +917,8 @@ int net_tcp_prepare_segment(struct net_tcp *tcp, u8_t flags,
 	segment.ack = tcp->send_ack;
 	segment.flags = flags;
 	segment.wnd = wnd;
-	segment.options = options;
-	segment.optlen = optlen;
+	segment.options = opts;
+	segment.optlen = opts_len;
 
 	*send_pkt = prepare_segment(tcp, &segment, *send_pkt);
 	if (!*send_pkt) {
@@ -512,32 +992,9 @@ u16_t net_tcp_get_recv_mss(const struct net_tcp *tcp)
 	return 0;
 }
 
-static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
-				u8_t *optionlen)
-{
-	u16_t recv_mss;
-
-	*optionlen = 0;
-
-	if (!(tcp->flags & NET_TCP_RECV_MSS_SET)) {
-		recv_mss = net_tcp_get_recv_mss(tcp);
-		tcp->flags |= NET_TCP_RECV_MSS_SET;
-	} else {
-		recv_mss = 0;
-	}
-
-	UNALIGNED_PUT(htonl((u32_t)recv_mss | NET_TCP_MSS_HEADER),
-		      (u32_t *)(options + *optionlen));
-
-	*optionlen += NET_TCP_MSS_SIZE;
-}
-
 int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 			struct net_pkt **pkt)
 {
-	u8_t options[NET_TCP_MAX_OPT_SIZE];
-	u8_t optionlen;
-
 	switch (net_tcp_get_state(tcp)) {
 	case NET_TCP_SYN_RCVD:
 		/* In the SYN_RCVD state acknowledgment must be with the
@@ -545,11 +1002,8 @@ int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 		 */
 		tcp->send_seq--;
 
-		net_tcp_set_syn_opt(tcp, options, &optionlen);
-
 		return net_tcp_prepare_segment(tcp, NET_TCP_SYN | NET_TCP_ACK,
-					       options, optionlen, NULL, remote,
-					       pkt);
+					       0, 0, NULL, remote, pkt);
 	case NET_TCP_FIN_WAIT_1:
 	case NET_TCP_LAST_ACK:
 		/* In the FIN_WAIT_1 and LAST_ACK states acknowledgment must
@@ -668,9 +1122,25 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 {
 	struct net_context *ctx = net_pkt_context(pkt);
 	struct net_tcp_hdr *tcphdr = NET_TCP_HDR(pkt);
+	u8_t orig_hdr[NET_TCPH_LEN + NET_TCP_MAX_OPT_SIZE];
+	u8_t hdr_len = 4 * (tcphdr->offset >> 4);
+	u8_t *ts;
+
+	memcpy(orig_hdr, tcphdr, hdr_len);
 
 	sys_put_be32(ctx->tcp->send_ack, tcphdr->ack);
 
+	/* Stamp the segment with the time it is actually sent, and echo
+	 * the latest timestamp of the peer (RFC 7323, section 4.3).
+	 */
+	if (ctx->tcp->ext & NET_TCP_EXT_TS) {
+		ts = find_option(tcphdr, NET_TCP_OPT_TIMESTAMP);
+		if (ts) {
+			sys_put_be32(k_uptime_get_32(), ts + 2);
+			sys_put_be32(ctx->tcp->ts_recent, ts + 6);
+		}
+	}
+
 	/* The data stream code always sets this flag, because
 	 * existing stacks (Linux, anyway) seem to ignore data packets
 	 * without a valid-but-already-transmitted ACK.  But set it
@@ -680,6 +1150,13 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 		tcphdr->flags |= NET_TCP_ACK;
 	}
 
+	/* The checksum was computed when the segment was prepared, update
+	 * it for the new acknowledgment number, flags and timestamps rather
+	 * than summing the whole segment again.
+	 */
+	tcphdr->chksum = net_chksum_update(tcphdr->chksum, orig_hdr, tcphdr,
+					   hdr_len);
+
 	if (tcphdr->flags & NET_TCP_FIN) {
 		ctx->tcp->fin_sent = 1;
 	}
@@ -743,7 +1220,6 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 static void restart_timer(struct net_tcp *tcp)
 {
 	if (!sys_slist_is_empty(&tcp->sent_list)) {
-		tcp->flags |= NET_TCP_RETRYING;
 		tcp->retry_timeout_shift = 0;
 		k_timer_start(&tcp->retry_timer, retry_timeout(tcp), 0);
 	} else if (IS_ENABLED(CONFIG_NET_TCP_TIME_WAIT)) {
@@ -756,45 +1232,206 @@ static void restart_timer(struct net_tcp *tcp)
 		}
 	} else {
 		k_timer_stop(&tcp->retry_timer);
-		tcp->flags &= ~NET_TCP_RETRYING;
 	}
 }
 
 int net_tcp_send_data(struct net_context *context)
 {
+	struct net_tcp *tcp = context->tcp;
 	struct net_pkt *pkt;
+	u32_t una, seq, wnd;
+
+	pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->sent_list, pkt, sent_list);
+	if (!pkt) {
+		return 0;
+	}
 
-	/* For now, just send all queued data synchronously.  Need to
-	 * add window handling and retry/ACK logic.
+	una = pkt_seq(pkt);
+	wnd = min(tcp->cwnd, tcp->send_wnd);
+
+	/* Send the queued data synchronously, as long as it fits in the
+	 * congestion window and in the window of the peer. The first
+	 * unack'd packet is always sent so that the connection does not
+	 * stall on segments larger than the window, and probes a closed
+	 * window of the peer.
 	 */
-	SYS_SLIST_FOR_EACH_CONTAINER(&context->tcp->sent_list, pkt, sent_list) {
-		if (!net_pkt_sent(pkt)) {
-			if (net_tcp_send_pkt(pkt) < 0 &&
-			    !is_6lo_technology(pkt)) {
-				net_pkt_unref(pkt);
-			}
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (net_pkt_sent(pkt)) {
+			continue;
+		}
+
+		seq = pkt_seq(pkt);
+
+		if (seq != una &&
+		    seq - una + net_pkt_appdatalen(pkt) > wnd) {
+			break;
+		}
+
+		/* Time one segment per round trip, and without timestamps
+		 * never one that might be a retransmission (Karn's
+		 * algorithm).
+		 */
+		if (!tcp->rtt_pending && (!(tcp->flags & LOSS_RECOVERY) ||
+					  (tcp->ext & NET_TCP_EXT_TS))) {
+			tcp->rtt_pending = 1;
+			tcp->rtt_seq = seq + net_pkt_appdatalen(pkt);
+			tcp->rtt_start = k_uptime_get_32();
+		}
+
+		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
+			net_pkt_unref(pkt);
 		}
 	}
 
 	return 0;
 }
 
-void net_tcp_ack_received(struct net_context *ctx, u32_t ack)
+/* Grow or deflate the congestion window on an ACK of new data */
+static void cwnd_ack(struct net_tcp *tcp, u32_t ack, u32_t acked)
+{
+	u32_t smss = tcp_smss(tcp);
+
+	if (tcp->flags & NET_TCP_FAST_RECOVERY) {
+		if (!seq_greater(tcp->recover, ack)) {
+			/* Full ACK: leave fast recovery with a window that
+			 * does not allow a burst (RFC 6582, section 3.2).
+			 */
+			tcp->cwnd = min(tcp->ssthresh,
+					max(flight_size(tcp), smss) + smss);
+			tcp->flags &= ~NET_TCP_FAST_RECOVERY;
+			tcp->dup_acks = 0;
+		} else {
+			/* Partial ACK: the next hole is lost as well, send
+			 * it again right away unless the SACK blocks already
+			 * had it sent again, and deflate the window by the
+			 * data acked.
+			 */
+			if (!(tcp->ext & NET_TCP_EXT_SACK) ||
+			    !seq_greater(tcp->sack_next, ack)) {
+				resend_head(tcp);
+			}
+
+			tcp->cwnd -= min(tcp->cwnd - smss, acked);
+			if (acked >= smss) {
+				tcp->cwnd += smss;
+			}
+		}
+
+		return;
+	}
+
+	tcp->dup_acks = 0;
+
+	if (tcp->cwnd < tcp->ssthresh) {
+		/* Slow start */
+		tcp->cwnd += min(acked, smss);
+	} else {
+		/* Congestion avoidance, about one segment per RTT */
+		tcp->cwnd += max(smss * smss / tcp->cwnd, 1);
+	}
+}
+
+/* Fast retransmit and fast recovery on duplicate ACKs (RFC 5681,
+ * section 3.2 and RFC 6582)
+ */
+static void cwnd_dup_ack(struct net_tcp *tcp)
+{
+	u32_t smss = tcp_smss(tcp);
+
+	if (tcp->flags & NET_TCP_FAST_RECOVERY) {
+		/* Each duplicate ACK is a segment that left the network,
+		 * which makes room for the next hole reported by the peer
+		 * if there is one, or for new data.
+		 */
+		if (!resend_hole(tcp)) {
+			tcp->cwnd += smss;
+		}
+
+		return;
+	}
+
+	if (tcp->dup_acks < 3) {
+		tcp->dup_acks++;
+	}
+
+	/* Do not start again while the losses of a timeout are recovered */
+	if (tcp->dup_acks < 3 || (tcp->flags & NET_TCP_RETRYING)) {
+		return;
+	}
+
+	set_ssthresh(tcp);
+	tcp->recover = sent_end(tcp);
+	tcp->rtt_pending = 0;
+	tcp->flags |= NET_TCP_FAST_RECOVERY;
+
+	resend_head(tcp);
+
+	tcp->cwnd = tcp->ssthresh + 3 * smss;
+
+	NET_DBG("Fast retransmit, cwnd %u ssthresh %u", tcp->cwnd,
+		tcp->ssthresh);
+}
+
+/* Mark the segments covered by the SACK blocks of an ACK */
+static void sack_received(struct net_tcp *tcp,
+			  const struct net_tcp_options *opts)
+{
+	struct net_pkt *pkt;
+	u32_t seq, end;
+	int i;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!net_pkt_sent(pkt) || net_pkt_sacked(pkt)) {
+			continue;
+		}
+
+		seq = pkt_seq(pkt);
+		end = seq + net_pkt_appdatalen(pkt);
+
+		for (i = 0; i < opts->sack_blocks; i++) {
+			if (!seq_greater(opts->sack[i].left, seq) &&
+			    !seq_greater(end, opts->sack[i].right)) {
+				net_pkt_set_sacked(pkt, true);
+				break;
+			}
+		}
+	}
+}
+
+void net_tcp_ack_received(struct net_context *ctx, struct net_pkt *pkt,
+			  const struct net_tcp_options *opts)
 {
 	struct net_tcp *tcp = ctx->tcp;
 	sys_slist_t *list = &ctx->tcp->sent_list;
 	sys_snode_t *head;
-	struct net_pkt *pkt;
-	struct net_tcp_hdr *tcphdr;
+	struct net_pkt *sent_pkt;
+	struct net_tcp_hdr *tcphdr = NET_TCP_HDR(pkt);
+	u32_t ack = sys_get_be32(tcphdr->ack);
+	u32_t wnd = sys_get_be16(tcphdr->wnd) << tcp->send_wscale;
 	u32_t seq;
+	u32_t acked = 0;
 	bool valid_ack = false;
+	bool dup_ack;
+
+	/* A duplicate ACK carries no data, SYN nor FIN, and does not
+	 * change the window (RFC 5681, section 2).
+	 */
+	dup_ack = !net_pkt_appdatalen(pkt) && wnd == tcp->send_wnd &&
+		!(NET_TCP_FLAGS(pkt) & (NET_TCP_SYN | NET_TCP_FIN));
+
+	tcp->send_wnd = wnd;
+
+	if (opts->sack_blocks && (tcp->ext & NET_TCP_EXT_SACK)) {
+		sack_received(tcp, opts);
+	}
 
 	while (!sys_slist_is_empty(list)) {
 		head = sys_slist_peek_head(list);
-		pkt = CONTAINER_OF(head, struct net_pkt, sent_list);
-		tcphdr = NET_TCP_HDR(pkt);
+		sent_pkt = CONTAINER_OF(head, struct net_pkt, sent_list);
+		tcphdr = NET_TCP_HDR(sent_pkt);
 
-		seq = sys_get_be32(tcphdr->seq) + net_pkt_appdatalen(pkt) - 1;
+		seq = sys_get_be32(tcphdr->seq) +
+			net_pkt_appdatalen(sent_pkt) - 1;
 
 		if (!seq_greater(ack, seq)) {
 			break;
@@ -811,11 +1448,44 @@ void net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		}
 
 		sys_slist_remove(list, NULL, head);
-		net_pkt_unref(pkt);
+
+		/* The packet was marked for a resend after a timeout but
+		 * its first transmission made it to the peer.
+		 */
+		if (!net_pkt_sent(sent_pkt) &&
+		    !is_6lo_technology(sent_pkt)) {
+			net_pkt_unref(sent_pkt);
+		}
+
+		acked += net_pkt_appdatalen(sent_pkt);
+		net_pkt_unref(sent_pkt);
 		valid_ack = true;
 	}
 
 	if (valid_ack) {
+		if (tcp->rtt_pending && !seq_greater(tcp->rtt_seq, ack)) {
+			tcp->rtt_pending = 0;
+
+			/* The echoed timestamp tells when the segment that
+			 * triggered the ACK was sent, even if it was sent
+			 * more than once.
+			 */
+			if ((opts->ext & NET_TCP_EXT_TS) && opts->tsecr) {
+				rtt_update(tcp, k_uptime_get_32() -
+					   opts->tsecr);
+			} else {
+				rtt_update(tcp, k_uptime_get_32() -
+					   tcp->rtt_start);
+			}
+		}
+
+		if ((tcp->flags & NET_TCP_RETRYING) &&
+		    !seq_greater(tcp->recover, ack)) {
+			tcp->flags &= ~NET_TCP_RETRYING;
+		}
+
+		cwnd_ack(tcp, ack, acked);
+
 		/* Restart the timer on a valid inbound ACK.  This
 		 * isn't quite the same behavior as per-packet retry
 		 * timers, but is close in practice (it starts retries
@@ -825,28 +1495,327 @@ void net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		 */
 		restart_timer(ctx->tcp);
 
-		/* And, if we had been retrying, mark all packets
-		 * untransmitted and then resend them.  The stalled
-		 * pipe is uncorked again.
-		 */
-		if (ctx->tcp->flags & NET_TCP_RETRYING) {
-			struct net_pkt *pkt;
-
-			SYS_SLIST_FOR_EACH_CONTAINER(&ctx->tcp->sent_list, pkt,
-						     sent_list) {
-				if (net_pkt_sent(pkt)) {
-					do_ref_if_needed(pkt);
-					net_pkt_set_sent(pkt, false);
-				}
-			}
+		/* The congestion window may have room for more */
+		net_tcp_send_data(ctx);
+	} else if (dup_ack && !sys_slist_is_empty(list)) {
+		sent_pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(list, sent_pkt,
+							 sent_list);
 
+		if (net_pkt_sent(sent_pkt) && ack == pkt_seq(sent_pkt)) {
+			cwnd_dup_ack(tcp);
 			net_tcp_send_data(ctx);
 		}
 	}
 }
 
+int net_tcp_parse_opts(struct net_pkt *pkt, struct net_tcp_options *opts)
+{
+	struct net_tcp_hdr *tcphdr = NET_TCP_HDR(pkt);
+	u8_t options[NET_TCP_MAX_OPT_SIZE];
+	u8_t *opt, *end;
+	u16_t offset, pos;
+	u8_t len, i;
+
+	memset(opts, 0, sizeof(*opts));
+
+	len = 4 * (tcphdr->offset >> 4);
+	if (len < NET_TCPH_LEN) {
+		return -EINVAL;
+	}
+
+	len -= NET_TCPH_LEN;
+	if (!len) {
+		return 0;
+	}
+
+	offset = (u8_t *)tcphdr - pkt->frags->data + NET_TCPH_LEN;
+
+	net_frag_read(pkt->frags, offset, &pos, len, options);
+	if (pos == 0xffff) {
+		return -EINVAL;
+	}
+
+	end = options + len;
+
+	for (opt = options; opt < end && *opt != NET_TCP_OPT_END;
+	     opt += len) {
+		if (*opt == NET_TCP_OPT_NOP) {
+			len = 1;
+			continue;
+		}
+
+		if (opt + 1 >= end || opt[1] < 2 || opt + opt[1] > end) {
+			return -EINVAL;
+		}
+
+		len = opt[1];
+
+		switch (*opt) {
+		case NET_TCP_OPT_MSS:
+			if (len != NET_TCP_MSS_SIZE) {
+				return -EINVAL;
+			}
+
+			opts->mss = sys_get_be16(opt + 2);
+			break;
+		case NET_TCP_OPT_WINDOW:
+			if (len != NET_TCP_WINDOW_SIZE) {
+				return -EINVAL;
+			}
+
+			opts->wscale = min(opt[2], NET_TCP_MAX_WIN_SCALE);
+			opts->ext |= NET_TCP_EXT_WSCALE;
+			break;
+		case NET_TCP_OPT_SACK_PERM:
+			if (len != NET_TCP_SACK_PERM_SIZE) {
+				return -EINVAL;
+			}
+
+			opts->ext |= NET_TCP_EXT_SACK;
+			break;
+		case NET_TCP_OPT_SACK:
+			if ((len - 2) % 8) {
+				return -EINVAL;
+			}
+
+			opts->sack_blocks = min((len - 2) / 8,
+						NET_TCP_MAX_SACK_BLOCKS);
+
+			for (i = 0; i < opts->sack_blocks; i++) {
+				opts->sack[i].left =
+					sys_get_be32(opt + 2 + 8 * i);
+				opts->sack[i].right =
+					sys_get_be32(opt + 6 + 8 * i);
+			}
+
+			break;
+		case NET_TCP_OPT_TIMESTAMP:
+			if (len != NET_TCP_TIMESTAMP_SIZE) {
+				return -EINVAL;
+			}
+
+			opts->tsval = sys_get_be32(opt + 2);
+			opts->tsecr = sys_get_be32(opt + 6);
+			opts->ext |= NET_TCP_EXT_TS;
+			break;
+		default:
+			/* Unknown options are ignored */
+			break;
+		}
+	}
+
+	return 0;
+}
+
+void net_tcp_syn_received(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	struct net_tcp_options opts;
+
+	if (net_tcp_parse_opts(pkt, &opts) < 0) {
+		memset(&opts, 0, sizeof(opts));
+	}
+
+	tcp->ext = opts.ext & LOCAL_EXT;
+	tcp->send_mss = opts.mss;
+
+	if (tcp->ext & NET_TCP_EXT_WSCALE) {
+		tcp->send_wscale = opts.wscale;
+		tcp->recv_wscale = get_recv_wscale();
+	} else {
+		tcp->send_wscale = 0;
+		tcp->recv_wscale = 0;
+	}
+
+	if (tcp->ext & NET_TCP_EXT_TS) {
+		tcp->ts_recent = opts.tsval;
+	}
+
+	/* The window of a SYN segment is never scaled */
+	tcp->send_wnd = sys_get_be16(NET_TCP_HDR(pkt)->wnd);
+
+	NET_DBG("mss %u wnd %u wscale %u/%u sack %d ts %d", tcp->send_mss,
+		tcp->send_wnd, tcp->send_wscale, tcp->recv_wscale,
+		!!(tcp->ext & NET_TCP_EXT_SACK), !!(tcp->ext & NET_TCP_EXT_TS));
+}
+
+bool net_tcp_check_ts(struct net_tcp *tcp, struct net_pkt *pkt,
+		      const struct net_tcp_options *opts)
+{
+	if (!(tcp->ext & NET_TCP_EXT_TS) || !(opts->ext & NET_TCP_EXT_TS) ||
+	    (NET_TCP_FLAGS(pkt) & NET_TCP_RST)) {
+		return true;
+	}
+
+	if ((s32_t)(opts->tsval - tcp->ts_recent) < 0) {
+		NET_DBG("Old timestamp %u (recent %u)", opts->tsval,
+			tcp->ts_recent);
+		return false;
+	}
+
+	/* Echo the timestamp of the oldest segment not yet acknowledged
+	 * (RFC 7323, section 4.3).
+	 */
+	if (!seq_greater(pkt_seq(pkt), tcp->sent_ack)) {
+		tcp->ts_recent = opts->tsval;
+	}
+
+	return true;
+}
+
+/* Remove the first len bytes of data of a received segment. When they are
+ * in the first fragment, the headers are moved over them so that the data
+ * still starts in the first fragment, right after the headers.
+ */
+static void trim_data(struct net_pkt *pkt, u16_t len)
+{
+	struct net_buf *frag = pkt->frags;
+	u16_t hdr_len = net_pkt_appdata(pkt) - frag->data;
+	u32_t seq = pkt_seq(pkt);
+	u16_t left = len;
+	u16_t count;
+
+	count = min(left, frag->len - hdr_len);
+	memmove(frag->data + count, frag->data, hdr_len);
+	net_buf_pull(frag, count);
+	left -= count;
+
+	while (left && frag->frags) {
+		count = min(left, frag->frags->len);
+		net_buf_pull(frag->frags, count);
+		left -= count;
+
+		if (!frag->frags->len) {
+			net_pkt_frag_del(pkt, frag, frag->frags);
+		}
+	}
+
+	net_pkt_set_appdata(pkt, frag->data + hdr_len);
+	net_pkt_set_appdatalen(pkt, net_pkt_appdatalen(pkt) - len);
+
+	sys_put_be32(seq + len, NET_TCP_HDR(pkt)->seq);
+}
+
+int net_tcp_check_seq(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	u32_t seq = pkt_seq(pkt);
+
+	if (seq == tcp->send_ack) {
+		return 0;
+	}
+
+	if (seq_greater(seq, tcp->send_ack)) {
+		return 1;
+	}
+
+	if (!seq_greater(seq + net_pkt_appdatalen(pkt), tcp->send_ack)) {
+		return -1;
+	}
+
+	trim_data(pkt, tcp->send_ack - seq);
+
+	return 0;
+}
+
+int net_tcp_ooo_add(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	u32_t seq = pkt_seq(pkt);
+	u32_t end = seq + net_pkt_appdatalen(pkt);
+	struct net_pkt *queued, *prev = NULL;
+	struct net_pkt *last, *before_last;
+	int pkts, bufs;
+
+	if (!net_pkt_appdatalen(pkt) ||
+	    (NET_TCP_FLAGS(pkt) & (NET_TCP_SYN | NET_TCP_FIN))) {
+		return -EINVAL;
+	}
+
+	tcp->ooo_last = seq;
+
+	/* The window advertised bounds the data queued */
+	if (seq_greater(end, tcp->send_ack + get_adv_wnd(tcp))) {
+		return -ENOMEM;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->ooo_list, queued, sent_list) {
+		if (seq_greater(pkt_seq(queued), seq)) {
+			break;
+		}
+
+		if (!seq_greater(end, pkt_seq(queued) +
+				 net_pkt_appdatalen(queued))) {
+			return -EALREADY;
+		}
+
+		prev = queued;
+	}
+
+	pkts = pkt->slab == rx_slab;
+	bufs = rx_bufs(pkt);
+
+	/* Make room by dropping the last segments queued, as long as they
+	 * come after the new one: the data closest to the hole is the
+	 * first one delivered.
+	 */
+	while (ooo_full(tcp, pkts, bufs)) {
+		last = NULL;
+		before_last = NULL;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&tcp->ooo_list, queued,
+					     sent_list) {
+			before_last = last;
+			last = queued;
+		}
+
+		if (!last || !seq_greater(pkt_seq(last), seq)) {
+			NET_DBG("Queue full, seq %u dropped", seq);
+			return -ENOMEM;
+		}
+
+		NET_DBG("Queue full, seq %u dropped for seq %u",
+			pkt_seq(last), seq);
+
+		ooo_remove(tcp, before_last, last);
+		net_pkt_unref(last);
+	}
+
+	sys_slist_insert(&tcp->ooo_list, prev ? &prev->sent_list : NULL,
+			 &pkt->sent_list);
+
+	tcp->ooo_count++;
+	atomic_add(&ooo_rx_pkts, pkts);
+	atomic_add(&ooo_rx_bufs, bufs);
+
+	NET_DBG("Queued out of order seq %u len %u", seq,
+		net_pkt_appdatalen(pkt));
+
+	return 0;
+}
+
+struct net_pkt *net_tcp_ooo_get(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+
+	while ((pkt = SYS_SLIST_PEEK_HEAD_CONTAINER(&tcp->ooo_list, pkt,
+						    sent_list))) {
+		if (seq_greater(pkt_seq(pkt), tcp->send_ack)) {
+			return NULL;
+		}
+
+		ooo_remove(tcp, NULL, pkt);
+
+		if (!net_tcp_check_seq(tcp, pkt)) {
+			return pkt;
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	return NULL;
+}
+
 void net_tcp_init(void)
 {
+	net_pkt_get_info(&rx_slab, NULL, &rx_pool, NULL);
 }
 
 #if defined(CONFIG_NET_DEBUG_TCP)
@@ -907,6 +1876,11 @@ void net_tcp_change_state(struct net_tcp *tcp,
 
 	tcp->state = new_state;
 
+	if (net_tcp_get_state(tcp) == NET_TCP_ESTABLISHED) {
+		tcp->cwnd = initial_window(tcp);
+		return;
+	}
+
 	if (net_tcp_get_state(tcp) != NET_TCP_CLOSED) {
 		return;
 	}
@@ -41,8 +41,8 @@ extern "C" {
 /** A retransmitted packet has been sent and not yet ack'd */
 #define NET_TCP_RETRYING BIT(4)
 
-/** MSS option has been set already */
-#define NET_TCP_RECV_MSS_SET BIT(5)
+/** Fast recovery after a fast retransmit is in progress */
+#define NET_TCP_FAST_RECOVERY BIT(6)
 
 /*
  * TCP connection states
@@ -72,28 +72,70 @@ enum net_tcp_state {
 
 #define NET_TCP_FLAGS(net_pkt) (NET_TCP_HDR(net_pkt)->flags & NET_TCP_CTL)
 
-/* TCP max window size */
-#define NET_TCP_MAX_WIN   (4 * 1024)
-
 /* Maximal value of the sequence number */
 #define NET_TCP_MAX_SEQ   0xffffffff
 
-#define NET_TCP_MAX_OPT_SIZE  8
+#define NET_TCP_MAX_OPT_SIZE  40
+
+/* TCP option kinds */
+#define NET_TCP_OPT_END       0
+#define NET_TCP_OPT_NOP       1
+#define NET_TCP_OPT_MSS       2
+#define NET_TCP_OPT_WINDOW    3
+#define NET_TCP_OPT_SACK_PERM 4
+#define NET_TCP_OPT_SACK      5
+#define NET_TCP_OPT_TIMESTAMP 8
+
+#define NET_TCP_MSS_SIZE       4  /* MSS option size */
+#define NET_TCP_WINDOW_SIZE    3  /* Window scale option size */
+#define NET_TCP_SACK_PERM_SIZE 2  /* SACK permitted option size */
+#define NET_TCP_TIMESTAMP_SIZE 10 /* Timestamps option size */
 
-#define NET_TCP_MSS_HEADER    0x02040000 /* MSS option */
-#define NET_TCP_WINDOW_HEADER 0x30300    /* Window scale option */
+/* Max number of blocks in a SACK option */
+#define NET_TCP_MAX_SACK_BLOCKS 4
 
-#define NET_TCP_MSS_SIZE      4          /* MSS option size */
-#define NET_TCP_WINDOW_SIZE   3          /* Window scale option size */
+/* Max window scale shift (RFC 7323, section 2.3) */
+#define NET_TCP_MAX_WIN_SCALE 14
 
-/* Max received bytes to buffer internally */
-#define NET_TCP_BUF_MAX_LEN 1280
+/* TCP extensions, enabled when both ends announce them in their SYN */
+#define NET_TCP_EXT_WSCALE BIT(0) /* Window scaling (RFC 7323) */
+#define NET_TCP_EXT_SACK   BIT(1) /* Selective ACKs (RFC 2018) */
+#define NET_TCP_EXT_TS     BIT(2) /* Timestamps (RFC 7323) */
 
 /* Max segment lifetime, in seconds */
 #define NET_TCP_MAX_SEG_LIFETIME 60
 
 struct net_context;
 
+/** Options of a received TCP segment */
+struct net_tcp_options {
+	/** Maximum segment size, 0 if absent */
+	u16_t mss;
+
+	/** Extensions whose option is present */
+	u8_t ext;
+
+	/** Window scale shift */
+	u8_t wscale;
+
+	/** Timestamp value */
+	u32_t tsval;
+
+	/** Timestamp echo reply */
+	u32_t tsecr;
+
+	/** Number of SACK blocks */
+	u8_t sack_blocks;
+
+	/** SACK blocks, each from the left edge to the byte after the
+	 * right edge
+	 */
+	struct {
+		u32_t left;
+		u32_t right;
+	} sack[NET_TCP_MAX_SACK_BLOCKS];
+};
+
 struct net_tcp {
 	/** Network context back pointer. */
 	struct net_context *context;
@@ -110,6 +152,11 @@ struct net_tcp {
 	/** List pointer used for TCP retransmit buffering */
 	sys_slist_t sent_list;
 
+	/** Received segments waiting for a hole to be filled, in
+	 * sequence number order
+	 */
+	sys_slist_t ooo_list;
+
 	/** Max acknowledgment. */
 	u32_t recv_max_ack;
 
@@ -122,6 +169,61 @@ struct net_tcp {
 	/** Last ACK value sent */
 	u32_t sent_ack;
 
+	/** Congestion window, in bytes (RFC 5681) */
+	u32_t cwnd;
+
+	/** Slow start threshold, in bytes */
+	u32_t ssthresh;
+
+	/** Highest sequence number sent when the loss recovery started
+	 * (RFC 6582)
+	 */
+	u32_t recover;
+
+	/** Smoothed round-trip time, in 1/8 ms (RFC 6298) */
+	u32_t srtt;
+
+	/** Round-trip time variation, in 1/4 ms */
+	u32_t rttvar;
+
+	/** Retransmission timeout, in ms */
+	u32_t rto;
+
+	/** Sequence number whose acknowledgment ends the RTT measurement */
+	u32_t rtt_seq;
+
+	/** Uptime, in ms, when the measured segment was sent */
+	u32_t rtt_start;
+
+	/** Send window advertised by the peer, in bytes */
+	u32_t send_wnd;
+
+	/** End of the last hole sent again during a fast recovery with
+	 * selective acknowledgments
+	 */
+	u32_t sack_next;
+
+	/** Last timestamp value received from the peer (RFC 7323) */
+	u32_t ts_recent;
+
+	/** Sequence number of the last segment put in ooo_list */
+	u32_t ooo_last;
+
+	/** MSS announced by the peer, 0 if none */
+	u16_t send_mss;
+
+	/** Extensions enabled for the connection, NET_TCP_EXT_* */
+	u8_t ext;
+
+	/** Window scale shift of the peer */
+	u8_t send_wscale;
+
+	/** Window scale shift of our advertised window */
+	u8_t recv_wscale;
+
+	/** Number of segments in ooo_list */
+	u8_t ooo_count;
+
 	/** Current retransmit period */
 	u32_t retry_timeout_shift : 5;
 	/** Flags for the TCP */
@@ -139,8 +241,12 @@ struct net_tcp {
 	 * of various timing issues when timer is scheduled to run.
 	 */
 	u32_t ack_timer_cancelled : 1;
+	/* Number of duplicate ACKs received in a row, up to 3 */
+	u32_t dup_acks : 2;
+	/* The round-trip time of a segment is being measured */
+	u32_t rtt_pending : 1;
 	/** Remaining bits in this u32_t */
-	u32_t _padding : 11;
+	u32_t _padding : 8;
 
 	/** Accept callback to be called when the connection has been
 	 * established.
@@ -232,10 +338,13 @@ int net_tcp_release(struct net_tcp *tcp);
  * is a ready made packet that can be sent via net_send_data()
  * function.
  *
+ * The options of the extensions enabled for the connection are added
+ * before the given options.
+ *
  * @param tcp TCP context
  * @param flags TCP flags
  * @param options Pointer TCP options, NULL if no options.
- * @param optlen Length of the options.
+ * @param optlen Length of the options, a multiple of 4.
  * @param local Source address, or NULL to use the local address of
  *        the TCP context
  * @param remote Peer address
@@ -315,9 +424,87 @@ int net_tcp_send_pkt(struct net_pkt *pkt);
  * @brief Handle a received TCP ACK
  *
  * @param cts Context
- * @param seq Received ACK sequence number
+ * @param pkt Received segment, with its appdata values set
+ * @param opts Options of the received segment
+ */
+void net_tcp_ack_received(struct net_context *ctx, struct net_pkt *pkt,
+			  const struct net_tcp_options *opts);
+
+/**
+ * @brief Parse the options of a received TCP segment
+ *
+ * @param pkt Received segment
+ * @param opts Options found in the segment
+ *
+ * @return 0 if ok, < 0 if the options are malformed
+ */
+int net_tcp_parse_opts(struct net_pkt *pkt, struct net_tcp_options *opts);
+
+/**
+ * @brief Enable the extensions announced in the SYN of the peer
+ *
+ * Records the window and the options of the SYN segment, and enables the
+ * extensions that both ends support.
+ *
+ * @param tcp TCP context
+ * @param pkt Received SYN segment
+ */
+void net_tcp_syn_received(struct net_tcp *tcp, struct net_pkt *pkt);
+
+/**
+ * @brief Check the timestamp of a received segment
+ *
+ * Rejects the old duplicate segments (PAWS, RFC 7323 section 5) and
+ * records the timestamp to echo to the peer.
+ *
+ * @param tcp TCP context
+ * @param pkt Received segment
+ * @param opts Options of the received segment
+ *
+ * @return true if the segment is acceptable, false otherwise
+ */
+bool net_tcp_check_ts(struct net_tcp *tcp, struct net_pkt *pkt,
+		      const struct net_tcp_options *opts);
+
+/**
+ * @brief Check the sequence number of a received segment
+ *
+ * The data already received at the front of a segment that overlaps
+ * the next expected byte is removed from the segment.
+ *
+ * @param tcp TCP context
+ * @param pkt Received segment, with its appdata values set
+ *
+ * @return 0 if the segment starts at the next expected byte, > 0 if it
+ * starts after it, < 0 if it holds no new data
+ */
+int net_tcp_check_seq(struct net_tcp *tcp, struct net_pkt *pkt);
+
+/**
+ * @brief Queue a segment received out of order
+ *
+ * A connection queues at most CONFIG_NET_TCP_OOO_QUEUE_LEN segments, and
+ * all the connections together hold at most half of the RX packets and
+ * of the RX data buffers. When the limit is reached, queued segments that
+ * come after the new one are dropped to make room for it, since the data
+ * closest to the hole is delivered first.
+ *
+ * @param tcp TCP context
+ * @param pkt Received segment, starting after the next expected byte
+ *
+ * @return 0 if the segment is queued, < 0 if it must be dropped
+ */
+int net_tcp_ooo_add(struct net_tcp *tcp, struct net_pkt *pkt);
+
+/**
+ * @brief Get the next in order segment out of the out of order queue
+ *
+ * @param tcp TCP context
+ *
+ * @return Segment that starts at the next expected byte, NULL if there
+ * is none
  */
-void net_tcp_ack_received(struct net_context *ctx, u32_t ack);
+struct net_pkt *net_tcp_ooo_get(struct net_tcp *tcp);
 
 /**
  * @brief Calculates and returns the MSS for a given TCP context
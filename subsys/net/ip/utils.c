@@ -373,32 +373,136 @@ int net_addr_pton(sa_family_t family, const char *src,
 	return 0;
 }
 
-static u16_t calc_chksum(u16_t sum, const u8_t *ptr, u16_t len)
+/* The checksum is computed on 16-bit words in memory order, that is in
+ * network byte order whatever the endianness of the CPU. The one's
+ * complement sum of these words is the sum of the big endian words with
+ * swapped bytes on a little endian CPU, so that the result can be stored
+ * in a header as is.
+ */
+typedef u16_t __may_alias chksum_u16_t;
+typedef u32_t __may_alias chksum_u32_t;
+
+static inline u16_t chksum_add(u16_t sum, u16_t value)
 {
-	u16_t tmp;
-	const u8_t *end;
+	u32_t res = sum + value;
 
-	end = ptr + len - 1;
+	return (res & 0xffff) + (res >> 16);
+}
 
-	while (ptr < end) {
-		tmp = (ptr[0] << 8) + ptr[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
-		ptr += 2;
+static inline u16_t chksum_fold(u64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return sum;
+}
+
+static inline u16_t chksum_swap(u16_t sum)
+{
+	return (sum << 8) | (sum >> 8);
+}
+
+#if defined(CONFIG_X86)
+static inline u64_t chksum_words(u64_t sum, const chksum_u32_t *ptr,
+				 u32_t count)
+{
+	u32_t blocks = count / 4;
+	u32_t res = 0;
+
+	/* The carries are added in the sum of the next word */
+	if (blocks) {
+		__asm__ ("clc\n\t"
+			 "1:\n\t"
+			 "adcl 0(%[ptr]), %[res]\n\t"
+			 "adcl 4(%[ptr]), %[res]\n\t"
+			 "adcl 8(%[ptr]), %[res]\n\t"
+			 "adcl 12(%[ptr]), %[res]\n\t"
+			 "lea 16(%[ptr]), %[ptr]\n\t"
+			 "decl %[blocks]\n\t"
+			 "jnz 1b\n\t"
+			 "adcl $0, %[res]\n\t"
+			 : [res] "+r" (res), [ptr] "+r" (ptr),
+			   [blocks] "+r" (blocks)
+			 :
+			 : "cc", "memory");
 	}
 
-	if (ptr == end) {
-		tmp = ptr[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	sum += res;
+
+	for (count %= 4; count; count--) {
+		sum += *ptr++;
 	}
 
 	return sum;
 }
+#else
+static inline u64_t chksum_words(u64_t sum, const chksum_u32_t *ptr,
+				 u32_t count)
+{
+	/* The carries are kept in the upper half of the sum, they are
+	 * added back when it is folded.
+	 */
+	for (; count >= 4; count -= 4) {
+		sum += ptr[0];
+		sum += ptr[1];
+		sum += ptr[2];
+		sum += ptr[3];
+		ptr += 4;
+	}
+
+	for (; count; count--) {
+		sum += *ptr++;
+	}
+
+	return sum;
+}
+#endif /* CONFIG_X86 */
+
+/* Return the one's complement sum of the 16-bit words of a buffer */
+static u16_t chksum_partial(const u8_t *ptr, u16_t len)
+{
+	bool odd = (uintptr_t)ptr & 1;
+	u64_t sum = 0;
+	u16_t res;
+
+	/* The words of a buffer starting on an odd address are summed from
+	 * the previous 16-bit boundary, which swaps the bytes of the sum.
+	 */
+	if (odd && len) {
+		sum = htons(*ptr);
+		ptr++;
+		len--;
+	}
+
+	if (((uintptr_t)ptr & 2) && len >= 2) {
+		sum += *(const chksum_u16_t *)ptr;
+		ptr += 2;
+		len -= 2;
+	}
+
+	sum = chksum_words(sum, (const chksum_u32_t *)ptr, len / 4);
+	ptr += len & ~3;
+
+	if (len & 2) {
+		sum += *(const chksum_u16_t *)ptr;
+		ptr += 2;
+	}
+
+	if (len & 1) {
+		sum += htons(*ptr << 8);
+	}
+
+	res = chksum_fold(sum);
+
+	return odd ? chksum_swap(res) : res;
+}
+
+static inline u16_t calc_chksum(u16_t sum, const u8_t *ptr, u16_t len)
+{
+	return chksum_add(sum, chksum_partial(ptr, len));
+}
 
 static inline u16_t calc_chksum_pkt(u16_t sum, struct net_pkt *pkt,
 				       u16_t upper_layer_len)
@@ -408,6 +512,7 @@ static inline u16_t calc_chksum_pkt(u16_t sum, struct net_pkt *pkt,
 		net_pkt_ipv6_ext_len(pkt);
 	s16_t len = frag->len - proto_len;
 	u8_t *ptr = frag->data + proto_len;
+	bool odd = false;
 
 	ARG_UNUSED(upper_layer_len);
 
@@ -418,26 +523,21 @@ static inline u16_t calc_chksum_pkt(u16_t sum, struct net_pkt *pkt,
 	}
 
 	while (frag) {
-		sum = calc_chksum(sum, ptr, len);
+		u16_t part = chksum_partial(ptr, len);
+
+		/* After an odd number of bytes, the bytes of a fragment are
+		 * at the other position in the words of the checksum.
+		 */
+		sum = chksum_add(sum, odd ? chksum_swap(part) : part);
+		odd ^= len & 1;
+
 		frag = frag->frags;
 		if (!frag) {
 			break;
 		}
 
 		ptr = frag->data;
-
-		/* Do we need to take first byte from next fragment */
-		if (len % 2) {
-			u16_t tmp = *ptr;
-			sum += tmp;
-			if (sum < tmp) {
-				sum++;
-			}
-			len = frag->len - 1;
-			ptr++;
-		} else {
-			len = frag->len;
-		}
+		len = frag->len;
 	}
 
 	return sum;
@@ -457,11 +557,12 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 			net_pkt_ip_hdr_len(pkt);
 
 		if (proto == IPPROTO_ICMP) {
-			return htons(calc_chksum(0, net_pkt_ip_data(pkt) +
-						 net_pkt_ip_hdr_len(pkt),
-						 upper_layer_len));
+			return calc_chksum(0, net_pkt_ip_data(pkt) +
+					   net_pkt_ip_hdr_len(pkt),
+					   upper_layer_len);
 		} else {
-			sum = calc_chksum(upper_layer_len + proto,
+			sum = calc_chksum(chksum_add(htons(upper_layer_len),
+						     htons(proto)),
 					  (u8_t *)&NET_IPV4_HDR(pkt)->src,
 					  2 * sizeof(struct in_addr));
 		}
@@ -471,7 +572,8 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 	case AF_INET6:
 		upper_layer_len = (NET_IPV6_HDR(pkt)->len[0] << 8) +
 			NET_IPV6_HDR(pkt)->len[1] - net_pkt_ipv6_ext_len(pkt);
-		sum = calc_chksum(upper_layer_len + proto,
+		sum = calc_chksum(chksum_add(htons(upper_layer_len),
+					     htons(proto)),
 				  (u8_t *)&NET_IPV6_HDR(pkt)->src,
 				  2 * sizeof(struct in6_addr));
 		break;
@@ -483,7 +585,7 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 
 	sum = calc_chksum_pkt(sum, pkt, upper_layer_len);
 
-	sum = (sum == 0) ? 0xffff : htons(sum);
+	sum = (sum == 0) ? 0xffff : sum;
 
 	return sum;
 }
@@ -495,8 +597,20 @@ u16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
 
 	sum = calc_chksum(0, (u8_t *)NET_IPV4_HDR(pkt), NET_IPV4H_LEN);
 
-	sum = (sum == 0) ? 0xffff : htons(sum);
+	sum = (sum == 0) ? 0xffff : sum;
 
 	return sum;
 }
 #endif /* CONFIG_NET_IPV4 */
+
+u16_t net_chksum_update(u16_t chksum, const void *old_data,
+			const void *new_data, u16_t len)
+{
+	u16_t sum;
+
+	/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+	sum = chksum_add(~chksum, ~chksum_partial(old_data, len));
+	sum = chksum_add(sum, chksum_partial(new_data, len));
+
+	return ~sum;
+}
@@ -67,6 +67,104 @@ static int shell_cmd_tasks(int argc, char *argv[])
 }
 #endif
 
+#if defined(CONFIG_OBJECT_TRACING) && defined(CONFIG_THREAD_MONITOR) && \
+	defined(CONFIG_THREAD_RUNTIME_STATS)
+#define TOP_THREADS 10
+
+struct thread_usage {
+	struct k_thread *thread;
+	u64_t runtime;
+};
+
+static u32_t cycles_to_ms(u64_t cycles)
+{
+	return (u32_t)(cycles * MSEC_PER_SEC / sys_clock_hw_cycles_per_sec);
+}
+
+static u32_t permille(u64_t part, u64_t total)
+{
+	return total ? (u32_t)(part * 1000 / total) : 0;
+}
+
+static int shell_cmd_top(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	struct thread_usage top[TOP_THREADS];
+	struct k_thread *thread_list = NULL;
+	struct k_cpu_stats stats;
+	u64_t total;
+	int num = 0;
+	int i;
+
+	k_cpu_stats_get(&stats);
+	total = stats.busy_cycles + stats.idle_cycles;
+
+	/* keep the threads with the highest runtime, in decreasing order */
+	thread_list   = (struct k_thread *)SYS_THREAD_MONITOR_HEAD;
+	while (thread_list != NULL) {
+		u64_t runtime = k_thread_runtime_get(thread_list);
+
+		for (i = num; i > 0 && top[i - 1].runtime < runtime; i--) {
+			if (i < TOP_THREADS) {
+				top[i] = top[i - 1];
+			}
+		}
+
+		if (i < TOP_THREADS) {
+			top[i].thread = thread_list;
+			top[i].runtime = runtime;
+			num = min(num + 1, TOP_THREADS);
+		}
+
+		thread_list = (struct k_thread *)SYS_THREAD_MONITOR_NEXT(thread_list);
+	}
+
+	printk("cpu: busy %u ms (%u.%u%%), idle %u ms\n",
+	       cycles_to_ms(stats.busy_cycles),
+	       permille(stats.busy_cycles, total) / 10,
+	       permille(stats.busy_cycles, total) % 10,
+	       cycles_to_ms(stats.idle_cycles));
+
+	for (i = 0; i < num; i++) {
+		u32_t usage = permille(top[i].runtime, total);
+
+		printk("%s%p:   priority: %d runtime: %u ms (%u.%u%%)\n",
+		       (top[i].thread == k_current_get()) ? "*" : " ",
+		       top[i].thread,
+		       k_thread_priority_get(top[i].thread),
+		       cycles_to_ms(top[i].runtime), usage / 10, usage % 10);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SYS_CLOCK_WAKEUP_STATS)
+static u32_t per_sec(u32_t count, u32_t ms)
+{
+	return ms ? (u32_t)((u64_t)count * MSEC_PER_SEC / ms) : 0;
+}
+
+static int shell_cmd_wakeups(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	struct k_wakeup_stats stats;
+	u32_t uptime = k_uptime_get_32();
+
+	k_wakeup_stats_get(&stats);
+
+	printk("clock interrupts: %u (%u/s)\n", stats.announcements,
+	       per_sec(stats.announcements, uptime));
+	printk("idle wakeups:     %u (%u/s)\n", stats.idle_wakeups,
+	       per_sec(stats.idle_wakeups, uptime));
+	printk("expirations:      %u (%u/s), %u timeouts\n", stats.expirations,
+	       per_sec(stats.expirations, uptime), stats.timeouts);
+
+	return 0;
+}
+#endif
 
 #if defined(CONFIG_INIT_STACKS)
 static int shell_cmd_stack(int argc, char *argv[])
@@ -83,6 +181,13 @@ struct shell_cmd kernel_commands[] = {
 #if defined(CONFIG_OBJECT_TRACING) && defined(CONFIG_THREAD_MONITOR)
 	{ "tasks", shell_cmd_tasks, "show running tasks" },
 #endif
+#if defined(CONFIG_OBJECT_TRACING) && defined(CONFIG_THREAD_MONITOR) && \
+	defined(CONFIG_THREAD_RUNTIME_STATS)
+	{ "top", shell_cmd_top, "show cpu usage of the busiest tasks" },
+#endif
+#if defined(CONFIG_SYS_CLOCK_WAKEUP_STATS)
+	{ "wakeups", shell_cmd_wakeups, "show system clock wakeups" },
+#endif
 #if defined(CONFIG_INIT_STACKS)
 	{ "stacks", shell_cmd_stack, "show system stacks" },
 #endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure byte ring throughput
+ *
+ * Compares the time to put and get chunks of data through a word based
+ * ring buffer protected by irq_lock() and through a byte ring, by copy and
+ * in place, then measures a byte ring filled from an ISR and drained by a
+ * thread.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <string.h>
+#include <irq_offload.h>
+#include <misc/ring_buffer.h>
+#include <misc/byte_ring.h>
+#include "timestamp.h"
+
+#define RING_POW 10
+#define RING_SIZE (1 << RING_POW)
+#define MAX_CHUNK 256
+
+#define NUM_RUNS 100
+
+#define STACK_SIZE 512
+#define CONSUMER_PRIO K_PRIO_PREEMPT(5)
+#define ISR_CHUNK 64
+#define ISR_BYTES (64 * 1024)
+
+u32_t tm_off;
+
+SYS_RING_BUF_DECLARE_POW2(ring_buf, RING_POW - 2);
+SYS_BYTE_RING_DECLARE_POW2(byte_ring, RING_POW);
+
+static u32_t __aligned(4) tx_buf[MAX_CHUNK / 4];
+static u32_t __aligned(4) rx_buf[MAX_CHUNK / 4];
+
+static char __noinit __stack consumer_stack[STACK_SIZE];
+static K_SEM_DEFINE(done_sema, 0, 1);
+
+static const u32_t sizes[] = { 4, 16, 64, 256 };
+
+enum method {
+	RING_BUF,
+	BYTE_RING,
+	BYTE_RING_IN_PLACE,
+};
+
+static void transfer(enum method method, u32_t size)
+{
+	unsigned int key;
+	u8_t size32;
+	u8_t *region;
+	u32_t n;
+	u16_t type;
+	u8_t value;
+
+	switch (method) {
+	case RING_BUF:
+		key = irq_lock();
+		sys_ring_buf_put(&ring_buf, 0, 0, tx_buf, size / 4);
+		irq_unlock(key);
+
+		size32 = size / 4;
+		key = irq_lock();
+		sys_ring_buf_get(&ring_buf, &type, &value, rx_buf, &size32);
+		irq_unlock(key);
+		break;
+	case BYTE_RING:
+		sys_byte_ring_put(&byte_ring, (u8_t *)tx_buf, size);
+		sys_byte_ring_get(&byte_ring, (u8_t *)rx_buf, size);
+		break;
+	case BYTE_RING_IN_PLACE:
+		/* fill and drain the regions, which may wrap around */
+		for (n = 0; n < size; ) {
+			u32_t len = sys_byte_ring_put_claim(&byte_ring, &region,
+							    size - n);
+
+			memcpy(region, (u8_t *)tx_buf + n, len);
+			n += len;
+		}
+		sys_byte_ring_put_commit(&byte_ring, size);
+
+		for (n = 0; n < size; ) {
+			u32_t len = sys_byte_ring_get_claim(&byte_ring, &region,
+							    size - n);
+
+			memcpy((u8_t *)rx_buf + n, region, len);
+			n += len;
+		}
+		sys_byte_ring_get_commit(&byte_ring, size);
+		break;
+	}
+}
+
+static u32_t measure(enum method method, u32_t size)
+{
+	u32_t ts, cycles = 0;
+	int i;
+
+	for (i = 0; i < NUM_RUNS; i++) {
+		ts = TIME_STAMP_DELTA_GET(0);
+		transfer(method, size);
+		cycles += TIME_STAMP_DELTA_GET(ts);
+	}
+
+	return cycles / NUM_RUNS;
+}
+
+static void isr_producer(void *arg)
+{
+	u32_t *sent = arg;
+
+	*sent += sys_byte_ring_put(&byte_ring, (u8_t *)tx_buf, ISR_CHUNK);
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	u32_t received = 0;
+	u8_t *region;
+	u32_t len;
+
+	while (received < ISR_BYTES) {
+		sys_byte_ring_wait(&byte_ring, K_FOREVER);
+
+		while ((len = sys_byte_ring_get_claim(&byte_ring, &region,
+						      RING_SIZE))) {
+			sys_byte_ring_get_commit(&byte_ring, len);
+			received += len;
+		}
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void measure_isr_to_thread(void)
+{
+	u32_t sent = 0;
+	u32_t cycles;
+
+	sys_byte_ring_init(&byte_ring, RING_SIZE, byte_ring.buf);
+
+	/* the consumer runs right away and waits for data */
+	k_thread_spawn(consumer_stack, STACK_SIZE, consumer, NULL, NULL, NULL,
+		       CONSUMER_PRIO, 0, 0);
+
+	cycles = k_cycle_get_32();
+	while (sent < ISR_BYTES) {
+		irq_offload(isr_producer, &sent);
+	}
+	k_sem_take(&done_sema, K_FOREVER);
+	cycles = k_cycle_get_32() - cycles;
+
+	TC_PRINT("ISR to thread: %u bytes in chunks of %u bytes, %u KB/s\n",
+		 ISR_BYTES, ISR_CHUNK,
+		 (u32_t)((u64_t)ISR_BYTES * sys_clock_hw_cycles_per_sec /
+			 cycles / 1024));
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("Byte ring benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	/* misalign the byte ring so that in place transfers wrap around */
+	sys_byte_ring_put(&byte_ring, (u8_t *)tx_buf, 3);
+	sys_byte_ring_get(&byte_ring, (u8_t *)rx_buf, 3);
+
+	for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+		TC_PRINT(" put + get %3u bytes: ring buffer %4u tcs, "
+			 "byte ring %4u tcs, in place %4u tcs\n", sizes[i],
+			 measure(RING_BUF, sizes[i]),
+			 measure(BYTE_RING, sizes[i]),
+			 measure(BYTE_RING_IN_PLACE, sizes[i]));
+	}
+
+	k_thread_priority_set(k_current_get(), CONSUMER_PRIO + 1);
+	measure_isr_to_thread();
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
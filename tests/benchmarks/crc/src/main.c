@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure CRC throughput
+ *
+ * Measures the number of bytes each CRC function processes per thousand
+ * timer clock cycles, over a short packet and a flash image chunk.
+ *
+ * Build with prj.conf for the 256-entry tables, prj_bitwise.conf for the
+ * bitwise computation and prj_slice_by_4.conf for slice-by-4.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <crc16.h>
+#include <crc32.h>
+#include "timestamp.h"
+
+#define BUF_SIZE 1024
+#define NUM_RUNS 16
+
+u32_t tm_off;
+
+static u8_t buf[BUF_SIZE];
+
+static const size_t lengths[] = { 64, BUF_SIZE };
+
+static volatile u32_t sink;
+
+static u32_t run_crc16_ccitt(size_t len)
+{
+	return crc16_ccitt(buf, len);
+}
+
+static u32_t run_crc16_ansi(size_t len)
+{
+	return crc16_ansi(buf, len);
+}
+
+static u32_t run_crc32_ieee(size_t len)
+{
+	return crc32_ieee(buf, len);
+}
+
+static u32_t run_crc32c(size_t len)
+{
+	return crc32c(buf, len);
+}
+
+static const struct {
+	const char *name;
+	u32_t (*fn)(size_t len);
+} crcs[] = {
+	{ "crc16_ccitt", run_crc16_ccitt },
+	{ "crc16_ansi", run_crc16_ansi },
+	{ "crc32_ieee", run_crc32_ieee },
+	{ "crc32c", run_crc32c },
+};
+
+static void measure(int crc, size_t len)
+{
+	u32_t ts, cycles = 0;
+	int i;
+
+	for (i = 0; i < NUM_RUNS; i++) {
+		ts = TIME_STAMP_DELTA_GET(0);
+		sink = crcs[crc].fn(len);
+		cycles += TIME_STAMP_DELTA_GET(ts);
+	}
+
+	if (cycles == 0) {
+		cycles = 1;
+	}
+
+	TC_PRINT(" %s, %4u bytes: %6u tcs = %8u nsec, %u bytes/ktcs\n",
+		 crcs[crc].name, len, cycles / NUM_RUNS,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles, NUM_RUNS),
+		 (u32_t)((u64_t)len * NUM_RUNS * 1000 / cycles));
+}
+
+void main(void)
+{
+	int i, j;
+
+	TC_START("CRC benchmark");
+
+	bench_test_init();
+
+#if defined(CONFIG_CRC_BITWISE)
+	TC_PRINT("CRC computation: bitwise\n");
+#elif defined(CONFIG_CRC_SLICE_BY_4)
+	TC_PRINT("CRC computation: slice-by-4 tables\n");
+#else
+	TC_PRINT("CRC computation: 256-entry table\n");
+#endif
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	for (i = 0; i < BUF_SIZE; i++) {
+		buf[i] = i * 7 + (i >> 8);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(crcs); i++) {
+		for (j = 0; j < ARRAY_SIZE(lengths); j++) {
+			measure(i, lengths[j]);
+		}
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
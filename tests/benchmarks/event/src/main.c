@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Compare an event object with k_poll() on a signal per condition
+ *
+ * A high priority thread waits for any, or all, of 4 conditions that the
+ * low priority main thread sets one at a time. The conditions are the
+ * events of an event object, or poll signals the thread polls on.
+ *
+ * When waiting for any condition, measures the time from setting the
+ * condition to the waiting thread running. When waiting for all of them,
+ * measures the time to set them all, including the wakeups of the
+ * waiting thread, and counts these wakeups.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define STACK_SIZE 512
+#define NUM_CONDS 4
+#define NUM_ROUNDS 500
+
+#define ALL_CONDS (BIT(NUM_CONDS) - 1)
+
+#define MAIN_PRIO K_PRIO_PREEMPT(10)
+#define WAITER_PRIO K_PRIO_PREEMPT(5)
+
+u32_t tm_off;
+
+static char __noinit __stack waiter_stack[STACK_SIZE];
+
+static K_EVENT_DEFINE(bench_event);
+static struct k_poll_signal signals[NUM_CONDS];
+static struct k_poll_event events[NUM_CONDS];
+
+static K_SEM_DEFINE(done_sema, 0, 1);
+
+static volatile u32_t set_ts;
+static u32_t cycles;
+static u32_t wakeups;
+
+static void event_any_waiter(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		k_event_wait(&bench_event, ALL_CONDS, K_EVENT_WAIT_CLEAR,
+			     K_FOREVER);
+		cycles += TIME_STAMP_DELTA_GET(set_ts);
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static u32_t poll_for_conds(void)
+{
+	u32_t conds = 0;
+	int i;
+
+	k_poll(events, NUM_CONDS, K_FOREVER);
+
+	for (i = 0; i < NUM_CONDS; i++) {
+		if (events[i].state == K_POLL_STATE_SIGNALED) {
+			signals[i].signaled = 0;
+			events[i].state = K_POLL_STATE_NOT_READY;
+			conds |= BIT(i);
+		}
+	}
+
+	return conds;
+}
+
+static void poll_any_waiter(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		poll_for_conds();
+		cycles += TIME_STAMP_DELTA_GET(set_ts);
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void event_all_waiter(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		k_event_wait(&bench_event, ALL_CONDS,
+			     K_EVENT_WAIT_ALL | K_EVENT_WAIT_CLEAR, K_FOREVER);
+		wakeups++;
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void poll_all_waiter(void *p1, void *p2, void *p3)
+{
+	u32_t conds;
+	int i;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		conds = 0;
+		while (conds != ALL_CONDS) {
+			conds |= poll_for_conds();
+			wakeups++;
+		}
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void set_cond(int use_event, int i)
+{
+	if (use_event) {
+		k_event_post(&bench_event, BIT(i));
+	} else {
+		k_poll_signal(&signals[i], 0);
+	}
+}
+
+static void run(const char *name, int use_event, int wait_all,
+		k_thread_entry_t waiter)
+{
+	u32_t ts, set_cycles = 0;
+	int i, j;
+
+	cycles = 0;
+	wakeups = 0;
+
+	for (i = 0; i < NUM_CONDS; i++) {
+		k_poll_signal_init(&signals[i]);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &signals[i]);
+	}
+
+	/* the waiter runs right away and waits */
+	k_thread_spawn(waiter_stack, STACK_SIZE, waiter, NULL, NULL, NULL,
+		       WAITER_PRIO, 0, 0);
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		if (wait_all) {
+			ts = TIME_STAMP_DELTA_GET(0);
+			for (j = 0; j < NUM_CONDS; j++) {
+				set_cond(use_event, j);
+			}
+			set_cycles += TIME_STAMP_DELTA_GET(ts);
+		} else {
+			set_ts = TIME_STAMP_DELTA_GET(0);
+			set_cond(use_event, i % NUM_CONDS);
+		}
+	}
+
+	k_sem_take(&done_sema, K_FOREVER);
+
+	if (wait_all) {
+		TC_PRINT(" all, %s: set %u tcs = %u nsec, %u.%02u wakeups\n",
+			 name, set_cycles / NUM_ROUNDS,
+			 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(set_cycles, NUM_ROUNDS),
+			 wakeups / NUM_ROUNDS, wakeups * 100 / NUM_ROUNDS % 100);
+	} else {
+		TC_PRINT(" any, %s: wakeup %u tcs = %u nsec\n", name,
+			 cycles / NUM_ROUNDS,
+			 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles, NUM_ROUNDS));
+	}
+}
+
+void main(void)
+{
+	TC_START("Event benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+	TC_PRINT("Wait for %d conditions, %d rounds\n", NUM_CONDS, NUM_ROUNDS);
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	run("k_event", 1, 0, event_any_waiter);
+	run("k_poll ", 0, 0, poll_any_waiter);
+	run("k_event", 1, 1, event_all_waiter);
+	run("k_poll ", 0, 1, poll_all_waiter);
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file measure preemptive context switch time at various priorities
+ *
+ * A thread gives a semaphore to a thread of the next higher priority, which
+ * preempts it, takes the semaphore again and pends, switching back to the
+ * giving thread. Finding the next thread to run after the pend must look up
+ * the priority of the giving thread in the ready queue bitmaps, so the pair
+ * of threads is placed at the highest, middle and lowest application
+ * priorities. Build with prj_many_prio.conf to measure with the largest
+ * number of priorities.
+ */
+
+#include "timestamp.h"
+#include "utils.h"
+
+/* number of give/take round trips, each one switches context twice */
+#define NB_OF_ROUND_TRIPS 1000
+
+#ifndef STACKSIZE
+#define STACKSIZE 512
+#endif
+
+static char __stack woken_stack[STACKSIZE];
+
+static K_SEM_DEFINE(wake_sema, 0, 1);
+
+static volatile u32_t woken;
+
+static void woken_thread(void *arg1, void *arg2, void *arg3)
+{
+	while (woken < NB_OF_ROUND_TRIPS) {
+		k_sem_take(&wake_sema, K_FOREVER);
+		woken++;
+	}
+}
+
+static void measure_at_prio(int prio)
+{
+	int orig_prio = k_thread_priority_get(k_current_get());
+	u32_t timestamp;
+	int i;
+
+	woken = 0;
+
+	/* the woken thread runs right away and pends on the semaphore */
+	k_thread_priority_set(k_current_get(), prio + 1);
+	k_thread_spawn(woken_stack, STACKSIZE, woken_thread, NULL, NULL, NULL,
+		       prio, 0, K_NO_WAIT);
+
+	bench_test_start();
+
+	timestamp = TIME_STAMP_DELTA_GET(0);
+	for (i = 0; i < NB_OF_ROUND_TRIPS; i++) {
+		k_sem_give(&wake_sema);
+	}
+	timestamp = TIME_STAMP_DELTA_GET(timestamp);
+
+	k_thread_priority_set(k_current_get(), orig_prio);
+
+	if (bench_test_end() < 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	} else if (woken != NB_OF_ROUND_TRIPS) {
+		error_count++;
+		PRINT_FORMAT(" Error, woken %u times, expected %u",
+			     woken, NB_OF_ROUND_TRIPS);
+	} else {
+		PRINT_FORMAT(" Prio %3d: average give + 2 context switches "
+			     "%u tcs = %u nsec", prio,
+			     timestamp / NB_OF_ROUND_TRIPS,
+			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp,
+							   NB_OF_ROUND_TRIPS));
+	}
+}
+
+/**
+ *
+ * @brief Entry point for the preemptive context switch test
+ *
+ * @return N/A
+ */
+void prio_ctx_switch(void)
+{
+	int lowest = K_LOWEST_APPLICATION_THREAD_PRIO - 1;
+
+	PRINT_FORMAT(" 7 - Measure average preemptive context switch time at "
+		     "various priorities");
+	PRINT_FORMAT(" %d priorities", K_LOWEST_THREAD_PRIO -
+		     K_HIGHEST_THREAD_PRIO + 1);
+
+	measure_at_prio(0);
+	measure_at_prio(lowest / 2);
+	measure_at_prio(lowest);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Compare heap allocators on an allocation trace
+ *
+ * Replays the trace in trace.c through k_malloc()/k_free(), timing every
+ * operation, and reports the heap footprint and the latency distribution.
+ *
+ * Build with prj.conf for the memory pool heap and with prj_tlsf.conf for
+ * the Two-Level Segregated Fit heap.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+#include "trace.h"
+
+#define MAX_OPS 1500
+
+u32_t tm_off;
+
+static void *slots[TRACE_SLOTS];
+static u16_t slot_sizes[TRACE_SLOTS];
+
+static u32_t malloc_times[MAX_OPS];
+static u32_t free_times[MAX_OPS];
+
+static void sort(u32_t *a, int n)
+{
+	int i, j;
+
+	for (i = 1; i < n; i++) {
+		u32_t v = a[i];
+
+		for (j = i; j > 0 && a[j - 1] > v; j--) {
+			a[j] = a[j - 1];
+		}
+		a[j] = v;
+	}
+}
+
+static void report(const char *what, u32_t *times, int n)
+{
+	u32_t total = 0, p99, worst;
+	int i;
+
+	if (n == 0) {
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		total += times[i];
+	}
+
+	sort(times, n);
+	p99 = times[n * 99 / 100];
+	worst = times[n - 1];
+
+	TC_PRINT(" %s: average %u tcs = %u nsec\n", what, total / n,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(total, n));
+	TC_PRINT(" %s: p99 %u tcs = %u nsec, worst %u tcs = %u nsec\n", what,
+		 p99, SYS_CLOCK_HW_CYCLES_TO_NS(p99),
+		 worst, SYS_CLOCK_HW_CYCLES_TO_NS(worst));
+}
+
+void main(void)
+{
+	struct k_malloc_stats stats;
+	size_t requested = 0, max_requested = 0;
+	int num_malloc = 0, num_free = 0, failures = 0;
+	int status = TC_PASS;
+	u32_t ts;
+	int i;
+
+	TC_START("Heap benchmark");
+
+	bench_test_init();
+
+#ifdef CONFIG_HEAP_TLSF
+	TC_PRINT("Heap: Two-Level Segregated Fit\n");
+#else
+	TC_PRINT("Heap: memory pool\n");
+#endif
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	if (trace_len > MAX_OPS) {
+		TC_ERROR(" Trace too long: %d operations\n", trace_len);
+		TC_END_RESULT(TC_FAIL);
+		TC_END_REPORT(TC_FAIL);
+		return;
+	}
+
+	for (i = 0; i < trace_len; i++) {
+		const struct trace_op *op = &trace[i];
+
+		if (op->size) {
+			ts = TIME_STAMP_DELTA_GET(0);
+			slots[op->slot] = k_malloc(op->size);
+			malloc_times[num_malloc++] = TIME_STAMP_DELTA_GET(ts);
+
+			if (!slots[op->slot]) {
+				failures++;
+				continue;
+			}
+
+			slot_sizes[op->slot] = op->size;
+			requested += op->size;
+			max_requested = max(max_requested, requested);
+		} else if (slots[op->slot]) {
+			ts = TIME_STAMP_DELTA_GET(0);
+			k_free(slots[op->slot]);
+			free_times[num_free++] = TIME_STAMP_DELTA_GET(ts);
+
+			slots[op->slot] = NULL;
+			requested -= slot_sizes[op->slot];
+		}
+	}
+
+	k_malloc_stats_get(&stats);
+
+	TC_PRINT(" %d operations replayed, %d allocations failed\n",
+		 trace_len, failures);
+	TC_PRINT(" Peak footprint: %u bytes for %u bytes requested\n",
+		 stats.max_used_bytes, max_requested);
+	TC_PRINT(" After replay: %u bytes free, largest free block %u bytes\n",
+		 stats.free_bytes, stats.largest_free_block);
+
+	report("k_malloc", malloc_times, num_malloc);
+	report("k_free", free_times, num_free);
+
+	if (stats.used_bytes != 0) {
+		TC_ERROR(" %u bytes leaked\n", stats.used_bytes);
+		status = TC_FAIL;
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
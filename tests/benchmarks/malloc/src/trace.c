@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Heap allocation trace replayed by the heap benchmark
+ *
+ * Synthetic trace shaped after a small connected device serving six
+ * concurrent clients, sixty requests in total. Each request allocates a
+ * 96 byte connection context and a receive buffer (128 to 1460 bytes),
+ * parses it into 4 to 12 JSON tokens (8 to 40 bytes each), frees the
+ * receive buffer, sometimes publishes an MQTT message (24 to 64 byte topic,
+ * 16 to 512 byte payload), builds a 180 to 1200 byte response and then
+ * frees everything. The steps of the concurrent requests are interleaved
+ * randomly, with a fixed seed.
+ *
+ * Each entry either allocates size bytes into a slot, or frees the slot
+ * when size is zero.
+ */
+
+#include "trace.h"
+
+const struct trace_op trace[] = {
+	{ 0, 96 }, { 1, 96 }, { 2, 96 }, { 3, 256 }, { 4, 96 },
+	{ 5, 96 }, { 6, 96 }, { 7, 128 }, { 8, 1330 }, { 9, 256 },
+	{ 10, 512 }, { 11, 20 }, { 12, 25 }, { 13, 40 }, { 14, 14 },
+	{ 15, 39 }, { 16, 512 }, { 17, 12 }, { 18, 16 }, { 19, 11 },
+	{ 20, 23 }, { 21, 36 }, { 22, 15 }, { 23, 12 }, { 24, 21 },
+	{ 25, 31 }, { 26, 30 }, { 27, 12 }, { 28, 12 }, { 29, 27 },
+	{ 30, 28 }, { 31, 15 }, { 32, 32 }, { 33, 19 }, { 34, 34 },
+	{ 35, 17 }, { 36, 28 }, { 37, 12 }, { 38, 31 }, { 8, 0 },
+	{ 8, 59 }, { 39, 95 }, { 40, 37 }, { 41, 32 }, { 42, 39 },
+	{ 43, 17 }, { 44, 24 }, { 45, 11 }, { 8, 0 }, { 8, 40 },
+	{ 46, 38 }, { 47, 36 }, { 48, 26 }, { 49, 13 }, { 50, 15 },
+	{ 51, 10 }, { 52, 24 }, { 9, 0 }, { 9, 448 }, { 53, 23 },
+	{ 39, 0 }, { 17, 0 }, { 18, 0 }, { 18, 18 }, { 17, 18 },
+	{ 16, 0 }, { 20, 0 }, { 21, 0 }, { 3, 0 }, { 3, 1194 },
+	{ 21, 30 }, { 20, 36 }, { 11, 0 }, { 11, 917 }, { 10, 0 },
+	{ 10, 570 }, { 22, 0 }, { 43, 0 }, { 12, 0 }, { 13, 0 },
+	{ 30, 0 }, { 30, 900 }, { 31, 0 }, { 25, 0 }, { 15, 0 },
+	{ 46, 0 }, { 7, 0 }, { 52, 0 }, { 37, 0 }, { 9, 0 },
+	{ 27, 0 }, { 27, 227 }, { 14, 0 }, { 4, 0 }, { 23, 0 },
+	{ 23, 96 }, { 32, 0 }, { 19, 0 }, { 34, 0 }, { 34, 512 },
+	{ 24, 0 }, { 36, 0 }, { 36, 38 }, { 44, 0 }, { 49, 0 },
+	{ 29, 0 }, { 50, 0 }, { 8, 0 }, { 20, 0 }, { 51, 0 },
+	{ 26, 0 }, { 10, 0 }, { 5, 0 }, { 53, 0 }, { 3, 0 },
+	{ 3, 13 }, { 53, 96 }, { 33, 0 }, { 35, 0 }, { 0, 0 },
+	{ 28, 0 }, { 41, 0 }, { 41, 40 }, { 28, 512 }, { 0, 96 },
+	{ 38, 0 }, { 48, 0 }, { 18, 0 }, { 18, 26 }, { 30, 0 },
+	{ 30, 128 }, { 11, 0 }, { 11, 37 }, { 48, 14 }, { 40, 0 },
+	{ 6, 0 }, { 2, 0 }, { 2, 18 }, { 6, 96 }, { 40, 11 },
+	{ 38, 21 }, { 35, 96 }, { 33, 17 }, { 5, 512 }, { 42, 0 },
+	{ 42, 21 }, { 10, 256 }, { 26, 12 }, { 51, 38 }, { 45, 0 },
+	{ 47, 0 }, { 34, 0 }, { 34, 37 }, { 47, 13 }, { 45, 15 },
+	{ 20, 41 }, { 8, 425 }, { 50, 13 }, { 30, 0 }, { 17, 0 },
+	{ 20, 0 }, { 20, 36 }, { 17, 1130 }, { 30, 8 }, { 29, 17 },
+	{ 48, 0 }, { 8, 0 }, { 2, 0 }, { 21, 0 }, { 21, 14 },
+	{ 38, 0 }, { 38, 9 }, { 28, 0 }, { 28, 43 }, { 2, 244 },
+	{ 33, 0 }, { 28, 0 }, { 28, 924 }, { 36, 0 }, { 17, 0 },
+	{ 17, 14 }, { 0, 0 }, { 3, 0 }, { 3, 96 }, { 2, 0 },
+	{ 41, 0 }, { 41, 658 }, { 2, 12 }, { 27, 0 }, { 18, 0 },
+	{ 18, 9 }, { 27, 1301 }, { 1, 0 }, { 1, 96 }, { 40, 0 },
+	{ 40, 22 }, { 0, 25 }, { 36, 22 }, { 33, 31 }, { 8, 20 },
+	{ 5, 0 }, { 11, 0 }, { 42, 0 }, { 26, 0 }, { 26, 768 },
+	{ 42, 26 }, { 11, 9 }, { 5, 40 }, { 34, 0 }, { 34, 182 },
+	{ 48, 27 }, { 45, 0 }, { 20, 0 }, { 20, 27 }, { 41, 0 },
+	{ 53, 0 }, { 53, 27 }, { 41, 16 }, { 45, 12 }, { 49, 20 },
+	{ 44, 96 }, { 24, 128 }, { 19, 13 }, { 50, 0 }, { 27, 0 },
+	{ 51, 0 }, { 51, 14 }, { 28, 0 }, { 29, 0 }, { 29, 12 },
+	{ 28, 24 }, { 27, 17 }, { 50, 36 }, { 32, 861 }, { 38, 0 },
+	{ 38, 13 }, { 4, 27 }, { 14, 31 }, { 17, 0 }, { 23, 0 },
+	{ 23, 96 }, { 17, 21 }, { 2, 0 }, { 2, 39 }, { 9, 512 },
+	{ 40, 0 }, { 40, 28 }, { 37, 38 }, { 52, 17 }, { 18, 0 },
+	{ 10, 0 }, { 0, 0 }, { 24, 0 }, { 24, 14 }, { 0, 486 },
+	{ 10, 480 }, { 18, 18 }, { 28, 0 }, { 50, 0 }, { 36, 0 },
+	{ 36, 30 }, { 38, 0 }, { 17, 0 }, { 17, 28 }, { 8, 0 },
+	{ 33, 0 }, { 42, 0 }, { 42, 34 }, { 11, 0 }, { 34, 0 },
+	{ 47, 0 }, { 30, 0 }, { 5, 0 }, { 0, 0 }, { 35, 0 },
+	{ 35, 11 }, { 0, 19 }, { 5, 96 }, { 30, 8 }, { 47, 35 },
+	{ 34, 17 }, { 11, 33 }, { 21, 0 }, { 44, 0 }, { 53, 0 },
+	{ 53, 11 }, { 9, 0 }, { 9, 256 }, { 49, 0 }, { 20, 0 },
+	{ 20, 18 }, { 49, 96 }, { 32, 0 }, { 3, 0 }, { 45, 0 },
+	{ 45, 96 }, { 3, 512 }, { 19, 0 }, { 19, 881 }, { 32, 128 },
+	{ 51, 0 }, { 29, 0 }, { 52, 0 }, { 52, 32 }, { 29, 15 },
+	{ 51, 36 }, { 44, 37 }, { 24, 0 }, { 24, 8 }, { 21, 35 },
+	{ 33, 30 }, { 18, 0 }, { 4, 0 }, { 4, 20 }, { 18, 39 },
+	{ 36, 0 }, { 36, 37 }, { 8, 24 }, { 38, 16 }, { 50, 26 },
+	{ 2, 0 }, { 17, 0 }, { 17, 22 }, { 2, 28 }, { 28, 26 },
+	{ 7, 10 }, { 46, 14 }, { 42, 0 }, { 37, 0 }, { 0, 0 },
+	{ 10, 0 }, { 10, 24 }, { 30, 0 }, { 30, 11 }, { 32, 0 },
+	{ 32, 34 }, { 34, 0 }, { 34, 24 }, { 0, 8 }, { 37, 1162 },
+	{ 26, 0 }, { 44, 0 }, { 21, 0 }, { 21, 1098 }, { 53, 0 },
+	{ 53, 11 }, { 44, 25 }, { 26, 34 }, { 9, 0 }, { 9, 63 },
+	{ 42, 409 }, { 6, 0 }, { 3, 0 }, { 36, 0 }, { 48, 0 },
+	{ 2, 0 }, { 7, 0 }, { 41, 0 }, { 9, 0 }, { 27, 0 },
+	{ 27, 872 }, { 42, 0 }, { 19, 0 }, { 19, 199 }, { 42, 96 },
+	{ 20, 0 }, { 51, 0 }, { 46, 0 }, { 23, 0 }, { 23, 96 },
+	{ 52, 0 }, { 33, 0 }, { 14, 0 }, { 10, 0 }, { 38, 0 },
+	{ 0, 0 }, { 0, 128 }, { 40, 0 }, { 35, 0 }, { 37, 0 },
+	{ 47, 0 }, { 11, 0 }, { 45, 0 }, { 45, 512 }, { 29, 0 },
+	{ 29, 18 }, { 26, 0 }, { 26, 16 }, { 27, 0 }, { 27, 20 },
+	{ 24, 0 }, { 24, 96 }, { 49, 0 }, { 28, 0 }, { 28, 18 },
+	{ 34, 0 }, { 4, 0 }, { 4, 17 }, { 34, 20 }, { 49, 20 },
+	{ 11, 512 }, { 47, 96 }, { 21, 0 }, { 21, 128 }, { 1, 0 },
+	{ 1, 28 }, { 18, 0 }, { 8, 0 }, { 8, 11 }, { 18, 31 },
+	{ 50, 0 }, { 50, 15 }, { 37, 26 }, { 35, 24 }, { 40, 14 },
+	{ 38, 15 }, { 10, 28 }, { 14, 31 }, { 17, 0 }, { 17, 96 },
+	{ 33, 33 }, { 52, 36 }, { 46, 128 }, { 51, 40 }, { 20, 39 },
+	{ 9, 24 }, { 41, 30 }, { 7, 39 }, { 2, 20 }, { 30, 0 },
+	{ 30, 40 }, { 48, 26 }, { 45, 0 }, { 45, 1081 }, { 36, 39 },
+	{ 3, 17 }, { 6, 39 }, { 15, 32 }, { 32, 0 }, { 32, 14 },
+	{ 26, 0 }, { 26, 26 }, { 25, 34 }, { 27, 0 }, { 27, 34 },
+	{ 53, 0 }, { 0, 0 }, { 0, 38 }, { 8, 0 }, { 8, 13 },
+	{ 53, 25 }, { 31, 54 }, { 13, 475 }, { 12, 8 }, { 50, 0 },
+	{ 50, 14 }, { 31, 0 }, { 31, 27 }, { 13, 0 }, { 13, 8 },
+	{ 43, 21 }, { 21, 0 }, { 21, 579 }, { 29, 0 }, { 29, 25 },
+	{ 44, 0 }, { 37, 0 }, { 37, 1045 }, { 1, 0 }, { 1, 19 },
+	{ 44, 31 }, { 28, 0 }, { 10, 0 }, { 10, 22 }, { 28, 30 },
+	{ 4, 0 }, { 52, 0 }, { 34, 0 }, { 19, 0 }, { 40, 0 },
+	{ 5, 0 }, { 46, 0 }, { 2, 0 }, { 30, 0 }, { 45, 0 },
+	{ 49, 0 }, { 49, 921 }, { 42, 0 }, { 36, 0 }, { 36, 96 },
+	{ 42, 96 }, { 45, 256 }, { 30, 31 }, { 15, 0 }, { 15, 512 },
+	{ 2, 35 }, { 25, 0 }, { 41, 0 }, { 35, 0 }, { 7, 0 },
+	{ 48, 0 }, { 3, 0 }, { 3, 31 }, { 38, 0 }, { 51, 0 },
+	{ 51, 35 }, { 6, 0 }, { 0, 0 }, { 21, 0 }, { 21, 15 },
+	{ 0, 18 }, { 32, 0 }, { 26, 0 }, { 26, 13 }, { 23, 0 },
+	{ 50, 0 }, { 29, 0 }, { 1, 0 }, { 1, 26 }, { 29, 96 },
+	{ 50, 37 }, { 23, 13 }, { 28, 0 }, { 49, 0 }, { 12, 0 },
+	{ 12, 18 }, { 49, 33 }, { 11, 0 }, { 11, 401 }, { 28, 11 },
+	{ 13, 0 }, { 13, 28 }, { 17, 0 }, { 17, 96 }, { 32, 23 },
+	{ 6, 31 }, { 38, 29 }, { 48, 88 }, { 38, 0 }, { 43, 0 },
+	{ 43, 36 }, { 38, 38 }, { 7, 25 }, { 48, 0 }, { 48, 128 },
+	{ 35, 27 }, { 41, 39 }, { 25, 25 }, { 46, 25 }, { 45, 0 },
+	{ 37, 0 }, { 37, 335 }, { 45, 38 }, { 5, 25 }, { 40, 39 },
+	{ 47, 0 }, { 18, 0 }, { 18, 19 }, { 47, 96 }, { 14, 0 },
+	{ 14, 256 }, { 33, 0 }, { 33, 39 }, { 19, 48 }, { 34, 109 },
+	{ 52, 17 }, { 4, 23 }, { 22, 19 }, { 16, 16 }, { 39, 12 },
+	{ 54, 38 }, { 55, 35 }, { 56, 22 }, { 20, 0 }, { 9, 0 },
+	{ 9, 21 }, { 11, 0 }, { 27, 0 }, { 27, 33 }, { 11, 33 },
+	{ 19, 0 }, { 19, 24 }, { 48, 0 }, { 15, 0 }, { 15, 35 },
+	{ 48, 188 }, { 20, 37 }, { 57, 98 }, { 20, 0 }, { 8, 0 },
+	{ 34, 0 }, { 15, 0 }, { 15, 16 }, { 34, 33 }, { 53, 0 },
+	{ 53, 29 }, { 8, 35 }, { 31, 0 }, { 48, 0 }, { 48, 1172 },
+	{ 31, 33 }, { 13, 0 }, { 13, 688 }, { 44, 0 }, { 10, 0 },
+	{ 10, 13 }, { 30, 0 }, { 6, 0 }, { 45, 0 }, { 2, 0 },
+	{ 16, 0 }, { 55, 0 }, { 55, 822 }, { 14, 0 }, { 57, 0 },
+	{ 56, 0 }, { 56, 61 }, { 57, 57 }, { 3, 0 }, { 56, 0 },
+	{ 21, 0 }, { 48, 0 }, { 12, 0 }, { 41, 0 }, { 41, 1036 },
+	{ 29, 0 }, { 37, 0 }, { 40, 0 }, { 18, 0 }, { 24, 0 },
+	{ 33, 0 }, { 26, 0 }, { 26, 96 }, { 33, 256 }, { 54, 0 },
+	{ 54, 96 }, { 49, 0 }, { 49, 256 }, { 57, 0 }, { 11, 0 },
+	{ 11, 248 }, { 4, 0 }, { 51, 0 }, { 22, 0 }, { 39, 0 },
+	{ 39, 20 }, { 55, 0 }, { 55, 26 }, { 22, 35 }, { 17, 0 },
+	{ 9, 0 }, { 9, 9 }, { 0, 0 }, { 19, 0 }, { 15, 0 },
+	{ 1, 0 }, { 50, 0 }, { 50, 30 }, { 1, 36 }, { 23, 0 },
+	{ 34, 0 }, { 28, 0 }, { 32, 0 }, { 32, 16 }, { 38, 0 },
+	{ 43, 0 }, { 35, 0 }, { 49, 0 }, { 53, 0 }, { 8, 0 },
+	{ 7, 0 }, { 7, 26 }, { 8, 97 }, { 53, 19 }, { 25, 0 },
+	{ 5, 0 }, { 5, 11 }, { 25, 96 }, { 46, 0 }, { 46, 512 },
+	{ 49, 17 }, { 35, 36 }, { 31, 0 }, { 10, 0 }, { 13, 0 },
+	{ 11, 0 }, { 11, 26 }, { 42, 0 }, { 42, 25 }, { 13, 11 },
+	{ 10, 96 }, { 31, 22 }, { 47, 0 }, { 52, 0 }, { 52, 96 },
+	{ 47, 30 }, { 7, 0 }, { 7, 256 }, { 43, 14 }, { 8, 0 },
+	{ 8, 34 }, { 27, 0 }, { 27, 24 }, { 38, 26 }, { 28, 11 },
+	{ 34, 1099 }, { 23, 23 }, { 15, 38 }, { 19, 25 }, { 0, 936 },
+	{ 41, 0 }, { 41, 18 }, { 17, 37 }, { 36, 0 }, { 36, 16 },
+	{ 51, 9 }, { 4, 30 }, { 57, 96 }, { 22, 0 }, { 9, 0 },
+	{ 9, 32 }, { 22, 25 }, { 24, 128 }, { 18, 20 }, { 40, 13 },
+	{ 37, 11 }, { 29, 37 }, { 12, 36 }, { 33, 0 }, { 33, 10 },
+	{ 48, 34 }, { 21, 34 }, { 56, 16 }, { 3, 512 }, { 14, 14 },
+	{ 16, 27 }, { 2, 19 }, { 45, 23 }, { 6, 35 }, { 50, 0 },
+	{ 50, 13 }, { 32, 0 }, { 32, 37 }, { 39, 0 }, { 46, 0 },
+	{ 0, 0 }, { 55, 0 }, { 55, 32 }, { 0, 33 }, { 7, 0 },
+	{ 54, 0 }, { 54, 15 }, { 7, 96 }, { 34, 0 }, { 34, 858 },
+	{ 46, 248 }, { 39, 512 }, { 43, 0 }, { 49, 0 }, { 35, 0 },
+	{ 11, 0 }, { 42, 0 }, { 1, 0 }, { 23, 0 }, { 23, 8 },
+	{ 15, 0 }, { 15, 13 }, { 8, 0 }, { 8, 27 }, { 1, 8 },
+	{ 9, 0 }, { 27, 0 }, { 18, 0 }, { 18, 21 }, { 27, 13 },
+	{ 33, 0 }, { 24, 0 }, { 21, 0 }, { 53, 0 }, { 53, 8 },
+	{ 21, 1054 }, { 40, 0 }, { 40, 28 }, { 24, 33 }, { 38, 0 },
+	{ 38, 577 }, { 28, 0 }, { 2, 0 }, { 45, 0 }, { 54, 0 },
+	{ 34, 0 }, { 1, 0 }, { 19, 0 }, { 25, 0 }, { 25, 96 },
+	{ 36, 0 }, { 39, 0 }, { 22, 0 }, { 51, 0 }, { 5, 0 },
+	{ 13, 0 }, { 37, 0 }, { 12, 0 }, { 12, 128 }, { 29, 0 },
+	{ 31, 0 }, { 47, 0 }, { 47, 16 }, { 16, 0 }, { 48, 0 },
+	{ 6, 0 }, { 41, 0 }, { 56, 0 }, { 56, 710 }, { 41, 18 },
+	{ 14, 0 }, { 46, 0 }, { 17, 0 }, { 50, 0 }, { 18, 0 },
+	{ 23, 0 }, { 32, 0 }, { 10, 0 }, { 4, 0 }, { 4, 28 },
+	{ 10, 96 }, { 32, 36 }, { 23, 256 }, { 55, 0 }, { 0, 0 },
+	{ 0, 40 }, { 55, 17 }, { 3, 0 }, { 3, 24 }, { 21, 0 },
+	{ 15, 0 }, { 38, 0 }, { 8, 0 }, { 57, 0 }, { 52, 0 },
+	{ 26, 0 }, { 26, 27 }, { 52, 15 }, { 57, 96 }, { 8, 96 },
+	{ 38, 1099 }, { 15, 39 }, { 27, 0 }, { 27, 15 }, { 21, 96 },
+	{ 53, 0 }, { 40, 0 }, { 40, 19 }, { 23, 0 }, { 23, 33 },
+	{ 24, 0 }, { 24, 13 }, { 53, 18 }, { 18, 512 }, { 50, 235 },
+	{ 0, 0 }, { 0, 11 }, { 17, 512 }, { 46, 15 }, { 14, 20 },
+	{ 3, 0 }, { 56, 0 }, { 56, 20 }, { 3, 34 }, { 7, 0 },
+	{ 7, 22 }, { 12, 0 }, { 26, 0 }, { 26, 517 }, { 12, 36 },
+	{ 6, 10 }, { 48, 35 }, { 16, 37 }, { 31, 96 }, { 47, 0 },
+	{ 47, 17 }, { 52, 0 }, { 52, 128 }, { 29, 21 }, { 37, 31 },
+	{ 13, 19 }, { 5, 33 }, { 41, 0 }, { 41, 39 }, { 51, 14 },
+	{ 17, 0 }, { 17, 514 }, { 22, 25 }, { 39, 33 }, { 36, 40 },
+	{ 46, 0 }, { 27, 0 }, { 50, 0 }, { 56, 0 }, { 4, 0 },
+	{ 4, 35 }, { 56, 31 }, { 50, 28 }, { 10, 0 }, { 38, 0 },
+	{ 32, 0 }, { 32, 34 }, { 38, 110 }, { 12, 0 }, { 32, 0 },
+	{ 55, 0 }, { 15, 0 }, { 40, 0 }, { 6, 0 }, { 38, 0 },
+	{ 38, 30 }, { 48, 0 }, { 48, 1175 }, { 6, 38 }, { 23, 0 },
+	{ 47, 0 }, { 37, 0 }, { 37, 22 }, { 53, 0 }, { 53, 19 },
+	{ 24, 0 }, { 13, 0 }, { 0, 0 }, { 0, 29 }, { 14, 0 },
+	{ 22, 0 }, { 4, 0 }, { 26, 0 }, { 52, 0 }, { 25, 0 },
+	{ 25, 12 }, { 52, 63 }, { 26, 397 }, { 5, 0 }, { 5, 96 },
+	{ 50, 0 }, { 52, 0 }, { 48, 0 }, { 26, 0 }, { 8, 0 },
+	{ 8, 96 }, { 26, 96 }, { 48, 1297 }, { 52, 609 }, { 50, 22 },
+	{ 4, 29 }, { 17, 0 }, { 17, 256 }, { 57, 0 }, { 57, 96 },
+	{ 22, 26 }, { 14, 23 }, { 41, 0 }, { 41, 34 }, { 13, 29 },
+	{ 51, 0 }, { 39, 0 }, { 39, 1046 }, { 51, 512 }, { 24, 37 },
+	{ 47, 24 }, { 36, 0 }, { 36, 20 }, { 23, 10 }, { 40, 9 },
+	{ 56, 0 }, { 56, 39 }, { 15, 39 }, { 55, 13 }, { 32, 13 },
+	{ 12, 11 }, { 53, 0 }, { 53, 38 }, { 10, 17 }, { 18, 0 },
+	{ 51, 0 }, { 51, 1076 }, { 18, 19 }, { 27, 24 }, { 46, 10 },
+	{ 19, 40 }, { 24, 0 }, { 52, 0 }, { 47, 0 }, { 47, 28 },
+	{ 55, 0 }, { 55, 333 }, { 52, 32 }, { 3, 0 }, { 31, 0 },
+	{ 31, 96 }, { 3, 35 }, { 32, 0 }, { 32, 9 }, { 24, 1148 },
+	{ 1, 14 }, { 34, 38 }, { 54, 38 }, { 45, 40 }, { 7, 0 },
+	{ 16, 0 }, { 51, 0 }, { 57, 0 }, { 57, 13 }, { 51, 19 },
+	{ 16, 25 }, { 7, 9 }, { 29, 0 }, { 29, 19 }, { 2, 96 },
+	{ 28, 38 }, { 38, 0 }, { 38, 21 }, { 17, 0 }, { 39, 0 },
+	{ 39, 34 }, { 17, 984 }, { 22, 0 }, { 22, 50 }, { 33, 417 },
+	{ 6, 0 }, { 22, 0 }, { 33, 0 }, { 33, 650 }, { 22, 256 },
+	{ 6, 18 }, { 9, 9 }, { 36, 0 }, { 37, 0 }, { 41, 0 },
+	{ 48, 0 }, { 48, 19 }, { 56, 0 }, { 56, 35 }, { 41, 47 },
+	{ 0, 0 }, { 18, 0 }, { 18, 8 }, { 0, 33 }, { 56, 0 },
+	{ 56, 19 }, { 37, 29 }, { 36, 19 }, { 41, 0 }, { 54, 0 },
+	{ 54, 33 }, { 23, 0 }, { 17, 0 }, { 17, 22 }, { 40, 0 },
+	{ 12, 0 }, { 46, 0 }, { 25, 0 }, { 24, 0 }, { 24, 16 },
+	{ 25, 903 }, { 19, 0 }, { 52, 0 }, { 45, 0 }, { 14, 0 },
+	{ 14, 415 }, { 8, 0 }, { 8, 21 }, { 1, 0 }, { 53, 0 },
+	{ 10, 0 }, { 55, 0 }, { 55, 33 }, { 10, 13 }, { 21, 0 },
+	{ 21, 27 }, { 53, 96 }, { 50, 0 }, { 50, 96 }, { 1, 32 },
+	{ 45, 1155 }, { 34, 0 }, { 22, 0 }, { 33, 0 }, { 33, 13 },
+	{ 22, 40 }, { 57, 0 }, { 51, 0 }, { 7, 0 }, { 4, 0 },
+	{ 4, 22 }, { 7, 14 }, { 51, 1069 }, { 57, 20 }, { 13, 0 },
+	{ 13, 31 }, { 34, 36 }, { 52, 38 }, { 19, 9 }, { 28, 0 },
+	{ 15, 0 }, { 15, 20 }, { 27, 0 }, { 27, 8 }, { 28, 18 },
+	{ 46, 32 }, { 47, 0 }, { 39, 0 }, { 3, 0 }, { 3, 8 },
+	{ 39, 1122 }, { 47, 21 }, { 48, 0 }, { 48, 30 }, { 9, 0 },
+	{ 32, 0 }, { 5, 0 }, { 5, 96 }, { 32, 32 }, { 9, 128 },
+	{ 18, 0 }, { 0, 0 }, { 0, 34 }, { 45, 0 }, { 56, 0 },
+	{ 16, 0 }, { 29, 0 }, { 29, 36 }, { 16, 712 }, { 54, 0 },
+	{ 37, 0 }, { 51, 0 }, { 17, 0 }, { 38, 0 }, { 33, 0 },
+	{ 6, 0 }, { 22, 0 }, { 4, 0 }, { 24, 0 }, { 7, 0 },
+	{ 36, 0 }, { 57, 0 }, { 25, 0 }, { 8, 0 }, { 8, 41 },
+	{ 25, 361 }, { 14, 0 }, { 26, 0 }, { 26, 12 }, { 13, 0 },
+	{ 8, 0 }, { 25, 0 }, { 25, 1165 }, { 8, 16 }, { 34, 0 },
+	{ 34, 96 }, { 55, 0 }, { 52, 0 }, { 52, 512 }, { 55, 18 },
+	{ 13, 27 }, { 19, 0 }, { 10, 0 }, { 10, 33 }, { 15, 0 },
+	{ 21, 0 }, { 27, 0 }, { 1, 0 }, { 1, 38 }, { 46, 0 },
+	{ 31, 0 }, { 28, 0 }, { 28, 37 }, { 16, 0 }, { 16, 15 },
+	{ 53, 0 }, { 53, 33 }, { 31, 40 }, { 46, 96 }, { 27, 37 },
+	{ 21, 12 }, { 15, 8 }, { 19, 35 }, { 14, 512 }, { 3, 0 },
+	{ 39, 0 }, { 47, 0 }, { 47, 96 }, { 39, 17 }, { 3, 20 },
+	{ 2, 0 }, { 2, 512 }, { 57, 21 }, { 36, 36 }, { 52, 0 },
+	{ 52, 618 }, { 7, 20 }, { 24, 96 }, { 48, 0 }, { 32, 0 },
+	{ 25, 0 }, { 25, 256 }, { 32, 28 }, { 48, 30 }, { 4, 35 },
+	{ 22, 21 }, { 6, 21 }, { 9, 0 }, { 9, 10 }, { 55, 0 },
+	{ 50, 0 }, { 50, 20 }, { 55, 96 }, { 33, 25 }, { 38, 512 },
+	{ 17, 10 }, { 51, 39 }, { 37, 33 }, { 54, 28 }, { 56, 146 },
+	{ 45, 27 }, { 13, 0 }, { 13, 40 }, { 18, 17 }, { 16, 0 },
+	{ 54, 0 }, { 54, 36 }, { 16, 24 }, { 12, 33 }, { 40, 16 },
+	{ 23, 16 }, { 56, 0 }, { 56, 35 }, { 41, 31 }, { 42, 29 },
+	{ 11, 39 }, { 35, 33 }, { 31, 0 }, { 27, 0 }, { 27, 452 },
+	{ 31, 13 }, { 15, 0 }, { 0, 0 }, { 0, 35 }, { 15, 13 },
+	{ 38, 0 }, { 19, 0 }, { 19, 603 }, { 51, 0 }, { 29, 0 },
+	{ 14, 0 }, { 26, 0 }, { 2, 0 }, { 2, 793 }, { 26, 21 },
+	{ 37, 0 }, { 13, 0 }, { 57, 0 }, { 54, 0 }, { 39, 0 },
+	{ 8, 0 }, { 10, 0 }, { 1, 0 }, { 16, 0 }, { 32, 0 },
+	{ 32, 34 }, { 16, 77 }, { 32, 0 }, { 28, 0 }, { 16, 0 },
+	{ 36, 0 }, { 48, 0 }, { 52, 0 }, { 4, 0 }, { 4, 31 },
+	{ 34, 0 }, { 53, 0 }, { 12, 0 }, { 12, 96 }, { 21, 0 },
+	{ 21, 275 }, { 23, 0 }, { 23, 512 }, { 9, 0 }, { 9, 38 },
+	{ 50, 0 }, { 22, 0 }, { 11, 0 }, { 11, 30 }, { 22, 36 },
+	{ 3, 0 }, { 7, 0 }, { 35, 0 }, { 33, 0 }, { 27, 0 },
+	{ 27, 10 }, { 5, 0 }, { 5, 96 }, { 33, 128 }, { 35, 8 },
+	{ 6, 0 }, { 6, 38 }, { 7, 40 }, { 0, 0 }, { 0, 12 },
+	{ 45, 0 }, { 45, 25 }, { 17, 0 }, { 19, 0 }, { 56, 0 },
+	{ 56, 17 }, { 19, 25 }, { 18, 0 }, { 31, 0 }, { 31, 30 },
+	{ 18, 17 }, { 42, 0 }, { 2, 0 }, { 55, 0 }, { 55, 8 },
+	{ 2, 96 }, { 42, 11 }, { 47, 0 }, { 47, 128 }, { 17, 39 },
+	{ 15, 0 }, { 21, 0 }, { 21, 15 }, { 15, 17 }, { 3, 9 },
+	{ 50, 28 }, { 53, 27 }, { 34, 10 }, { 52, 17 }, { 48, 28 },
+	{ 36, 26 }, { 16, 25 }, { 28, 13 }, { 46, 0 }, { 46, 39 },
+	{ 32, 27 }, { 1, 8 }, { 33, 0 }, { 25, 0 }, { 25, 96 },
+	{ 33, 512 }, { 10, 571 }, { 8, 36 }, { 39, 37 }, { 54, 32 },
+	{ 57, 20 }, { 13, 570 }, { 37, 10 }, { 40, 0 }, { 40, 19 },
+	{ 14, 27 }, { 29, 96 }, { 51, 11 }, { 19, 0 }, { 19, 15 },
+	{ 38, 128 }, { 49, 8 }, { 31, 0 }, { 23, 0 }, { 23, 39 },
+	{ 31, 19 }, { 43, 37 }, { 30, 19 }, { 44, 22 }, { 20, 28 },
+	{ 58, 13 }, { 59, 9 }, { 60, 40 }, { 61, 34 }, { 62, 97 },
+	{ 63, 38 }, { 18, 0 }, { 18, 18 }, { 64, 25 }, { 41, 0 },
+	{ 3, 0 }, { 50, 0 }, { 61, 0 }, { 62, 0 }, { 47, 0 },
+	{ 47, 651 }, { 62, 908 }, { 53, 0 }, { 53, 29 }, { 33, 0 },
+	{ 52, 0 }, { 15, 0 }, { 11, 0 }, { 11, 27 }, { 26, 0 },
+	{ 26, 25 }, { 36, 0 }, { 22, 0 }, { 48, 0 }, { 4, 0 },
+	{ 46, 0 }, { 46, 24 }, { 4, 244 }, { 9, 0 }, { 9, 9 },
+	{ 35, 0 }, { 38, 0 }, { 32, 0 }, { 27, 0 }, { 6, 0 },
+	{ 10, 0 }, { 7, 0 }, { 45, 0 }, { 46, 0 }, { 16, 0 },
+	{ 16, 894 }, { 43, 0 }, { 5, 0 }, { 0, 0 }, { 1, 0 },
+	{ 17, 0 }, { 30, 0 }, { 57, 0 }, { 21, 0 }, { 34, 0 },
+	{ 13, 0 }, { 40, 0 }, { 44, 0 }, { 24, 0 }, { 14, 0 },
+	{ 56, 0 }, { 23, 0 }, { 59, 0 }, { 20, 0 }, { 4, 0 },
+	{ 60, 0 }, { 55, 0 }, { 64, 0 }, { 42, 0 }, { 42, 783 },
+	{ 11, 0 }, { 28, 0 }, { 8, 0 }, { 62, 0 }, { 26, 0 },
+	{ 2, 0 }, { 39, 0 }, { 54, 0 }, { 37, 0 }, { 9, 0 },
+	{ 19, 0 }, { 47, 0 }, { 16, 0 }, { 29, 0 }, { 12, 0 },
+	{ 51, 0 }, { 49, 0 }, { 31, 0 }, { 58, 0 }, { 63, 0 },
+	{ 18, 0 }, { 53, 0 }, { 42, 0 }, { 25, 0 },
+};
+
+const int trace_len = ARRAY_SIZE(trace);
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <zephyr/types.h>
+#include <misc/util.h>
+
+/* number of allocations the trace holds at most at once */
+#define TRACE_SLOTS 65
+
+struct trace_op {
+	u8_t slot;
+	u16_t size;
+};
+
+extern const struct trace_op trace[];
+extern const int trace_len;
+
+#endif /* __TRACE_H__ */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure memcpy(), memmove() and memset()
+ *
+ * Measures each function for sizes from 1 to 4096 bytes, at every
+ * combination of destination and source alignment within a word, and
+ * reports the time with aligned buffers along with the best and worst
+ * times over all alignments.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <string.h>
+#include "timestamp.h"
+
+#define MAX_SIZE 4096
+#define ALIGNMENTS 4
+
+/* distance between source and destination for overlapping moves */
+#define OVERLAP_SHIFT 8
+
+#define NUM_RUNS 8
+
+u32_t tm_off;
+
+static u8_t __aligned(4) src_buf[MAX_SIZE + ALIGNMENTS];
+static u8_t __aligned(4) dst_buf[MAX_SIZE + ALIGNMENTS + OVERLAP_SHIFT];
+
+static const size_t sizes[] = { 1, 3, 8, 15, 32, 64, 100, 256, 1024, 4096 };
+
+enum op {
+	OP_MEMCPY,
+	OP_MEMMOVE,
+	OP_MEMMOVE_BACKWARD,
+	OP_MEMSET,
+};
+
+static const char * const op_names[] = {
+	"memcpy",
+	"memmove",
+	"memmove backward",
+	"memset",
+};
+
+static u32_t measure(enum op op, size_t size, int d_align, int s_align)
+{
+	u8_t *dst = dst_buf + d_align;
+	u8_t *src = src_buf + s_align;
+	u32_t ts, cycles = 0;
+	int i;
+
+	for (i = 0; i < NUM_RUNS; i++) {
+		ts = TIME_STAMP_DELTA_GET(0);
+		switch (op) {
+		case OP_MEMCPY:
+			memcpy(dst, src, size);
+			break;
+		case OP_MEMMOVE:
+			memmove(dst, src, size);
+			break;
+		case OP_MEMMOVE_BACKWARD:
+			/* destination after an overlapping source */
+			memmove(dst + OVERLAP_SHIFT, dst_buf + s_align, size);
+			break;
+		case OP_MEMSET:
+			memset(dst, s_align, size);
+			break;
+		}
+		cycles += TIME_STAMP_DELTA_GET(ts);
+	}
+
+	return cycles / NUM_RUNS;
+}
+
+static void measure_size(enum op op, size_t size)
+{
+	u32_t aligned, cycles, best = 0xffffffff, worst = 0;
+	int d, s;
+
+	aligned = measure(op, size, 0, 0);
+
+	for (d = 0; d < ALIGNMENTS; d++) {
+		for (s = 0; s < (op == OP_MEMSET ? 1 : ALIGNMENTS); s++) {
+			cycles = measure(op, size, d, s);
+			best = min(best, cycles);
+			worst = max(worst, cycles);
+		}
+	}
+
+	TC_PRINT(" %s %4u bytes: aligned %5u tcs, best %5u tcs, "
+		 "worst %5u tcs\n", op_names[op], size, aligned, best, worst);
+}
+
+void main(void)
+{
+	int op, i;
+
+	TC_START("Memory copy benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	for (i = 0; i < sizeof(src_buf); i++) {
+		src_buf[i] = i;
+	}
+
+	for (op = OP_MEMCPY; op <= OP_MEMSET; op++) {
+		for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+			measure_size(op, sizes[i]);
+		}
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure memory slab allocation throughput
+ *
+ * Measures:
+ *  1. the average time of an uncontended k_mem_slab_alloc()/k_mem_slab_free()
+ *     pair
+ *  2. the number of alloc/free pairs completed in one second by a thread and
+ *     by a timer expiry function running at every tick, both hammering the
+ *     same memory slab
+ *
+ * Build with prj.conf for the interrupt locking memory slab and with
+ * prj_lockless.conf for the lock-free fast path.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define NUM_BLOCKS 32
+#define BLOCK_SIZE 64
+
+/* number of alloc/free pairs measured without contention */
+#define NUM_PAIRS 1000
+
+/* blocks held at once by each side when contending */
+#define THREAD_BATCH 4
+#define ISR_BATCH 4
+
+#define CONTENTION_DURATION_MS 1000
+
+u32_t tm_off;
+
+K_MEM_SLAB_DEFINE(bench_slab, BLOCK_SIZE, NUM_BLOCKS, 4);
+
+static struct k_timer isr_timer;
+
+static volatile u32_t isr_pairs;
+static volatile u32_t isr_failures;
+
+static void isr_alloc_free(struct k_timer *timer)
+{
+	void *blocks[ISR_BATCH];
+	int i;
+
+	for (i = 0; i < ISR_BATCH; i++) {
+		if (k_mem_slab_alloc(&bench_slab, &blocks[i], K_NO_WAIT)) {
+			isr_failures++;
+			break;
+		}
+	}
+
+	while (i--) {
+		k_mem_slab_free(&bench_slab, &blocks[i]);
+		isr_pairs++;
+	}
+}
+
+static void measure_uncontended(void)
+{
+	void *block;
+	u32_t ts;
+	int i;
+
+	bench_test_start();
+	ts = TIME_STAMP_DELTA_GET(0);
+	for (i = 0; i < NUM_PAIRS; i++) {
+		k_mem_slab_alloc(&bench_slab, &block, K_NO_WAIT);
+		k_mem_slab_free(&bench_slab, &block);
+	}
+	ts = TIME_STAMP_DELTA_GET(ts);
+
+	if (bench_test_end() != 0) {
+		TC_PRINT(" Uncontended measurement spanned too many ticks\n");
+	}
+
+	TC_PRINT(" Uncontended alloc/free pair: %u tcs = %u nsec\n",
+		 ts / NUM_PAIRS, SYS_CLOCK_HW_CYCLES_TO_NS_AVG(ts, NUM_PAIRS));
+}
+
+static int measure_contended(void)
+{
+	void *blocks[THREAD_BATCH];
+	u32_t thread_pairs = 0;
+	s64_t start;
+	int i;
+
+	isr_pairs = 0;
+	isr_failures = 0;
+
+	k_timer_init(&isr_timer, isr_alloc_free, NULL);
+
+	start = k_uptime_get();
+	k_timer_start(&isr_timer, 1, 1);
+
+	while (k_uptime_get() - start < CONTENTION_DURATION_MS) {
+		for (i = 0; i < THREAD_BATCH; i++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[i],
+					     K_NO_WAIT)) {
+				TC_ERROR(" Thread failed to allocate\n");
+				k_timer_stop(&isr_timer);
+				return TC_FAIL;
+			}
+		}
+
+		for (i = 0; i < THREAD_BATCH; i++) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+
+		thread_pairs += THREAD_BATCH;
+	}
+
+	k_timer_stop(&isr_timer);
+
+	TC_PRINT(" Contended alloc/free pairs per second: thread %u, ISR %u\n",
+		 thread_pairs * MSEC_PER_SEC / CONTENTION_DURATION_MS,
+		 isr_pairs * MSEC_PER_SEC / CONTENTION_DURATION_MS);
+
+	if (isr_failures) {
+		TC_ERROR(" ISR failed to allocate %u times\n", isr_failures);
+		return TC_FAIL;
+	}
+
+	if (k_mem_slab_num_used_get(&bench_slab) != 0) {
+		TC_ERROR(" %u blocks leaked\n",
+			 k_mem_slab_num_used_get(&bench_slab));
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+void main(void)
+{
+	int status;
+
+	TC_START("Memory slab benchmark");
+
+	bench_test_init();
+
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	TC_PRINT("Memory slab: lock-free fast path\n");
+#else
+	TC_PRINT("Memory slab: interrupt locking\n");
+#endif
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	measure_uncontended();
+	status = measure_contended();
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
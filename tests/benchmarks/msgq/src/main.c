@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure message queue throughput by copy and in place
+ *
+ * A producing thread writes messages and a consuming thread reads them,
+ * both cooperative and at the same priority, so that the message queue
+ * fills up and drains completely between context switches and the time
+ * measured is dominated by the handling of the messages.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <string.h>
+
+#define STACK_SIZE 512
+#define THREAD_PRIO K_PRIO_COOP(5)
+
+#define MAX_MSG_SIZE 1024
+#define QUEUE_LEN 8
+#define NUM_MSGS 1000
+
+static char __noinit __stack producer_stack[STACK_SIZE];
+static char __noinit __stack consumer_stack[STACK_SIZE];
+
+static char __noinit __aligned(4) msgq_buffer[QUEUE_LEN * MAX_MSG_SIZE];
+static u8_t __aligned(4) tx_msg[MAX_MSG_SIZE];
+static u8_t __aligned(4) rx_msg[MAX_MSG_SIZE];
+
+static struct k_msgq msgq;
+static size_t msg_size;
+static int in_place;
+static int errors;
+
+static K_SEM_DEFINE(done_sema, 0, 2);
+
+static const size_t sizes[] = { 16, 64, 256, 1024 };
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	u8_t *msg;
+	int i;
+
+	for (i = 0; i < NUM_MSGS; i++) {
+		if (in_place) {
+			k_msgq_reserve(&msgq, (void **)&msg, K_FOREVER);
+			memset(msg, i, msg_size);
+			k_msgq_commit(&msgq);
+		} else {
+			memset(tx_msg, i, msg_size);
+			k_msgq_put(&msgq, tx_msg, K_FOREVER);
+		}
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void check_msg(const u8_t *msg, int i)
+{
+	size_t j;
+
+	for (j = 0; j < msg_size; j++) {
+		if (msg[j] != (u8_t)i) {
+			errors++;
+			return;
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	u8_t *msg;
+	int i;
+
+	for (i = 0; i < NUM_MSGS; i++) {
+		if (in_place) {
+			k_msgq_peek(&msgq, (void **)&msg, K_FOREVER);
+			check_msg(msg, i);
+			k_msgq_release(&msgq);
+		} else {
+			k_msgq_get(&msgq, rx_msg, K_FOREVER);
+			check_msg(rx_msg, i);
+		}
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static u32_t measure(size_t size, int zero_copy)
+{
+	u32_t cycles;
+
+	msg_size = size;
+	in_place = zero_copy;
+	k_msgq_init(&msgq, msgq_buffer, size, QUEUE_LEN);
+
+	/* start on a tick boundary */
+	k_sleep(1);
+	cycles = k_cycle_get_32();
+
+	k_thread_spawn(consumer_stack, STACK_SIZE, consumer, NULL, NULL, NULL,
+		       THREAD_PRIO, 0, 0);
+	k_thread_spawn(producer_stack, STACK_SIZE, producer, NULL, NULL, NULL,
+		       THREAD_PRIO, 0, 0);
+
+	k_sem_take(&done_sema, K_FOREVER);
+	k_sem_take(&done_sema, K_FOREVER);
+
+	cycles = k_cycle_get_32() - cycles;
+
+	return (u64_t)NUM_MSGS * sys_clock_hw_cycles_per_sec / cycles;
+}
+
+void main(void)
+{
+	u32_t copy, zero_copy;
+	int i;
+
+	TC_START("Message queue benchmark");
+
+	TC_PRINT("%d messages through a queue of %d messages\n", NUM_MSGS,
+		 QUEUE_LEN);
+
+	for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+		copy = measure(sizes[i], 0);
+		zero_copy = measure(sizes[i], 1);
+
+		TC_PRINT(" %4u bytes: copy %6u msgs/s, in place %6u msgs/s\n",
+			 sizes[i], copy, zero_copy);
+	}
+
+	if (errors) {
+		TC_ERROR("%d messages corrupted\n", errors);
+	}
+
+	TC_END_RESULT(errors ? TC_FAIL : TC_PASS);
+	TC_END_REPORT(errors ? TC_FAIL : TC_PASS);
+}
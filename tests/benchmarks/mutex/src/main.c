@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure mutex lock/unlock cost and priority inversion latency
+ *
+ * Measures the time to lock and unlock a mutex no other thread uses, next
+ * to the time to lock and unlock the scheduler.
+ *
+ * Then measures the time a high priority thread waits for a mutex at the
+ * end of a chain of owners: each owner waits on the mutex of the next,
+ * lower priority, owner, and the last one is ready to release its mutex
+ * but preempted by a medium priority thread hogging the CPU. Only boosting
+ * the whole chain lets the high priority thread get the mutex before the
+ * hog completes.
+ *
+ * Build with prj.conf to boost the whole chain of owners, and with
+ * prj_depth1.conf to only boost the owner of the contended mutex.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define STACK_SIZE 512
+#define NUM_LOCKS 1000
+#define MAX_DEPTH 4
+#define NUM_ROUNDS 5
+
+/* the chain releases its mutexes in far less than the hog runs */
+#define WORK_US 100
+#define HOG_MS 50
+
+#define HIGH_PRIO K_PRIO_PREEMPT(1)
+#define HOG_PRIO K_PRIO_PREEMPT(2)
+#define CHAIN_PRIO(i) K_PRIO_PREEMPT(10 - (i))
+
+u32_t tm_off;
+
+static char __noinit __stack chain_stacks[MAX_DEPTH][STACK_SIZE];
+static char __noinit __stack hog_stack[STACK_SIZE];
+
+static struct k_mutex chain_mutexes[MAX_DEPTH];
+static K_MUTEX_DEFINE(bench_mutex);
+static K_SEM_DEFINE(start_sema, 0, 1);
+
+static void measure_uncontended(void)
+{
+	u32_t ts, mutex_cycles, sched_cycles;
+	int i;
+
+	ts = TIME_STAMP_DELTA_GET(0);
+	for (i = 0; i < NUM_LOCKS; i++) {
+		k_mutex_lock(&bench_mutex, K_FOREVER);
+		k_mutex_unlock(&bench_mutex);
+	}
+	mutex_cycles = TIME_STAMP_DELTA_GET(ts);
+
+	ts = TIME_STAMP_DELTA_GET(0);
+	for (i = 0; i < NUM_LOCKS; i++) {
+		k_sched_lock();
+		k_sched_unlock();
+	}
+	sched_cycles = TIME_STAMP_DELTA_GET(ts);
+
+	TC_PRINT(" uncontended k_mutex_lock/unlock: %u tcs = %u nsec\n",
+		 mutex_cycles / NUM_LOCKS,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(mutex_cycles, NUM_LOCKS));
+	TC_PRINT(" k_sched_lock/unlock:             %u tcs = %u nsec\n",
+		 sched_cycles / NUM_LOCKS,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(sched_cycles, NUM_LOCKS));
+}
+
+/* owner i holds mutex i, and waits on mutex i - 1 */
+static void chain_owner(void *p1, void *p2, void *p3)
+{
+	int i = (int)p1;
+
+	k_mutex_lock(&chain_mutexes[i], K_FOREVER);
+
+	if (i == 0) {
+		k_sem_take(&start_sema, K_FOREVER);
+	} else {
+		k_mutex_lock(&chain_mutexes[i - 1], K_FOREVER);
+		k_mutex_unlock(&chain_mutexes[i - 1]);
+	}
+
+	k_busy_wait(WORK_US);
+
+	k_mutex_unlock(&chain_mutexes[i]);
+}
+
+static void hog(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(HOG_MS * USEC_PER_MSEC);
+}
+
+static u32_t measure_inversion(int depth)
+{
+	u32_t cycles;
+	int i;
+
+	/* each owner locks its mutex before the next one waits on it */
+	for (i = 0; i < depth; i++) {
+		k_mutex_init(&chain_mutexes[i]);
+		k_thread_spawn(chain_stacks[i], STACK_SIZE, chain_owner,
+			       (void *)i, NULL, NULL, CHAIN_PRIO(i), 0, 0);
+		k_sleep(1);
+	}
+
+	k_thread_spawn(hog_stack, STACK_SIZE, hog, NULL, NULL, NULL,
+		       HOG_PRIO, 0, 0);
+	k_sem_give(&start_sema);
+
+	cycles = k_cycle_get_32();
+	k_mutex_lock(&chain_mutexes[depth - 1], K_FOREVER);
+	cycles = k_cycle_get_32() - cycles;
+	k_mutex_unlock(&chain_mutexes[depth - 1]);
+
+	/* let the hog and the owners complete */
+	k_sleep(HOG_MS + 10);
+
+	return cycles;
+}
+
+void main(void)
+{
+	u32_t cycles, worst;
+	int depth, i;
+
+	TC_START("Mutex benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	measure_uncontended();
+
+	TC_PRINT("Priority inheritance depth %d, chain owners work %d us, "
+		 "hog runs %d ms\n", CONFIG_PRIORITY_INHERITANCE_DEPTH,
+		 WORK_US, HOG_MS);
+
+	k_thread_priority_set(k_current_get(), HIGH_PRIO);
+
+	for (depth = 1; depth <= MAX_DEPTH; depth++) {
+		worst = 0;
+		for (i = 0; i < NUM_ROUNDS; i++) {
+			cycles = measure_inversion(depth);
+			worst = max(worst, cycles);
+		}
+
+		TC_PRINT(" %d owners: worst wait %u us\n", depth,
+			 SYS_CLOCK_HW_CYCLES_TO_NS(worst) / NSEC_PER_USEC);
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the throughput of scattered pipe transfers
+ *
+ * A thread sends messages split in 1, 4 and 16 segments through a pipe
+ * without ring buffer to a higher priority thread waiting on it, either by
+ * gathering the segments in a staging buffer for k_pipe_put() or by
+ * passing them to k_pipe_putv(), and reports the bytes per second.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define STACK_SIZE 1024
+#define MSG_SIZE 1024
+#define MAX_SEGS 16
+#define NUM_MSGS 1000
+
+#define SENDER_PRIO K_PRIO_PREEMPT(10)
+#define RECEIVER_PRIO K_PRIO_PREEMPT(5)
+
+static char __noinit __stack receiver_stack[STACK_SIZE];
+
+static unsigned char tx_data[MSG_SIZE];
+static unsigned char tx_staging[MSG_SIZE];
+static unsigned char rx_data[MSG_SIZE];
+
+static struct k_pipe_iovec tx_iov[MAX_SEGS];
+
+K_PIPE_DEFINE(bench_pipe, 0, 4);
+static K_SEM_DEFINE(done_sema, 0, 1);
+
+static void receiver(void *p1, void *p2, void *p3)
+{
+	size_t bytes_read;
+	int i;
+
+	while (1) {
+		for (i = 0; i < NUM_MSGS; i++) {
+			k_pipe_get(&bench_pipe, rx_data, MSG_SIZE, &bytes_read,
+				   MSG_SIZE, K_FOREVER);
+		}
+
+		k_sem_give(&done_sema);
+	}
+}
+
+static void send_staged(int num_segs)
+{
+	size_t bytes_written;
+	size_t offset;
+	int i;
+
+	for (i = 0, offset = 0; i < num_segs; i++) {
+		memcpy(tx_staging + offset, tx_iov[i].base, tx_iov[i].len);
+		offset += tx_iov[i].len;
+	}
+
+	k_pipe_put(&bench_pipe, tx_staging, MSG_SIZE, &bytes_written,
+		   MSG_SIZE, K_FOREVER);
+}
+
+static void send_iov(int num_segs)
+{
+	size_t bytes_written;
+
+	k_pipe_putv(&bench_pipe, tx_iov, num_segs, &bytes_written,
+		    MSG_SIZE, K_FOREVER);
+}
+
+static u32_t measure(void (*send)(int), int num_segs)
+{
+	u32_t cycles;
+	int i;
+
+	/* start on a tick boundary */
+	k_sleep(1);
+	cycles = k_cycle_get_32();
+
+	for (i = 0; i < NUM_MSGS; i++) {
+		send(num_segs);
+	}
+
+	k_sem_take(&done_sema, K_FOREVER);
+	cycles = k_cycle_get_32() - cycles;
+
+	if (memcmp(rx_data, tx_data, MSG_SIZE)) {
+		TC_ERROR("received data differs from sent data\n");
+	}
+
+	return (u64_t)NUM_MSGS * MSG_SIZE * sys_clock_hw_cycles_per_sec /
+	       cycles;
+}
+
+void main(void)
+{
+	int num_segs, i;
+
+	TC_START("Pipe scatter-gather benchmark");
+
+	TC_PRINT("%d messages of %d bytes through a pipe without ring buffer\n",
+		 NUM_MSGS, MSG_SIZE);
+
+	for (i = 0; i < MSG_SIZE; i++) {
+		tx_data[i] = i;
+	}
+
+	k_thread_priority_set(k_current_get(), SENDER_PRIO);
+	k_thread_spawn(receiver_stack, STACK_SIZE, receiver, NULL, NULL, NULL,
+		       RECEIVER_PRIO, 0, 0);
+
+	for (num_segs = 1; num_segs <= MAX_SEGS; num_segs *= 4) {
+		for (i = 0; i < num_segs; i++) {
+			tx_iov[i].base = tx_data + i * (MSG_SIZE / num_segs);
+			tx_iov[i].len = MSG_SIZE / num_segs;
+		}
+
+		TC_PRINT(" %2d segments: staged %u bytes/s, putv %u bytes/s\n",
+			 num_segs, measure(send_staged, num_segs),
+			 measure(send_iov, num_segs));
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
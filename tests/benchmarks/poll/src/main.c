@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the thundering herd of threads polling on one FIFO
+ *
+ * A low priority thread puts items in a FIFO that a group of higher
+ * priority threads poll on. The notified threads preempt the producer,
+ * try to get the item, and go back to polling, so the time k_fifo_put()
+ * takes to return includes the cost of every notified thread.
+ *
+ * Build with prj.conf to notify all the polling threads and with
+ * prj_wake_one.conf to notify only one of them.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define STACK_SIZE 512
+#define MAX_POLLERS 8
+#define NUM_ITEMS 500
+
+#define PRODUCER_PRIO K_PRIO_PREEMPT(10)
+#define POLLER_PRIO K_PRIO_PREEMPT(5)
+
+u32_t tm_off;
+
+struct fifo_item {
+	void *fifo_reserved;
+};
+
+static char __noinit __stack stacks[MAX_POLLERS][STACK_SIZE];
+
+static struct fifo_item items[NUM_ITEMS];
+
+static K_FIFO_DEFINE(herd_fifo);
+static K_SEM_DEFINE(done_sema, 0, MAX_POLLERS);
+static struct k_poll_signal stop_signal;
+
+static volatile u32_t woken;
+static volatile u32_t received;
+
+static void poller(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &herd_fifo),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &stop_signal),
+	};
+
+	while (1) {
+		(void)k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+
+		if (events[1].state == K_POLL_STATE_SIGNALED) {
+			break;
+		}
+
+		woken++;
+		if (k_fifo_get(&herd_fifo, K_NO_WAIT)) {
+			received++;
+		}
+
+		events[0].state = K_POLL_STATE_NOT_READY;
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void measure(int num_pollers)
+{
+	u32_t ts, cycles = 0;
+	int i;
+
+	woken = 0;
+	received = 0;
+	k_poll_signal_init(&stop_signal);
+
+	/* the pollers run right away and poll on the FIFO */
+	for (i = 0; i < num_pollers; i++) {
+		k_thread_spawn(stacks[i], STACK_SIZE, poller, NULL, NULL, NULL,
+			       POLLER_PRIO, 0, 0);
+	}
+
+	for (i = 0; i < NUM_ITEMS; i++) {
+		ts = TIME_STAMP_DELTA_GET(0);
+		k_fifo_put(&herd_fifo, &items[i]);
+		cycles += TIME_STAMP_DELTA_GET(ts);
+	}
+
+	k_poll_signal(&stop_signal, 0);
+	for (i = 0; i < num_pollers; i++) {
+		k_sem_take(&done_sema, K_FOREVER);
+	}
+
+	TC_PRINT(" %d pollers: put %u tcs = %u nsec, %u.%02u threads notified "
+		 "per item, %u items received\n", num_pollers,
+		 cycles / NUM_ITEMS,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles, NUM_ITEMS),
+		 woken / NUM_ITEMS, woken * 100 / NUM_ITEMS % 100, received);
+}
+
+void main(void)
+{
+	int n;
+
+	TC_START("Poll thundering herd benchmark");
+
+	bench_test_init();
+
+#ifdef CONFIG_POLL_WAKE_ONE
+	TC_PRINT("Notify the polling thread of highest priority\n");
+#else
+	TC_PRINT("Notify all the polling threads\n");
+#endif
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	k_thread_priority_set(k_current_get(), PRODUCER_PRIO);
+
+	for (n = 1; n <= MAX_POLLERS; n *= 2) {
+		measure(n);
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure reader-writer lock cost and read scalability
+ *
+ * Measures the time to lock and unlock a reader-writer lock for reading
+ * when no other thread uses it, next to the time to lock and unlock a
+ * mutex.
+ *
+ * Then measures the lookup throughput of a group of reader threads sharing
+ * a table protected by a mutex, and by a reader-writer lock. Each lookup
+ * blocks for a tick while holding the lock, and a higher priority writer
+ * updates the table periodically.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define STACK_SIZE 512
+#define NUM_LOCKS 1000
+#define MAX_READERS 8
+#define TABLE_SIZE 16
+
+#define RUN_MS 1000
+#define WRITER_PERIOD_MS 100
+
+#define READER_PRIO K_PRIO_PREEMPT(10)
+#define WRITER_PRIO K_PRIO_PREEMPT(5)
+
+u32_t tm_off;
+
+static char __noinit __stack reader_stacks[MAX_READERS][STACK_SIZE];
+static char __noinit __stack writer_stack[STACK_SIZE];
+
+static K_MUTEX_DEFINE(bench_mutex);
+static K_RWLOCK_DEFINE(bench_rwlock);
+static K_SEM_DEFINE(done_sema, 0, MAX_READERS + 1);
+
+static u32_t table[TABLE_SIZE];
+static volatile int use_rwlock;
+static volatile int stop;
+static volatile u32_t lookups;
+static volatile u32_t updates;
+
+static void measure_uncontended(void)
+{
+	u32_t ts, rwlock_cycles, mutex_cycles;
+	int i;
+
+	ts = TIME_STAMP_DELTA_GET(0);
+	for (i = 0; i < NUM_LOCKS; i++) {
+		k_rwlock_read_lock(&bench_rwlock, K_FOREVER);
+		k_rwlock_read_unlock(&bench_rwlock);
+	}
+	rwlock_cycles = TIME_STAMP_DELTA_GET(ts);
+
+	ts = TIME_STAMP_DELTA_GET(0);
+	for (i = 0; i < NUM_LOCKS; i++) {
+		k_mutex_lock(&bench_mutex, K_FOREVER);
+		k_mutex_unlock(&bench_mutex);
+	}
+	mutex_cycles = TIME_STAMP_DELTA_GET(ts);
+
+	TC_PRINT(" uncontended k_rwlock_read_lock/unlock: %u tcs = %u nsec\n",
+		 rwlock_cycles / NUM_LOCKS,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(rwlock_cycles, NUM_LOCKS));
+	TC_PRINT(" uncontended k_mutex_lock/unlock:       %u tcs = %u nsec\n",
+		 mutex_cycles / NUM_LOCKS,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(mutex_cycles, NUM_LOCKS));
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	int i = (int)p1;
+
+	while (!stop) {
+		if (use_rwlock) {
+			k_rwlock_read_lock(&bench_rwlock, K_FOREVER);
+		} else {
+			k_mutex_lock(&bench_mutex, K_FOREVER);
+		}
+
+		/* the lookup waits for a device while holding the lock */
+		(void)table[i++ % TABLE_SIZE];
+		k_sleep(1);
+
+		if (use_rwlock) {
+			k_rwlock_read_unlock(&bench_rwlock);
+		} else {
+			k_mutex_unlock(&bench_mutex);
+		}
+
+		lookups++;
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	while (!stop) {
+		k_sleep(WRITER_PERIOD_MS);
+
+		if (use_rwlock) {
+			k_rwlock_write_lock(&bench_rwlock, K_FOREVER);
+		} else {
+			k_mutex_lock(&bench_mutex, K_FOREVER);
+		}
+
+		table[updates++ % TABLE_SIZE]++;
+
+		if (use_rwlock) {
+			k_rwlock_write_unlock(&bench_rwlock);
+		} else {
+			k_mutex_unlock(&bench_mutex);
+		}
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void measure_readers(int num_readers, int rwlock)
+{
+	int i;
+
+	use_rwlock = rwlock;
+	stop = 0;
+	lookups = 0;
+	updates = 0;
+
+	k_thread_spawn(writer_stack, STACK_SIZE, writer, NULL, NULL, NULL,
+		       WRITER_PRIO, 0, 0);
+	for (i = 0; i < num_readers; i++) {
+		k_thread_spawn(reader_stacks[i], STACK_SIZE, reader,
+			       (void *)i, NULL, NULL, READER_PRIO, 0, 0);
+	}
+
+	k_sleep(RUN_MS);
+	stop = 1;
+
+	for (i = 0; i < num_readers + 1; i++) {
+		k_sem_take(&done_sema, K_FOREVER);
+	}
+
+	TC_PRINT(" %d readers, %s: %u lookups/s, %u updates/s\n",
+		 num_readers, rwlock ? "k_rwlock" : "k_mutex ",
+		 lookups * MSEC_PER_SEC / RUN_MS,
+		 updates * MSEC_PER_SEC / RUN_MS);
+}
+
+void main(void)
+{
+	int n;
+
+	TC_START("Reader-writer lock benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	measure_uncontended();
+
+	TC_PRINT("Each lookup holds the lock for a tick, the table is "
+		 "updated every %d ms\n", WRITER_PERIOD_MS);
+
+	for (n = 1; n <= MAX_READERS; n *= 2) {
+		measure_readers(n, 0);
+		measure_readers(n, 1);
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
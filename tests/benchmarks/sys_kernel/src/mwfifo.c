@@ -130,6 +130,102 @@ void fifo_thread3(void *par1, void *par2, void *par3)
 }
 
 
+/* number of items the producer puts in the fifo before letting it drain */
+#define FIFO_BURST 10
+
+static struct {
+	void *fifo_reserved;
+	int value;
+} burst_items[FIFO_BURST];
+
+
+/**
+ *
+ * @brief Fifo test thread putting items in bursts
+ *
+ * @param par1   Ignored parameter.
+ * @param par2   Number of items to put.
+ *
+ * @return N/A
+ */
+void fifo_burst_producer(void *par1, void *par2, void *par3)
+{
+	int i, j;
+	int num_loops = (int) par2;
+
+	ARG_UNUSED(par1);
+	ARG_UNUSED(par3);
+
+	for (i = 0; i < num_loops; i += FIFO_BURST) {
+		for (j = 0; j < FIFO_BURST; j++) {
+			burst_items[j].value = i + j;
+			k_fifo_put(&fifo1, &burst_items[j]);
+		}
+		/* the consumer empties the fifo before the items are reused */
+		k_yield();
+	}
+}
+
+
+/**
+ *
+ * @brief Fifo test thread getting items one at a time
+ *
+ * @param par1   Address of the counter.
+ * @param par2   Number of items to get.
+ *
+ * @return N/A
+ */
+void fifo_single_consumer(void *par1, void *par2, void *par3)
+{
+	int *pelement;
+	int *pcounter = (int *)par1;
+	int num_loops = (int) par2;
+
+	ARG_UNUSED(par3);
+
+	while (*pcounter < num_loops) {
+		pelement = (int *)k_fifo_get(&fifo1, K_FOREVER);
+		if (pelement[1] != *pcounter) {
+			break;
+		}
+		(*pcounter)++;
+	}
+}
+
+
+/**
+ *
+ * @brief Fifo test thread getting all the available items at once
+ *
+ * @param par1   Address of the counter.
+ * @param par2   Number of items to get.
+ *
+ * @return N/A
+ */
+void fifo_batch_consumer(void *par1, void *par2, void *par3)
+{
+	sys_slist_t list;
+	int *pelement;
+	int *pcounter = (int *)par1;
+	int num_loops = (int) par2;
+
+	ARG_UNUSED(par3);
+
+	sys_slist_init(&list);
+
+	while (*pcounter < num_loops) {
+		k_fifo_get_batch(&fifo1, &list, 0, K_FOREVER);
+		while ((pelement = (int *)sys_slist_get(&list))) {
+			if (pelement[1] != *pcounter) {
+				return;
+			}
+			(*pcounter)++;
+		}
+	}
+}
+
+
 /**
  *
  * @brief The main test entry
@@ -257,5 +353,57 @@ int fifo_test(void)
 		k_fifo_put(&sync_fifo, (void *) element);
 	}
 
+	/* test getting items one at a time from a fifo filled in bursts */
+	fprintf(output_file, sz_test_case_fmt,
+			"FIFO #4");
+	fprintf(output_file, sz_description,
+			"\n\tk_fifo_init"
+			"\n\tk_fifo_get(K_FOREVER)"
+			"\n\tk_fifo_put"
+			"\n\tk_yield");
+	printf(sz_test_start_fmt);
+
+	fifo_test_init();
+
+	t = BENCH_START();
+
+	i = 0;
+	k_thread_spawn(thread_stack1, STACK_SIZE, fifo_single_consumer,
+			 (void *) &i, (void *) NUMBER_OF_LOOPS, NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+	k_thread_spawn(thread_stack2, STACK_SIZE, fifo_burst_producer,
+			 NULL, (void *) NUMBER_OF_LOOPS, NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	/* test getting all the items at once from a fifo filled in bursts */
+	fprintf(output_file, sz_test_case_fmt,
+			"FIFO #5");
+	fprintf(output_file, sz_description,
+			"\n\tk_fifo_init"
+			"\n\tk_fifo_get_batch(K_FOREVER)"
+			"\n\tk_fifo_put"
+			"\n\tk_yield");
+	printf(sz_test_start_fmt);
+
+	fifo_test_init();
+
+	t = BENCH_START();
+
+	i = 0;
+	k_thread_spawn(thread_stack1, STACK_SIZE, fifo_batch_consumer,
+			 (void *) &i, (void *) NUMBER_OF_LOOPS, NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+	k_thread_spawn(thread_stack2, STACK_SIZE, fifo_burst_producer,
+			 NULL, (void *) NUMBER_OF_LOOPS, NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
 	return return_value;
 }
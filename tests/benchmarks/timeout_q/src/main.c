@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of timeout queue operations
+ *
+ * Measures, with 10, 100 and 1000 outstanding timeouts:
+ *  1. the average time to add a timeout (k_timer_start())
+ *  2. the average time to abort a timeout (k_timer_stop())
+ *  3. the average time to expire a timeout when all of them expire on the
+ *     same tick
+ *  4. with CONFIG_INT_LATENCY_BENCHMARK, the worst-case time interrupts are
+ *     locked while expiring them
+ *
+ * Build with prj.conf for the delta list timeout queue and with
+ * prj_heap.conf for the pairing heap timeout queue, and with
+ * prj_irq_lock.conf to also measure the worst-case interrupt lock time.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define MAX_TIMEOUTS 1000
+
+/* number of abort/add pairs measured at each queue depth */
+#define NUM_REQUEUES 100
+
+/* outstanding timeouts are spread over this window, in ms */
+#define MIN_DURATION 10000
+#define MAX_DURATION 20000
+
+/* all timeouts measured for expiry are started with this duration, in ms */
+#define EXPIRY_DURATION 50
+
+u32_t tm_off;
+
+static struct k_timer timers[MAX_TIMEOUTS];
+
+static const int depths[] = { 10, 100, 1000 };
+
+static u32_t rand_state = 0x1234abcd;
+
+static volatile int num_expired;
+static volatile u32_t first_expiry;
+static volatile u32_t last_expiry;
+
+static u32_t next_duration(void)
+{
+	/* simple LCG: deterministic and cheap, good enough to scatter keys */
+	rand_state = rand_state * 1103515245 + 12345;
+
+	return MIN_DURATION + (rand_state >> 8) % (MAX_DURATION - MIN_DURATION);
+}
+
+static void expiry_fn(struct k_timer *timer)
+{
+	u32_t now = OS_GET_TIME();
+
+	if (num_expired++ == 0) {
+		first_expiry = now;
+	}
+	last_expiry = now;
+}
+
+static void stop_all(int depth)
+{
+	int i;
+
+	for (i = 0; i < depth; i++) {
+		k_timer_stop(&timers[i]);
+	}
+}
+
+static void measure_add_abort(int depth)
+{
+	u32_t add_time = 0;
+	u32_t abort_time = 0;
+	u32_t ts;
+	int i;
+
+	for (i = 0; i < depth; i++) {
+		k_timer_init(&timers[i], NULL, NULL);
+		k_timer_start(&timers[i], next_duration(), 0);
+	}
+
+	for (i = 0; i < NUM_REQUEUES; i++) {
+		struct k_timer *timer = &timers[(rand_state >> 8) % depth];
+		u32_t duration = next_duration();
+
+		ts = TIME_STAMP_DELTA_GET(0);
+		k_timer_stop(timer);
+		abort_time += TIME_STAMP_DELTA_GET(ts);
+
+		ts = TIME_STAMP_DELTA_GET(0);
+		k_timer_start(timer, duration, 0);
+		add_time += TIME_STAMP_DELTA_GET(ts);
+	}
+
+	stop_all(depth);
+
+	TC_PRINT(" %4d timeouts: add %6u tcs = %8u nsec\n", depth,
+		 add_time / NUM_REQUEUES,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(add_time, NUM_REQUEUES));
+	TC_PRINT(" %4d timeouts: abort %4u tcs = %8u nsec\n", depth,
+		 abort_time / NUM_REQUEUES,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(abort_time, NUM_REQUEUES));
+}
+
+static int measure_expiry(int depth)
+{
+	unsigned int key;
+	u32_t expiry_time;
+	int i;
+
+	num_expired = 0;
+
+	for (i = 0; i < depth; i++) {
+		k_timer_init(&timers[i], expiry_fn, NULL);
+	}
+
+	/* make sure all timeouts are aligned on the same tick */
+	TICK_SYNCH();
+	key = irq_lock();
+	for (i = 0; i < depth; i++) {
+		k_timer_start(&timers[i], EXPIRY_DURATION, 0);
+	}
+	irq_unlock(key);
+
+#ifdef CONFIG_INT_LATENCY_BENCHMARK
+	/* only account for interrupt locking once all timeouts are queued */
+	int_latency_init();
+#endif
+
+	k_sleep(EXPIRY_DURATION * 2);
+
+	if (num_expired != depth) {
+		TC_ERROR(" %d timeouts expired, expected %d\n",
+			 num_expired, depth);
+		return TC_FAIL;
+	}
+
+	expiry_time = last_expiry - first_expiry;
+
+	TC_PRINT(" %4d timeouts: expiry %3u tcs = %8u nsec\n", depth,
+		 expiry_time / (depth - 1),
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(expiry_time, depth - 1));
+
+#ifdef CONFIG_INT_LATENCY_BENCHMARK
+	u32_t max_locked = int_latency_max_get();
+
+	TC_PRINT(" %4d timeouts: max irq lock %6u tcs = %8u nsec\n", depth,
+		 max_locked, SYS_CLOCK_HW_CYCLES_TO_NS(max_locked));
+#endif
+
+	return TC_PASS;
+}
+
+void main(void)
+{
+	int status = TC_PASS;
+	int i;
+
+	TC_START("Timeout queue benchmark");
+
+	bench_test_init();
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PAIRING_HEAP
+	TC_PRINT("Timeout queue: pairing heap\n");
+#else
+	TC_PRINT("Timeout queue: delta list\n");
+#endif
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	for (i = 0; i < ARRAY_SIZE(depths); i++) {
+		measure_add_abort(depths[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(depths); i++) {
+		if (measure_expiry(depths[i]) != TC_PASS) {
+			status = TC_FAIL;
+		}
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the idle wakeups saved by timer slack
+ *
+ * Runs periodic timers and delayed work items resubmitted by their handler,
+ * all with different periods, while the system otherwise idles with
+ * tickless idle. Compares the idle wakeups per second without slack and
+ * with slack on every timer and work item, along with the extra delay of
+ * the work items.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define NUM_TIMERS 8
+#define NUM_WORKS 4
+#define RUN_MS 2000
+#define SLACK_MS 30
+
+#define TIMER_PERIOD(i) (40 + 6 * (i))
+#define WORK_DELAY(i) (25 + 4 * (i))
+
+struct bench_work {
+	struct k_delayed_work work;
+	s32_t delay;
+	u32_t submitted;
+};
+
+static struct k_timer timers[NUM_TIMERS];
+static struct bench_work works[NUM_WORKS];
+
+static volatile int stop;
+static u32_t expiries;
+static u32_t works_done;
+static u32_t late_ms;
+static u32_t max_late_ms;
+
+static void timer_expiry(struct k_timer *timer)
+{
+	expiries++;
+}
+
+static void submit(struct bench_work *w)
+{
+	w->submitted = k_uptime_get_32();
+	k_delayed_work_submit(&w->work, w->delay);
+}
+
+static void work_handler(struct k_work *work)
+{
+	struct bench_work *w = CONTAINER_OF(work, struct bench_work, work);
+	u32_t late = k_uptime_get_32() - w->submitted - w->delay;
+
+	expiries++;
+	works_done++;
+	late_ms += late;
+	max_late_ms = max(max_late_ms, late);
+
+	if (!stop) {
+		submit(w);
+	}
+}
+
+static u32_t per_sec(u32_t count)
+{
+	return count * MSEC_PER_SEC / RUN_MS;
+}
+
+static void run(s32_t slack)
+{
+	struct k_wakeup_stats before, after;
+	int i;
+
+	stop = 0;
+	expiries = 0;
+	works_done = 0;
+	late_ms = 0;
+	max_late_ms = 0;
+
+	for (i = 0; i < NUM_TIMERS; i++) {
+		k_timer_init(&timers[i], timer_expiry, NULL);
+		k_timer_slack_set(&timers[i], slack);
+	}
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		k_delayed_work_init(&works[i].work, work_handler);
+		k_delayed_work_slack_set(&works[i].work, slack);
+		works[i].delay = WORK_DELAY(i);
+	}
+
+	/* start on a tick boundary */
+	k_sleep(1);
+	k_wakeup_stats_get(&before);
+
+	for (i = 0; i < NUM_TIMERS; i++) {
+		k_timer_start(&timers[i], TIMER_PERIOD(i), TIMER_PERIOD(i));
+	}
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		submit(&works[i]);
+	}
+
+	k_sleep(RUN_MS);
+
+	k_wakeup_stats_get(&after);
+
+	stop = 1;
+	for (i = 0; i < NUM_TIMERS; i++) {
+		k_timer_stop(&timers[i]);
+	}
+	for (i = 0; i < NUM_WORKS; i++) {
+		k_delayed_work_cancel(&works[i].work);
+	}
+
+	TC_PRINT(" slack %2d ms: %u idle wakeups/s, %u clock interrupts/s, "
+		 "%u expirations/s, %u timeouts/s\n", slack,
+		 per_sec(after.idle_wakeups - before.idle_wakeups),
+		 per_sec(after.announcements - before.announcements),
+		 per_sec(after.expirations - before.expirations),
+		 per_sec(after.timeouts - before.timeouts));
+	TC_PRINT(" slack %2d ms: %u expiries/s, work late by %u ms on average, "
+		 "%u ms at most\n", slack, per_sec(expiries),
+		 late_ms / max(works_done, 1), max_late_ms);
+}
+
+void main(void)
+{
+	TC_START("Timer slack benchmark");
+
+	TC_PRINT("%d periodic timers from %d to %d ms, %d delayed works "
+		 "from %d to %d ms, for %d ms\n", NUM_TIMERS, TIMER_PERIOD(0),
+		 TIMER_PERIOD(NUM_TIMERS - 1), NUM_WORKS, WORK_DELAY(0),
+		 WORK_DELAY(NUM_WORKS - 1), RUN_MS);
+
+	run(0);
+	run(SLACK_MS);
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
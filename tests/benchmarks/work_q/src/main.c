@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure workqueue throughput and latency
+ *
+ * Submits bursts of short and long work items, every system tick, to a
+ * workqueue with a single thread and to a workqueue served by a pool of
+ * threads, and reports the throughput and the distribution of the time
+ * from submission to the start of the handler.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include "timestamp.h"
+
+#define STACK_SIZE 512
+#define POOL_THREADS 4
+#define WORK_Q_PRIO K_PRIO_PREEMPT(1)
+
+#define NUM_BURSTS 20
+#define BURST_SIZE 10
+#define NUM_ITEMS (NUM_BURSTS * BURST_SIZE)
+
+/* one item of each burst blocks, the others keep the CPU busy briefly */
+#define SHORT_US 50
+#define LONG_MS 20
+
+u32_t tm_off;
+
+struct bench_work {
+	struct k_work work;
+	u32_t submitted;
+	u32_t latency;
+	int blocking;
+};
+
+static char __noinit __stack single_stack[STACK_SIZE];
+static char __noinit __stack pool_stacks[POOL_THREADS][STACK_SIZE];
+
+static struct k_work_q single_work_q;
+static struct k_work_q pool_work_q;
+
+static struct bench_work items[NUM_ITEMS];
+static u32_t latencies[NUM_ITEMS];
+
+static K_SEM_DEFINE(done_sema, 0, NUM_ITEMS);
+
+static void work_handler(struct k_work *work)
+{
+	struct bench_work *item = CONTAINER_OF(work, struct bench_work, work);
+
+	item->latency = k_cycle_get_32() - item->submitted;
+
+	if (item->blocking) {
+		k_sleep(LONG_MS);
+	} else {
+		k_busy_wait(SHORT_US);
+	}
+
+	k_sem_give(&done_sema);
+}
+
+static void sort(u32_t *a, int n)
+{
+	int i, j;
+
+	for (i = 1; i < n; i++) {
+		u32_t v = a[i];
+
+		for (j = i; j > 0 && a[j - 1] > v; j--) {
+			a[j] = a[j - 1];
+		}
+		a[j] = v;
+	}
+}
+
+static u32_t cycles_to_us(u32_t cycles)
+{
+	return SYS_CLOCK_HW_CYCLES_TO_NS(cycles) / NSEC_PER_USEC;
+}
+
+static void run(const char *name, struct k_work_q *work_q)
+{
+	u32_t start, total;
+	int i, j;
+
+	/* start on a tick boundary */
+	k_sleep(1);
+	start = k_cycle_get_32();
+
+	for (i = 0; i < NUM_BURSTS; i++) {
+		for (j = 0; j < BURST_SIZE; j++) {
+			struct bench_work *item = &items[i * BURST_SIZE + j];
+
+			k_work_init(&item->work, work_handler);
+			item->blocking = (j == 0);
+			item->submitted = k_cycle_get_32();
+			k_work_submit_to_queue(work_q, &item->work);
+		}
+
+		/* let the workqueue threads run until the next burst */
+		k_sleep(1);
+	}
+
+	for (i = 0; i < NUM_ITEMS; i++) {
+		k_sem_take(&done_sema, K_FOREVER);
+	}
+
+	total = k_cycle_get_32() - start;
+
+	for (i = 0; i < NUM_ITEMS; i++) {
+		latencies[i] = items[i].latency;
+	}
+	sort(latencies, NUM_ITEMS);
+
+	TC_PRINT(" %s: %u items in %u ms, %u items/s\n", name, NUM_ITEMS,
+		 cycles_to_us(total) / USEC_PER_MSEC,
+		 (u32_t)((u64_t)NUM_ITEMS * sys_clock_hw_cycles_per_sec /
+			 total));
+	TC_PRINT(" %s: latency median %u us, p99 %u us, worst %u us\n", name,
+		 cycles_to_us(latencies[NUM_ITEMS / 2]),
+		 cycles_to_us(latencies[NUM_ITEMS * 99 / 100]),
+		 cycles_to_us(latencies[NUM_ITEMS - 1]));
+}
+
+void main(void)
+{
+	TC_START("Workqueue benchmark");
+
+	TC_PRINT("%d bursts of %d items every tick, 1 blocking for %d ms and "
+		 "%d busy for %d us\n", NUM_BURSTS, BURST_SIZE, LONG_MS,
+		 BURST_SIZE - 1, SHORT_US);
+
+	k_work_q_start(&single_work_q, single_stack, STACK_SIZE, WORK_Q_PRIO);
+	k_work_q_pool_start(&pool_work_q, pool_stacks[0], STACK_SIZE,
+			    POOL_THREADS, WORK_Q_PRIO);
+
+	run("1 thread ", &single_work_q);
+	run("4 threads", &pool_work_q);
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_event
+ * @{
+ * @defgroup t_event_api test_event_api
+ * @}
+ */
+
+#include <ztest.h>
+extern void test_event_post_wait(void);
+extern void test_event_set_clear(void);
+extern void test_event_wait_all(void);
+extern void test_event_wait_skip(void);
+extern void test_event_timeout(void);
+extern void test_event_broadcast(void);
+extern void test_event_isr(void);
+
+/*test case main entry*/
+void test_main(void *p1, void *p2, void *p3)
+{
+	ztest_test_suite(test_event_api,
+			 ztest_unit_test(test_event_post_wait),
+			 ztest_unit_test(test_event_set_clear),
+			 ztest_unit_test(test_event_wait_all),
+			 ztest_unit_test(test_event_wait_skip),
+			 ztest_unit_test(test_event_timeout),
+			 ztest_unit_test(test_event_broadcast),
+			 ztest_unit_test(test_event_isr));
+	ztest_run_test_suite(test_event_api);
+}
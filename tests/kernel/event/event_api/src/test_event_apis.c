@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_event_api
+ * @{
+ * @defgroup t_event_wait test_event_wait
+ * @brief TestPurpose: verify events are posted, set, cleared and waited
+ *                     for from threads and ISRs
+ * - API coverage
+ *   -# k_event_init K_EVENT_DEFINE
+ *   -# k_event_post k_event_set k_event_clear k_event_get
+ *   -# k_event_wait [ANY ALL CLEAR] [FOREVER NO_WAIT TIMEOUT]
+ * @}
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define TIMEOUT 100
+#define STACK_SIZE 512
+#define NUM_WAITERS 3
+
+#define EV_A BIT(0)
+#define EV_B BIT(1)
+#define EV_C BIT(2)
+
+/**TESTPOINT: init via K_EVENT_DEFINE*/
+K_EVENT_DEFINE(kevent);
+static struct k_event event;
+
+static char __noinit __stack tstack[NUM_WAITERS][STACK_SIZE];
+
+static volatile u32_t received[NUM_WAITERS];
+
+static void tThread_entry_wait(void *p1, void *p2, void *p3)
+{
+	int i = (int)p1;
+	u32_t options = (u32_t)p2;
+
+	received[i] = k_event_wait(&event, EV_A | EV_B, options, K_FOREVER);
+}
+
+static k_tid_t spawn_waiter(int i, u32_t options)
+{
+	received[i] = 0;
+	return k_thread_spawn(tstack[i], STACK_SIZE, tThread_entry_wait,
+			      (void *)i, (void *)options, NULL,
+			      K_PRIO_PREEMPT(0), 0, 0);
+}
+
+static void tIsr_entry(void *p)
+{
+	/**TESTPOINT: ISRs check for events without waiting*/
+	zassert_equal(k_event_wait(&event, EV_C, K_EVENT_WAIT_ANY, K_NO_WAIT),
+		      0, NULL);
+	k_event_post(&event, EV_A);
+}
+
+static void tevent_post_wait(struct k_event *pevent)
+{
+	zassert_equal(k_event_get(pevent), 0, NULL);
+	zassert_equal(k_event_wait(pevent, EV_A, K_EVENT_WAIT_ANY, K_NO_WAIT),
+		      0, NULL);
+
+	k_event_post(pevent, EV_A | EV_C);
+	zassert_equal(k_event_get(pevent), EV_A | EV_C, NULL);
+
+	/**TESTPOINT: the wait returns the events set among those waited*/
+	zassert_equal(k_event_wait(pevent, EV_A | EV_B, K_EVENT_WAIT_ANY,
+				   K_NO_WAIT), EV_A, NULL);
+	zassert_equal(k_event_get(pevent), EV_A | EV_C, NULL);
+
+	/**TESTPOINT: the events waited for are cleared on request*/
+	zassert_equal(k_event_wait(pevent, EV_A | EV_B, K_EVENT_WAIT_CLEAR,
+				   K_NO_WAIT), EV_A, NULL);
+	zassert_equal(k_event_get(pevent), EV_C, NULL);
+
+	k_event_clear(pevent, EV_C);
+}
+
+/*test cases*/
+void test_event_post_wait(void)
+{
+	/**TESTPOINT: test k_event_init event*/
+	k_event_init(&event);
+	tevent_post_wait(&event);
+
+	/**TESTPOINT: test K_EVENT_DEFINE event*/
+	tevent_post_wait(&kevent);
+}
+
+void test_event_set_clear(void)
+{
+	k_event_init(&event);
+
+	k_event_post(&event, EV_A | EV_B);
+
+	/**TESTPOINT: k_event_set replaces all the events*/
+	k_event_set(&event, EV_C);
+	zassert_equal(k_event_get(&event), EV_C, NULL);
+
+	/**TESTPOINT: k_event_clear returns the events before clearing*/
+	k_event_post(&event, EV_A);
+	zassert_equal(k_event_clear(&event, EV_A | EV_B), EV_A | EV_C, NULL);
+	zassert_equal(k_event_get(&event), EV_C, NULL);
+}
+
+void test_event_wait_all(void)
+{
+	k_event_init(&event);
+
+	spawn_waiter(0, K_EVENT_WAIT_ALL);
+	k_sleep(50);
+
+	/**TESTPOINT: a waiter for all events ignores part of them*/
+	zassert_equal(k_event_wait(&event, EV_A | EV_B, K_EVENT_WAIT_ALL,
+				   K_NO_WAIT), 0, NULL);
+	k_event_post(&event, EV_A);
+	k_sleep(50);
+	zassert_equal(received[0], 0, NULL);
+
+	k_event_post(&event, EV_B);
+	k_sleep(50);
+	zassert_equal(received[0], EV_A | EV_B, NULL);
+}
+
+void test_event_wait_skip(void)
+{
+	k_event_init(&event);
+
+	spawn_waiter(0, K_EVENT_WAIT_ALL);
+	spawn_waiter(1, K_EVENT_WAIT_ANY);
+	k_sleep(50);
+
+	/**TESTPOINT: a waiter whose condition is not met does not keep the
+	 * waiters after it from waking up
+	 */
+	k_event_post(&event, EV_A);
+	k_sleep(50);
+	zassert_equal(received[0], 0, NULL);
+	zassert_equal(received[1], EV_A, NULL);
+
+	k_event_post(&event, EV_B);
+	k_sleep(50);
+	zassert_equal(received[0], EV_A | EV_B, NULL);
+}
+
+void test_event_timeout(void)
+{
+	u32_t start;
+
+	k_event_init(&event);
+	k_event_post(&event, EV_C);
+
+	/**TESTPOINT: the wait times out when the events are not set*/
+	start = k_uptime_get_32();
+	zassert_equal(k_event_wait(&event, EV_A | EV_B, K_EVENT_WAIT_ANY,
+				   TIMEOUT), 0, NULL);
+	zassert_true(k_uptime_get_32() - start >= TIMEOUT, NULL);
+	zassert_equal(k_event_get(&event), EV_C, NULL);
+}
+
+void test_event_broadcast(void)
+{
+	int i;
+
+	k_event_init(&event);
+
+	spawn_waiter(0, K_EVENT_WAIT_CLEAR);
+	spawn_waiter(1, K_EVENT_WAIT_CLEAR);
+	spawn_waiter(2, K_EVENT_WAIT_ANY);
+	k_sleep(50);
+
+	/**TESTPOINT: one post wakes up every waiter whose condition is met*/
+	k_event_post(&event, EV_B | EV_C);
+	k_sleep(50);
+	for (i = 0; i < NUM_WAITERS; i++) {
+		zassert_equal(received[i], EV_B, NULL);
+	}
+
+	/**TESTPOINT: events are cleared after waking up all the waiters*/
+	zassert_equal(k_event_get(&event), EV_C, NULL);
+}
+
+void test_event_isr(void)
+{
+	k_event_init(&event);
+
+	spawn_waiter(0, K_EVENT_WAIT_CLEAR);
+	k_sleep(50);
+
+	/**TESTPOINT: ISRs post events to waiting threads*/
+	irq_offload(tIsr_entry, NULL);
+	k_sleep(50);
+	zassert_equal(received[0], EV_A, NULL);
+	zassert_equal(k_event_get(&event), 0, NULL);
+}
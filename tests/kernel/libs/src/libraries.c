@@ -245,6 +245,85 @@ void memcmp_test(void)
 	zassert_true((ret != 0), "memcmp 5");
 }
 
+/*
+ * buffers used during memory copy testing, large enough for word-at-a-time
+ * copies at every alignment
+ */
+
+#define MEMBUFSIZE 80
+#define MEMCHECK 0xa5
+
+static unsigned char mem_src[MEMBUFSIZE];
+static unsigned char mem_dst[MEMBUFSIZE];
+
+static void mem_pattern(unsigned char *buf)
+{
+	int i;
+
+	for (i = 0; i < MEMBUFSIZE; i++) {
+		buf[i] = i + 1;
+	}
+}
+
+/**
+ *
+ * @brief Test memory copy at every size and alignment combination
+ *
+ */
+
+void memcpy_test(void)
+{
+	int n, d_off, s_off, i;
+
+	mem_pattern(mem_src);
+
+	for (n = 0; n <= MEMBUFSIZE / 2; n++) {
+		for (d_off = 0; d_off < 8; d_off++) {
+			for (s_off = 0; s_off < 8; s_off++) {
+				memset(mem_dst, MEMCHECK, MEMBUFSIZE);
+				memcpy(mem_dst + d_off, mem_src + s_off, n);
+
+				for (i = 0; i < MEMBUFSIZE; i++) {
+					int in = i >= d_off && i < d_off + n;
+
+					zassert_equal(mem_dst[i], in ?
+						      mem_src[i - d_off + s_off] :
+						      MEMCHECK, "memcpy");
+				}
+			}
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test memory move with overlapping areas in both directions
+ *
+ */
+
+void memmove_test(void)
+{
+	int n, src, dst, i;
+
+	for (n = 0; n <= MEMBUFSIZE / 2; n++) {
+		for (src = 0; src < 8; src++) {
+			for (dst = 0; dst + n <= MEMBUFSIZE &&
+				      dst < src + n + 8; dst++) {
+				mem_pattern(mem_dst);
+				memmove(mem_dst + dst, mem_dst + src, n);
+
+				for (i = 0; i < MEMBUFSIZE; i++) {
+					int in = i >= dst && i < dst + n;
+
+					zassert_equal(mem_dst[i], in ?
+						      i - dst + src + 1 : i + 1,
+						      "memmove");
+				}
+			}
+		}
+	}
+}
+
 /**
  *
  * @brief Test string operations library
@@ -254,6 +333,8 @@ void string_test(void)
 {
 
 	memset_test();
+	memcpy_test();
+	memmove_test();
 	strlen_test();
 	strcmp_test();
 	strcpy_test();
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+extern void test_mheap_tlsf_malloc_free(void);
+extern void test_mheap_tlsf_stats(void);
+extern void test_mheap_tlsf_stats_total(void);
+extern void test_mheap_tlsf_merge(void);
+extern void test_mheap_tlsf_odd_sizes(void);
+
+/*test case main entry*/
+void test_main(void *p1, void *p2, void *p3)
+{
+	ztest_test_suite(test_mheap_tlsf,
+		ztest_unit_test(test_mheap_tlsf_malloc_free),
+		ztest_unit_test(test_mheap_tlsf_stats),
+		ztest_unit_test(test_mheap_tlsf_stats_total),
+		ztest_unit_test(test_mheap_tlsf_merge),
+		ztest_unit_test(test_mheap_tlsf_odd_sizes));
+	ztest_run_test_suite(test_mheap_tlsf);
+}
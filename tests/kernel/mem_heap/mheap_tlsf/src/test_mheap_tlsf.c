@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_mheap
+ * @{
+ * @defgroup t_mheap_tlsf test_mheap_tlsf
+ * @brief TestPurpose: verify the Two-Level Segregated Fit heap.
+ * - API coverage
+ *   -# k_malloc
+ *   -# k_free
+ *   -# k_malloc_stats_get
+ * @}
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define HEAP_SIZE CONFIG_HEAP_MEM_POOL_SIZE
+#define NUM_SMALL 16
+#define SMALL_SIZE 32
+#define NUM_ODD 10
+#define ODD_SIZE 300
+#define MAX_BLOCKS (HEAP_SIZE / SMALL_SIZE)
+
+static void *blocks[MAX_BLOCKS];
+
+static void heap_stats(struct k_malloc_stats *stats)
+{
+	k_malloc_stats_get(stats);
+
+	zassert_true(stats->largest_free_block <= stats->free_bytes, NULL);
+	zassert_true(stats->used_bytes + stats->free_bytes <= HEAP_SIZE, NULL);
+	zassert_true(stats->used_bytes <= stats->max_used_bytes, NULL);
+}
+
+/*test cases*/
+void test_mheap_tlsf_malloc_free(void)
+{
+	int i, j;
+
+	for (i = 0; i < NUM_SMALL; i++) {
+		/** TESTPOINT: blocks of any size are aligned and usable */
+		blocks[i] = k_malloc(i * 3);
+		zassert_not_null(blocks[i], NULL);
+		zassert_false((u32_t)blocks[i] & (sizeof(void *) - 1), NULL);
+		memset(blocks[i], i, i * 3);
+	}
+
+	/** TESTPOINT: allocated blocks do not overlap */
+	for (i = 0; i < NUM_SMALL; i++) {
+		for (j = 0; j < i * 3; j++) {
+			zassert_equal(((u8_t *)blocks[i])[j], i, NULL);
+		}
+	}
+
+	for (i = 0; i < NUM_SMALL; i++) {
+		k_free(blocks[i]);
+	}
+
+	/** TESTPOINT: requests larger than the heap fail */
+	zassert_is_null(k_malloc(HEAP_SIZE), NULL);
+	k_free(NULL);
+}
+
+void test_mheap_tlsf_stats(void)
+{
+	struct k_malloc_stats before, during, after;
+	void *block;
+
+	heap_stats(&before);
+	zassert_equal(before.used_bytes, 0, NULL);
+	zassert_equal(before.largest_free_block, before.free_bytes, NULL);
+
+	block = k_malloc(100);
+	zassert_not_null(block, NULL);
+
+	/** TESTPOINT: only the header and the rounding are wasted */
+	heap_stats(&during);
+	zassert_true(during.used_bytes >= 100, NULL);
+	zassert_true(during.used_bytes <= 100 + 4 * sizeof(void *), NULL);
+	zassert_equal(during.used_bytes + during.free_bytes, before.free_bytes,
+		      NULL);
+	zassert_true(during.max_used_bytes >= during.used_bytes, NULL);
+
+	k_free(block);
+
+	heap_stats(&after);
+	zassert_equal(after.used_bytes, 0, NULL);
+	zassert_equal(after.free_bytes, before.free_bytes, NULL);
+	zassert_equal(after.max_used_bytes, during.max_used_bytes, NULL);
+}
+
+void test_mheap_tlsf_stats_total(void)
+{
+	struct k_malloc_stats initial, stats;
+	size_t total;
+	int i;
+
+	heap_stats(&initial);
+	total = initial.used_bytes + initial.free_bytes;
+
+	for (i = 0; i < 3; i++) {
+		blocks[i] = k_malloc(SMALL_SIZE * (i + 1));
+		zassert_not_null(blocks[i], NULL);
+
+		heap_stats(&stats);
+		zassert_equal(stats.used_bytes + stats.free_bytes, total, NULL);
+	}
+
+	/**
+	 * TESTPOINT: the used and free bytes add up to the same total
+	 * whether the freed blocks merge or not
+	 */
+	for (i = 0; i < 3; i++) {
+		k_free(blocks[(i + 1) % 3]);
+
+		heap_stats(&stats);
+		zassert_equal(stats.used_bytes + stats.free_bytes, total, NULL);
+	}
+
+	zassert_equal(stats.free_bytes, initial.free_bytes, NULL);
+}
+
+void test_mheap_tlsf_merge(void)
+{
+	struct k_malloc_stats initial, stats;
+	int i, n;
+
+	heap_stats(&initial);
+
+	for (n = 0; n < MAX_BLOCKS; n++) {
+		blocks[n] = k_malloc(SMALL_SIZE);
+		if (!blocks[n]) {
+			break;
+		}
+	}
+	zassert_true(n > 0, NULL);
+
+	/* free every other block, so that freed blocks cannot merge */
+	for (i = 0; i < n; i += 2) {
+		k_free(blocks[i]);
+	}
+
+	/** TESTPOINT: non adjacent free blocks are not merged */
+	heap_stats(&stats);
+	zassert_true(stats.largest_free_block < 4 * SMALL_SIZE, NULL);
+	zassert_is_null(k_malloc(4 * SMALL_SIZE), NULL);
+
+	for (i = 1; i < n; i += 2) {
+		k_free(blocks[i]);
+	}
+
+	/** TESTPOINT: freed blocks merge back into a single block */
+	heap_stats(&stats);
+	zassert_equal(stats.largest_free_block, initial.largest_free_block,
+		      NULL);
+	blocks[0] = k_malloc(HEAP_SIZE / 2);
+	zassert_not_null(blocks[0], NULL);
+	k_free(blocks[0]);
+}
+
+void test_mheap_tlsf_odd_sizes(void)
+{
+	void *odd[NUM_ODD];
+	int i;
+
+	/**
+	 * TESTPOINT: a block size between two powers of two does not waste
+	 * the space up to the next one
+	 */
+	for (i = 0; i < NUM_ODD; i++) {
+		odd[i] = k_malloc(ODD_SIZE);
+		zassert_not_null(odd[i], NULL);
+	}
+
+	for (i = 0; i < NUM_ODD; i++) {
+		k_free(odd[i]);
+	}
+}
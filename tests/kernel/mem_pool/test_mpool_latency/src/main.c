@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+extern void test_mpool_latency_split(void);
+extern void test_mpool_latency_fragmented(void);
+
+/*test case main entry*/
+void test_main(void *p1, void *p2, void *p3)
+{
+	ztest_test_suite(test_mpool_latency,
+		ztest_unit_test(test_mpool_latency_split),
+		ztest_unit_test(test_mpool_latency_fragmented));
+	ztest_run_test_suite(test_mpool_latency);
+}
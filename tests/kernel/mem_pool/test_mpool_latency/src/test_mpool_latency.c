@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_mpool
+ * @{
+ * @defgroup t_mpool_latency test_mpool_latency
+ * @brief TestPurpose: measure worst-case memory pool allocation latency
+ * @}
+ */
+
+#include <ztest.h>
+#include <tc_util.h>
+
+#define BLK_SIZE_MIN 16
+#define BLK_SIZE_MAX 4096
+#define BLK_NUM_MAX 2
+#define BLK_ALIGN 4
+#define BLK_NUM_MIN (BLK_NUM_MAX * (BLK_SIZE_MAX / BLK_SIZE_MIN))
+#define LOOP 32
+
+K_MEM_POOL_DEFINE(lat_pool, BLK_SIZE_MIN, BLK_SIZE_MAX, BLK_NUM_MAX,
+		  BLK_ALIGN);
+
+static struct k_mem_block blocks[BLK_NUM_MIN];
+
+static u32_t timed_alloc(struct k_mem_block *block, size_t size, int expected)
+{
+	u32_t start, cycles;
+	int ret;
+
+	start = k_cycle_get_32();
+	ret = k_mem_pool_alloc(&lat_pool, block, size, K_NO_WAIT);
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(ret, expected, NULL);
+
+	return cycles;
+}
+
+static void report(const char *what, u32_t worst)
+{
+	TC_PRINT("%s: worst %u cycles = %u nsec\n", what, worst,
+		 SYS_CLOCK_HW_CYCLES_TO_NS(worst));
+}
+
+/*test cases*/
+void test_mpool_latency_split(void)
+{
+	struct k_mem_block block;
+	u32_t cycles, worst = 0;
+
+	/**
+	 * TESTPOINT: allocating the smallest block from an unused pool
+	 * splits a block at every level, which is the worst case
+	 */
+	for (int i = 0; i < LOOP; i++) {
+		cycles = timed_alloc(&block, BLK_SIZE_MIN, 0);
+		worst = max(worst, cycles);
+		k_mem_pool_free(&block);
+	}
+
+	report("smallest block split from a largest block", worst);
+}
+
+void test_mpool_latency_fragmented(void)
+{
+	struct k_mem_block block;
+	u32_t cycles, worst_hit = 0, worst_miss = 0;
+	int i;
+
+	for (i = 0; i < BLK_NUM_MIN; i++) {
+		zassert_equal(k_mem_pool_alloc(&lat_pool, &blocks[i],
+					       BLK_SIZE_MIN, K_NO_WAIT), 0,
+			      NULL);
+	}
+
+	/* free one smallest block out of four, so that none can merge */
+	for (i = 0; i < BLK_NUM_MIN; i += 4) {
+		k_mem_pool_free(&blocks[i]);
+	}
+
+	/**
+	 * TESTPOINT: with a fully fragmented pool, finding a free smallest
+	 * block and failing to find any larger block take bounded time
+	 */
+	for (i = 0; i < LOOP; i++) {
+		cycles = timed_alloc(&block, BLK_SIZE_MIN, 0);
+		worst_hit = max(worst_hit, cycles);
+		k_mem_pool_free(&block);
+
+		cycles = timed_alloc(&block, BLK_SIZE_MIN * 4, -ENOMEM);
+		worst_miss = max(worst_miss, cycles);
+	}
+
+	report("smallest block from a fragmented pool", worst_hit);
+	report("failed allocation from a fragmented pool", worst_miss);
+
+	/*test case tear down*/
+	for (i = 0; i < BLK_NUM_MIN; i++) {
+		if (i % 4) {
+			k_mem_pool_free(&blocks[i]);
+		}
+	}
+
+	/* the pool must have merged back into its largest blocks */
+	for (i = 0; i < BLK_NUM_MAX; i++) {
+		zassert_equal(k_mem_pool_alloc(&lat_pool, &blocks[i],
+					       BLK_SIZE_MAX, K_NO_WAIT), 0,
+			      NULL);
+	}
+	for (i = 0; i < BLK_NUM_MAX; i++) {
+		k_mem_pool_free(&blocks[i]);
+	}
+}
@@ -142,7 +142,15 @@ static void tmslab_used_get(void *data)
 /*test cases*/
 void test_mslab_kinit(void)
 {
-	k_mem_slab_init(&mslab, tslab, BLK_SIZE, BLK_NUM);
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	static struct k_mem_slab mslab_big;
+
+	/* rejected before the buffer is touched */
+	zassert_equal(k_mem_slab_init(&mslab_big, tslab, BLK_SIZE, 0x10000),
+		      -EINVAL, NULL);
+#endif
+	zassert_equal(k_mem_slab_init(&mslab, tslab, BLK_SIZE, BLK_NUM), 0,
+		      NULL);
 	zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
 	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM, NULL);
 }
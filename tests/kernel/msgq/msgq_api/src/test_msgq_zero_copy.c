@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_msgq_api
+ * @{
+ * @defgroup t_msgq_zero_copy test_msgq_zero_copy
+ * @brief TestPurpose: verify zephyr msgq in place send and receive
+ * - API coverage
+ *   -# k_msgq_reserve
+ *   -# k_msgq_commit
+ *   -# k_msgq_peek
+ *   -# k_msgq_release
+ * @}
+ */
+
+#include "test_msgq.h"
+
+static char __noinit __stack tstack[STACK_SIZE];
+static char __aligned(4) tbuffer[MSG_SIZE * MSGQ_LEN];
+static u32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+static struct k_msgq msgq;
+static struct k_sem end_sema;
+
+static void put_in_place(struct k_msgq *pmsgq, u32_t msg)
+{
+	u32_t *slot;
+
+	zassert_equal(k_msgq_reserve(pmsgq, (void **)&slot, K_NO_WAIT), 0,
+		      NULL);
+	*slot = msg;
+	k_msgq_commit(pmsgq);
+}
+
+static void get_in_place(struct k_msgq *pmsgq, u32_t msg)
+{
+	u32_t *slot;
+
+	zassert_equal(k_msgq_peek(pmsgq, (void **)&slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(*slot, msg, NULL);
+	k_msgq_release(pmsgq);
+}
+
+static void tPeek_entry(void *p1, void *p2, void *p3)
+{
+	u32_t *slot;
+
+	/**TESTPOINT: peek waits for a message*/
+	zassert_equal(k_msgq_peek(&msgq, (void **)&slot, TIMEOUT), 0, NULL);
+	zassert_equal(*slot, data[0], NULL);
+	k_msgq_release(&msgq);
+	k_sem_give(&end_sema);
+}
+
+static void tGet_entry(void *p1, void *p2, void *p3)
+{
+	u32_t rx_data;
+
+	/**TESTPOINT: a message sent in place is copied to a waiting get*/
+	zassert_equal(k_msgq_get(&msgq, &rx_data, TIMEOUT), 0, NULL);
+	zassert_equal(rx_data, data[1], NULL);
+	k_sem_give(&end_sema);
+}
+
+static void tReserve_entry(void *p1, void *p2, void *p3)
+{
+	u32_t *slot;
+
+	/**TESTPOINT: reserve waits for a free slot*/
+	zassert_equal(k_msgq_reserve(&msgq, (void **)&slot, TIMEOUT), 0,
+		      NULL);
+	*slot = data[1];
+	k_msgq_commit(&msgq);
+	k_sem_give(&end_sema);
+}
+
+/*test cases*/
+void test_msgq_zero_copy(void)
+{
+	void *slot;
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	/**TESTPOINT: peek from an empty msgq fails*/
+	zassert_equal(k_msgq_peek(&msgq, &slot, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_peek(&msgq, &slot, TIMEOUT), -EAGAIN, NULL);
+
+	/**TESTPOINT: a reserved slot is not free*/
+	zassert_equal(k_msgq_reserve(&msgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_num_free_get(&msgq), MSGQ_LEN - 1, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+	*(u32_t *)slot = data[0];
+	k_msgq_commit(&msgq);
+	zassert_equal(k_msgq_num_used_get(&msgq), 1, NULL);
+
+	/**TESTPOINT: messages sent in place and by copy keep their order*/
+	zassert_equal(k_msgq_put(&msgq, &data[1], K_NO_WAIT), 0, NULL);
+
+	/**TESTPOINT: reserve in a full msgq fails*/
+	zassert_equal(k_msgq_reserve(&msgq, &slot, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_reserve(&msgq, &slot, TIMEOUT), -EAGAIN, NULL);
+
+	/**TESTPOINT: a borrowed message stays in the msgq until released*/
+	zassert_equal(k_msgq_peek(&msgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(*(u32_t *)slot, data[0], NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), MSGQ_LEN, NULL);
+	k_msgq_release(&msgq);
+	zassert_equal(k_msgq_num_used_get(&msgq), 1, NULL);
+
+	get_in_place(&msgq, data[1]);
+
+	/* wrap around the ring buffer */
+	for (int i = 0; i < MSGQ_LEN * 2; i++) {
+		put_in_place(&msgq, i);
+		get_in_place(&msgq, i);
+	}
+}
+
+void test_msgq_zero_copy_wait(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+	k_sem_init(&end_sema, 0, 1);
+
+	/* the lower priority threads run and wait while the test sleeps */
+	k_thread_spawn(tstack, STACK_SIZE, tPeek_entry, NULL, NULL, NULL,
+		       K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT >> 1);
+	put_in_place(&msgq, data[0]);
+	k_sem_take(&end_sema, K_FOREVER);
+
+	k_thread_spawn(tstack, STACK_SIZE, tGet_entry, NULL, NULL, NULL,
+		       K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT >> 1);
+	put_in_place(&msgq, data[1]);
+	k_sem_take(&end_sema, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		put_in_place(&msgq, data[0]);
+	}
+	k_thread_spawn(tstack, STACK_SIZE, tReserve_entry, NULL, NULL, NULL,
+		       K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT >> 1);
+	get_in_place(&msgq, data[0]);
+	k_sem_take(&end_sema, K_FOREVER);
+	get_in_place(&msgq, data[0]);
+	get_in_place(&msgq, data[1]);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_mutex_api
+ * @{
+ * @defgroup t_mutex_prio_inherit test_mutex_prio_inherit
+ * @brief TestPurpose: verify priority inheritance through chains of owners
+ *                     and nested mutexes
+ * - API coverage
+ *   -# k_mutex_lock [FOREVER TIMEOUT]
+ *   -# k_mutex_unlock
+ * @}
+ */
+
+#include <ztest.h>
+
+#define TIMEOUT 200
+#define STACK_SIZE 512
+
+#define LOW_PRIO K_PRIO_PREEMPT(10)
+#define MID_PRIO K_PRIO_PREEMPT(8)
+#define HIGH_PRIO K_PRIO_PREEMPT(5)
+
+static K_MUTEX_DEFINE(mutex_a);
+static K_MUTEX_DEFINE(mutex_b);
+static K_SEM_DEFINE(release_sema, 0, 1);
+
+static char __noinit __stack tstack[3][STACK_SIZE];
+
+/* locks mutex_a, and mutex_b if asked, until release_sema is given */
+static void tThread_entry_low(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&mutex_a, K_FOREVER);
+	if (p1) {
+		k_mutex_lock(&mutex_b, K_FOREVER);
+	}
+
+	k_sem_take(&release_sema, K_FOREVER);
+
+	/* release in the order of locking, not the reverse one */
+	k_mutex_unlock(&mutex_a);
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      p1 ? HIGH_PRIO : LOW_PRIO, NULL);
+	if (p1) {
+		k_mutex_unlock(&mutex_b);
+	}
+	zassert_equal(k_thread_priority_get(k_current_get()), LOW_PRIO,
+		      NULL);
+}
+
+/* locks mutex_b, then waits on mutex_a */
+static void tThread_entry_mid(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&mutex_b, K_FOREVER);
+	zassert_false(k_mutex_lock(&mutex_a, K_FOREVER), NULL);
+	k_mutex_unlock(&mutex_a);
+	k_mutex_unlock(&mutex_b);
+}
+
+static void tThread_entry_high(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mutex_lock((struct k_mutex *)p1, (s32_t)p2),
+		      (s32_t)p2 == K_FOREVER ? 0 : -EAGAIN, NULL);
+	if ((s32_t)p2 == K_FOREVER) {
+		k_mutex_unlock((struct k_mutex *)p1);
+	}
+}
+
+/*test cases*/
+void test_mutex_prio_inherit_chain(void)
+{
+	k_tid_t low, mid, high;
+
+	low = k_thread_spawn(tstack[0], STACK_SIZE, tThread_entry_low,
+			     NULL, NULL, NULL, LOW_PRIO, 0, 0);
+	k_sleep(50);
+	mid = k_thread_spawn(tstack[1], STACK_SIZE, tThread_entry_mid,
+			     NULL, NULL, NULL, MID_PRIO, 0, 0);
+	k_sleep(50);
+
+	/**TESTPOINT: the owner inherits the priority of the waiter*/
+	zassert_equal(k_thread_priority_get(low), MID_PRIO, NULL);
+
+	high = k_thread_spawn(tstack[2], STACK_SIZE, tThread_entry_high,
+			      &mutex_b, (void *)TIMEOUT, NULL, HIGH_PRIO, 0, 0);
+	k_sleep(50);
+
+	/**TESTPOINT: the owner of the mutex the owner waits on inherits*/
+	zassert_equal(k_thread_priority_get(mid), HIGH_PRIO, NULL);
+	zassert_equal(k_thread_priority_get(low), HIGH_PRIO, NULL);
+
+	k_sleep(TIMEOUT);
+
+	/**TESTPOINT: the chain is deboosted when the waiter times out*/
+	zassert_equal(k_thread_priority_get(mid), MID_PRIO, NULL);
+	zassert_equal(k_thread_priority_get(low), MID_PRIO, NULL);
+
+	k_sem_give(&release_sema);
+	k_sleep(50);
+
+	k_thread_abort(low);
+	k_thread_abort(mid);
+	k_thread_abort(high);
+}
+
+void test_mutex_prio_inherit_nested(void)
+{
+	k_tid_t low, high_a, high_b;
+
+	low = k_thread_spawn(tstack[0], STACK_SIZE, tThread_entry_low,
+			     (void *)1, NULL, NULL, LOW_PRIO, 0, 0);
+	k_sleep(50);
+	high_a = k_thread_spawn(tstack[1], STACK_SIZE, tThread_entry_high,
+				&mutex_a, (void *)K_FOREVER, NULL, MID_PRIO,
+				0, 0);
+	high_b = k_thread_spawn(tstack[2], STACK_SIZE, tThread_entry_high,
+				&mutex_b, (void *)K_FOREVER, NULL, HIGH_PRIO,
+				0, 0);
+	k_sleep(50);
+
+	/**TESTPOINT: the owner inherits the highest waiter priority*/
+	zassert_equal(k_thread_priority_get(low), HIGH_PRIO, NULL);
+
+	/* the owner checks its priority as it unlocks each mutex */
+	k_sem_give(&release_sema);
+	k_sleep(50);
+
+	k_thread_abort(low);
+	k_thread_abort(high_a);
+	k_thread_abort(high_b);
+}
@@ -18,6 +18,9 @@ extern void test_pipe_get_fail(void);
 extern void test_pipe_block_put(void);
 extern void test_pipe_block_put_sema(void);
 extern void test_pipe_get_put(void);
+extern void test_pipe_putv_getv(void);
+extern void test_pipe_putv_to_reader(void);
+extern void test_pipe_getv_from_writer(void);
 
 /*test case main entry*/
 void test_main(void *p1, void *p2, void *p3)
@@ -28,6 +31,9 @@ void test_main(void *p1, void *p2, void *p3)
 		ztest_unit_test(test_pipe_get_fail),
 		ztest_unit_test(test_pipe_block_put),
 		ztest_unit_test(test_pipe_block_put_sema),
-		ztest_unit_test(test_pipe_get_put));
+		ztest_unit_test(test_pipe_get_put),
+		ztest_unit_test(test_pipe_putv_getv),
+		ztest_unit_test(test_pipe_putv_to_reader),
+		ztest_unit_test(test_pipe_getv_from_writer));
 	ztest_run_test_suite(test_pipe_api);
 }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_pipe_api
+ * @{
+ * @defgroup t_pipe_iovec test_pipe_iovec
+ * @brief TestPurpose: verify scattered pipe transfers
+ * - API coverage
+ *   -# k_pipe_putv
+ *   -# k_pipe_getv
+ * @}
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE 1024
+#define PIPE_LEN 16
+#define DATA_LEN 16
+
+static unsigned char __aligned(4) data[] = "abcd1234$%^&PIPE";
+static unsigned char rx_data[DATA_LEN];
+
+/* segment boundaries differ on each side, the empty segment is skipped */
+static const struct k_pipe_iovec tx_iov[] = {
+	{ &data[0], 3 },
+	{ &data[3], 0 },
+	{ &data[3], 8 },
+	{ &data[11], 5 },
+};
+
+static const struct k_pipe_iovec rx_iov[] = {
+	{ &rx_data[0], 6 },
+	{ &rx_data[6], 1 },
+	{ &rx_data[7], 9 },
+};
+
+K_PIPE_DEFINE(iov_pipe, PIPE_LEN, 4);
+/* without ring buffer, the data goes straight between the threads */
+K_PIPE_DEFINE(iov_direct_pipe, 0, 4);
+
+static char __noinit __stack tstack[STACK_SIZE];
+
+static void tpipe_putv(struct k_pipe *ppipe, s32_t timeout)
+{
+	size_t wt_byte = 0;
+
+	/**TESTPOINT: pipe putv*/
+	zassert_false(k_pipe_putv(ppipe, tx_iov, ARRAY_SIZE(tx_iov),
+				  &wt_byte, DATA_LEN, timeout), NULL);
+	zassert_equal(wt_byte, DATA_LEN, NULL);
+}
+
+static void tpipe_getv(struct k_pipe *ppipe, s32_t timeout)
+{
+	size_t rd_byte = 0;
+
+	memset(rx_data, 0, sizeof(rx_data));
+
+	/**TESTPOINT: pipe getv*/
+	zassert_false(k_pipe_getv(ppipe, rx_iov, ARRAY_SIZE(rx_iov),
+				  &rd_byte, DATA_LEN, timeout), NULL);
+	zassert_equal(rd_byte, DATA_LEN, NULL);
+	zassert_false(memcmp(rx_data, data, DATA_LEN), NULL);
+}
+
+static void tpipe_putv_entry(void *p1, void *p2, void *p3)
+{
+	tpipe_putv((struct k_pipe *)p1, K_FOREVER);
+}
+
+static void tpipe_getv_entry(void *p1, void *p2, void *p3)
+{
+	tpipe_getv((struct k_pipe *)p1, K_FOREVER);
+}
+
+/*test cases*/
+void test_pipe_putv_getv(void)
+{
+	tpipe_putv(&iov_pipe, K_NO_WAIT);
+	tpipe_getv(&iov_pipe, K_NO_WAIT);
+}
+
+void test_pipe_putv_to_reader(void)
+{
+	k_tid_t tid = k_thread_spawn(tstack, STACK_SIZE,
+				     tpipe_putv_entry, &iov_direct_pipe,
+				     NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+
+	/* the writer copies into the segments of the pending reader */
+	tpipe_getv(&iov_direct_pipe, K_FOREVER);
+	k_thread_abort(tid);
+}
+
+void test_pipe_getv_from_writer(void)
+{
+	k_tid_t tid = k_thread_spawn(tstack, STACK_SIZE,
+				     tpipe_getv_entry, &iov_direct_pipe,
+				     NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+
+	/* the reader copies from the segments of the pending writer */
+	tpipe_putv(&iov_direct_pipe, K_FOREVER);
+	k_thread_abort(tid);
+}
@@ -91,7 +91,8 @@ void test_poll_no_wait(void)
 
 static struct k_sem wait_sem = K_SEM_INITIALIZER(wait_sem, 0, 1);
 static struct k_fifo wait_fifo = K_FIFO_INITIALIZER(wait_fifo);
-static struct k_poll_signal wait_signal = K_POLL_SIGNAL_INITIALIZER();
+static struct k_poll_signal wait_signal =
+	K_POLL_SIGNAL_INITIALIZER(wait_signal);
 
 struct fifo_msg wait_msg = { NULL, FIFO_MSG_VALUE };
 
@@ -291,61 +292,139 @@ void test_poll_wait(void)
 	wait_signal.signaled = 0;
 }
 
-/* verify -EADDRINUSE return value when object has already a poller */
-static struct k_sem eaddrinuse_sem = K_SEM_INITIALIZER(eaddrinuse_sem, 0, 1);
-static struct k_sem eaddrinuse_reply =
-	K_SEM_INITIALIZER(eaddrinuse_reply, 0, 1);
+/* verify that several threads can poll on the same objects */
+static struct k_sem multi_sem = K_SEM_INITIALIZER(multi_sem, 0, 1);
+static struct k_sem multi_reply = K_SEM_INITIALIZER(multi_reply, 0, 1);
+static struct k_sem multi_done = K_SEM_INITIALIZER(multi_done, 0, 2);
+static struct k_poll_signal multi_exit = K_POLL_SIGNAL_INITIALIZER(multi_exit);
+static int multi_woken;
 
-static __stack __noinit char eaddrinuse_hogger_stack[KB(1)];
+static __stack __noinit char multi_stack[2][KB(1)];
 
-static void eaddrinuse_hogger(void *p1, void *p2, void *p3)
+static void multi_poller(void *p1, void *p2, void *p3)
 {
 	(void)p1; (void)p2; (void)p3;
 
-	struct k_poll_event event;
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &multi_sem),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &multi_exit),
+	};
 
-	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
-			  K_POLL_MODE_NOTIFY_ONLY, &eaddrinuse_sem);
+	while (1) {
+		(void)k_poll(events, ARRAY_SIZE(events), K_FOREVER);
 
-	(void)k_poll(&event, 1, K_FOREVER);
-	k_sem_take(&eaddrinuse_sem, K_FOREVER);
-	k_sem_give(&eaddrinuse_reply);
-}
+		if (events[1].state == K_POLL_STATE_SIGNALED) {
+			break;
+		}
+
+		multi_woken++;
+		if (k_sem_take(&multi_sem, K_NO_WAIT) == 0) {
+			k_sem_give(&multi_reply);
+		}
+
+		events[0].state = K_POLL_STATE_NOT_READY;
+	}
 
-static struct k_sem eaddrinuse_ready_sem =
-	K_SEM_INITIALIZER(eaddrinuse_ready_sem, 1, 1);
+	k_sem_give(&multi_done);
+}
 
-void test_poll_eaddrinuse(void)
+void test_poll_multi(void)
 {
 	int old_prio = k_thread_priority_get(k_current_get());
 	const int main_low_prio = 10;
 	int rc;
 
-	struct k_poll_event events[] = {
-		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
-					 K_POLL_MODE_NOTIFY_ONLY,
-					 &eaddrinuse_sem),
-		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
-					 K_POLL_MODE_NOTIFY_ONLY,
-					 &eaddrinuse_ready_sem),
-	};
-
 	k_thread_priority_set(k_current_get(), main_low_prio);
 
-	k_thread_spawn(eaddrinuse_hogger_stack, KB(1), eaddrinuse_hogger,
+	/* the pollers run right away and poll on the semaphore */
+	k_thread_spawn(multi_stack[0], KB(1), multi_poller,
 		       0, 0, 0, main_low_prio - 1, 0, 0);
+	k_thread_spawn(multi_stack[1], KB(1), multi_poller,
+		       0, 0, 0, main_low_prio - 1, 0, 0);
+
+	k_sem_give(&multi_sem);
+	rc = k_sem_take(&multi_reply, K_SECONDS(1));
 
-	rc = k_poll(events, ARRAY_SIZE(events), K_SECONDS(1));
+	/** TESTPOINT: only one poller acquires the semaphore */
+	zassert_equal(rc, 0, "");
+	zassert_equal(k_sem_count_get(&multi_sem), 0, "");
+#ifdef CONFIG_POLL_WAKE_ONE
+	zassert_equal(multi_woken, 1, "");
+#else
+	zassert_equal(multi_woken, 2, "");
+#endif
+
+	/** TESTPOINT: a poll signal notifies all the pollers */
+	k_poll_signal(&multi_exit, 0);
+	zassert_equal(k_sem_take(&multi_done, K_SECONDS(1)), 0, "");
+	zassert_equal(k_sem_take(&multi_done, K_SECONDS(1)), 0, "");
 
 	k_thread_priority_set(k_current_get(), old_prio);
+}
 
-	zassert_equal(rc, -EADDRINUSE, "");
-	zassert_equal(events[0].state, K_POLL_STATE_EADDRINUSE, "");
-	zassert_equal(events[1].state, K_POLL_STATE_SEM_AVAILABLE, "");
+/* verify that a poller woken up already does not take the wakeup of another */
+static struct k_sem stale_sems[] = {
+	K_SEM_INITIALIZER(stale_sems[0], 0, 1),
+	K_SEM_INITIALIZER(stale_sems[1], 0, 1),
+};
+static struct k_sem stale_done = K_SEM_INITIALIZER(stale_done, 0, 2);
 
-	/* free hogger, ensuring it awoken from k_poll() and got the sem */
-	k_sem_give(&eaddrinuse_sem);
-	rc = k_sem_take(&eaddrinuse_reply, K_SECONDS(1));
+static __stack __noinit char stale_stack[2][KB(1)];
 
-	zassert_equal(rc, 0, "");
+/* polls on stale_sems[first] up to the last one, takes stale_sems[first] */
+static void stale_poller(void *p1, void *p2, void *p3)
+{
+	(void)p2; (void)p3;
+
+	int first = (int)p1;
+	struct k_poll_event events[ARRAY_SIZE(stale_sems)];
+	int i;
+
+	for (i = first; i < ARRAY_SIZE(stale_sems); i++) {
+		k_poll_event_init(&events[i - first],
+				  K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &stale_sems[i]);
+	}
+
+	if (k_poll(events, ARRAY_SIZE(stale_sems) - first,
+		   K_SECONDS(1)) == 0 &&
+	    k_sem_take(&stale_sems[first], K_NO_WAIT) == 0) {
+		k_sem_give(&stale_done);
+	}
+}
+
+void test_poll_stale(void)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	const int main_low_prio = 10;
+
+	k_thread_priority_set(k_current_get(), main_low_prio);
+
+	/*
+	 * The first poller polls on both semaphores, the second one only on
+	 * the last semaphore, behind the first poller.
+	 */
+	k_thread_spawn(stale_stack[0], KB(1), stale_poller,
+		       (void *)0, 0, 0, main_low_prio - 2, 0, 0);
+	k_thread_spawn(stale_stack[1], KB(1), stale_poller,
+		       (void *)1, 0, 0, main_low_prio - 1, 0, 0);
+
+	/* both semaphores are given before the first poller runs */
+	k_sched_lock();
+	k_sem_give(&stale_sems[0]);
+	k_sem_give(&stale_sems[1]);
+	k_sched_unlock();
+
+	/**
+	 * TESTPOINT: the last semaphore wakes up the second poller, as the
+	 * first one has been woken up already
+	 */
+	zassert_equal(k_sem_take(&stale_done, K_SECONDS(1)), 0, "");
+	zassert_equal(k_sem_take(&stale_done, K_SECONDS(1)), 0, "");
+
+	k_thread_priority_set(k_current_get(), old_prio);
 }
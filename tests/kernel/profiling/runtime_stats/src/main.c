@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_kernel_profiling
+ * @{
+ * @defgroup t_runtime_stats test_runtime_stats
+ * @brief TestPurpose: verify thread runtime accounting
+ * - API coverage
+ *   -# k_thread_runtime_get
+ *   -# k_cpu_stats_get
+ * @}
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define BUSY_MS 50
+#define SLEEP_MS 100
+
+static char __noinit __stack tstack[STACK_SIZE];
+static struct k_sem end_sema;
+
+static u64_t ms_to_cycles(u32_t ms)
+{
+	return (u64_t)ms * sys_clock_hw_cycles_per_sec / MSEC_PER_SEC;
+}
+
+static void busy_entry(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+	k_sem_give(&end_sema);
+}
+
+/*test cases*/
+void test_runtime_busy(void)
+{
+	u64_t before, after;
+	u32_t start, elapsed;
+
+	before = k_thread_runtime_get(k_current_get());
+	start = k_cycle_get_32();
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+	elapsed = k_cycle_get_32() - start;
+	after = k_thread_runtime_get(k_current_get());
+
+	/** TESTPOINT: a running thread is charged with the elapsed time */
+	zassert_true(after - before >= elapsed, NULL);
+	zassert_true(after - before <= elapsed + ms_to_cycles(1), NULL);
+}
+
+void test_runtime_sleep(void)
+{
+	struct k_cpu_stats before, after;
+	u64_t runtime;
+
+	runtime = k_thread_runtime_get(k_current_get());
+	k_cpu_stats_get(&before);
+	k_sleep(SLEEP_MS);
+	k_cpu_stats_get(&after);
+	runtime = k_thread_runtime_get(k_current_get()) - runtime;
+
+	/** TESTPOINT: a sleeping thread is not charged, the idle thread is */
+	zassert_true(runtime < ms_to_cycles(SLEEP_MS / 10), NULL);
+	zassert_true(after.idle_cycles - before.idle_cycles >=
+		     ms_to_cycles(SLEEP_MS * 9 / 10), NULL);
+	zassert_true(after.busy_cycles >= before.busy_cycles, NULL);
+}
+
+void test_runtime_thread(void)
+{
+	struct k_cpu_stats before, after;
+	u64_t runtime;
+	k_tid_t tid;
+
+	k_sem_init(&end_sema, 0, 1);
+
+	k_cpu_stats_get(&before);
+	tid = k_thread_spawn(tstack, STACK_SIZE, busy_entry, NULL, NULL, NULL,
+			     K_PRIO_PREEMPT(0), 0, 0);
+	k_sem_take(&end_sema, K_FOREVER);
+	runtime = k_thread_runtime_get(tid);
+	k_cpu_stats_get(&after);
+
+	/** TESTPOINT: each thread is charged with its own execution time */
+	zassert_true(runtime >= ms_to_cycles(BUSY_MS), NULL);
+	zassert_true(after.busy_cycles - before.busy_cycles >= runtime, NULL);
+}
+
+void test_main(void *p1, void *p2, void *p3)
+{
+	ztest_test_suite(test_runtime_stats,
+		ztest_unit_test(test_runtime_busy),
+		ztest_unit_test(test_runtime_sleep),
+		ztest_unit_test(test_runtime_thread));
+	ztest_run_test_suite(test_runtime_stats);
+}
@@ -17,6 +17,8 @@ extern void test_queue_thread2isr(void);
 extern void test_queue_isr2thread(void);
 extern void test_queue_get_fail(void);
 extern void test_queue_loop(void);
+extern void test_queue_get_batch(void);
+extern void test_fifo_get_batch(void);
 
 /*test case main entry*/
 void test_main(void *p1, void *p2, void *p3)
@@ -26,6 +28,8 @@ void test_main(void *p1, void *p2, void *p3)
 		ztest_unit_test(test_queue_thread2isr),
 		ztest_unit_test(test_queue_isr2thread),
 		ztest_unit_test(test_queue_get_fail),
-		ztest_unit_test(test_queue_loop));
+		ztest_unit_test(test_queue_loop),
+		ztest_unit_test(test_queue_get_batch),
+		ztest_unit_test(test_fifo_get_batch));
 	ztest_run_test_suite(test_queue_api);
 }
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_queue_api
+ * @{
+ * @defgroup t_queue_get_batch test_queue_get_batch
+ * @brief TestPurpose: verify zephyr queue batch get
+ * - API coverage
+ *   -# k_queue_get_batch
+ * @}
+ */
+
+#include "test_queue.h"
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define LIST_LEN 8
+#define TIMEOUT 100
+
+static qdata_t data[LIST_LEN];
+static struct k_queue queue;
+static char __noinit __stack tstack[STACK_SIZE];
+
+static void tqueue_fill(struct k_queue *pqueue)
+{
+	for (int i = 0; i < LIST_LEN; i++) {
+		data[i].data = i;
+		k_queue_append(pqueue, (void *)&data[i]);
+	}
+}
+
+static void tlist_check(sys_slist_t *list, int first, int count)
+{
+	qdata_t *rx_data;
+
+	for (int i = first; i < first + count; i++) {
+		rx_data = (qdata_t *)sys_slist_get(list);
+		zassert_equal(rx_data, &data[i], NULL);
+	}
+	zassert_true(sys_slist_is_empty(list), NULL);
+}
+
+static void tThread_entry(void *p1, void *p2, void *p3)
+{
+	k_sleep(TIMEOUT / 2);
+
+	/* the waiting thread runs once all the items are in the queue */
+	k_sched_lock();
+	tqueue_fill((struct k_queue *)p1);
+	k_sched_unlock();
+}
+
+/*test cases*/
+void test_queue_get_batch(void)
+{
+	sys_slist_t list;
+
+	k_queue_init(&queue);
+	sys_slist_init(&list);
+
+	/**TESTPOINT: batch get from an empty queue returns no item*/
+	zassert_equal(k_queue_get_batch(&queue, &list, 0, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_queue_get_batch(&queue, &list, 0, TIMEOUT), 0, NULL);
+	zassert_true(sys_slist_is_empty(&list), NULL);
+
+	/**TESTPOINT: batch get of all the items*/
+	tqueue_fill(&queue);
+	zassert_equal(k_queue_get_batch(&queue, &list, 0, K_NO_WAIT),
+		      LIST_LEN, NULL);
+	zassert_true(k_queue_is_empty(&queue), NULL);
+	tlist_check(&list, 0, LIST_LEN);
+
+	/**TESTPOINT: batch get of up to max items*/
+	tqueue_fill(&queue);
+	zassert_equal(k_queue_get_batch(&queue, &list, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_queue_get_batch(&queue, &list, 3, K_NO_WAIT), 3, NULL);
+	tlist_check(&list, 0, 6);
+	zassert_equal(k_queue_get_batch(&queue, &list, 3, K_NO_WAIT), 2, NULL);
+	zassert_true(k_queue_is_empty(&queue), NULL);
+	tlist_check(&list, 6, 2);
+
+	/**TESTPOINT: the queue still works once emptied by a batch get*/
+	k_queue_append(&queue, (void *)&data[0]);
+	zassert_equal(k_queue_get(&queue, K_NO_WAIT), &data[0], NULL);
+
+	/**TESTPOINT: batch get waits for the first item*/
+	k_thread_spawn(tstack, STACK_SIZE, tThread_entry, &queue, NULL, NULL,
+		       K_PRIO_PREEMPT(0), 0, 0);
+	zassert_equal(k_queue_get_batch(&queue, &list, 4, K_FOREVER), 4, NULL);
+	tlist_check(&list, 0, 4);
+	zassert_equal(k_queue_get_batch(&queue, &list, 0, K_NO_WAIT), 4, NULL);
+	tlist_check(&list, 4, 4);
+}
+
+void test_fifo_get_batch(void)
+{
+	struct k_fifo fifo;
+	sys_slist_t list;
+
+	k_fifo_init(&fifo);
+	sys_slist_init(&list);
+
+	/**TESTPOINT: fifo batch get*/
+	tqueue_fill((struct k_queue *)&fifo);
+	zassert_equal(k_fifo_get_batch(&fifo, &list, 0, K_NO_WAIT), LIST_LEN,
+		      NULL);
+	zassert_true(k_fifo_is_empty(&fifo), NULL);
+	tlist_check(&list, 0, LIST_LEN);
+}
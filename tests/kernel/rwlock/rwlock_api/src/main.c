@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_rwlock
+ * @{
+ * @defgroup t_rwlock_api test_rwlock_api
+ * @}
+ */
+
+#include <ztest.h>
+extern void test_rwlock_read_shared(void);
+extern void test_rwlock_write_exclusive(void);
+extern void test_rwlock_writer_preference(void);
+extern void test_rwlock_writer_timeout(void);
+extern void test_rwlock_prio_inherit(void);
+extern void test_rwlock_prio_inherit_mutex(void);
+extern void test_rwlock_poll(void);
+
+/*test case main entry*/
+void test_main(void *p1, void *p2, void *p3)
+{
+	ztest_test_suite(test_rwlock_api,
+			 ztest_unit_test(test_rwlock_read_shared),
+			 ztest_unit_test(test_rwlock_write_exclusive),
+			 ztest_unit_test(test_rwlock_writer_preference),
+			 ztest_unit_test(test_rwlock_writer_timeout),
+			 ztest_unit_test(test_rwlock_prio_inherit),
+			 ztest_unit_test(test_rwlock_prio_inherit_mutex),
+			 ztest_unit_test(test_rwlock_poll));
+	ztest_run_test_suite(test_rwlock_api);
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_rwlock_api
+ * @{
+ * @defgroup t_rwlock_lock test_rwlock_lock
+ * @brief TestPurpose: verify reader-writer lock sharing, exclusion, writer
+ *                     preference, priority inheritance, also combined with
+ *                     mutexes, and polling
+ * - API coverage
+ *   -# k_rwlock_init K_RWLOCK_DEFINE
+ *   -# k_rwlock_read_lock [FOREVER NO_WAIT TIMEOUT]
+ *   -# k_rwlock_read_unlock
+ *   -# k_rwlock_write_lock [FOREVER NO_WAIT TIMEOUT]
+ *   -# k_rwlock_write_unlock
+ *   -# k_poll [K_POLL_TYPE_RWLOCK_READABLE K_POLL_TYPE_RWLOCK_WRITABLE]
+ * @}
+ */
+
+#include <ztest.h>
+
+#define TIMEOUT 200
+#define STACK_SIZE 512
+
+#define LOW_PRIO K_PRIO_PREEMPT(10)
+#define MID_PRIO K_PRIO_PREEMPT(7)
+#define HIGH_PRIO K_PRIO_PREEMPT(5)
+
+/**TESTPOINT: init via K_RWLOCK_DEFINE*/
+K_RWLOCK_DEFINE(krwlock);
+static struct k_rwlock rwlock;
+static struct k_mutex mutex;
+static K_SEM_DEFINE(release_sema, 0, 1);
+
+static char __noinit __stack tstack[3][STACK_SIZE];
+
+static volatile int done[3];
+
+static void tThread_entry_read_no_wait(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_read_lock(p1, K_NO_WAIT), 0, NULL);
+	k_rwlock_read_unlock(p1);
+	done[0] = 1;
+}
+
+static void tThread_entry_excluded(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_read_lock(p1, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_rwlock_write_lock(p1, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_rwlock_read_lock(p1, TIMEOUT / 2), -EAGAIN, NULL);
+	zassert_equal(k_rwlock_write_lock(p1, TIMEOUT / 2), -EAGAIN, NULL);
+	done[0] = 1;
+}
+
+static void tThread_entry_write(void *p1, void *p2, void *p3)
+{
+	s32_t timeout = (s32_t)p2;
+
+	if (timeout == K_FOREVER) {
+		zassert_equal(k_rwlock_write_lock(p1, timeout), 0, NULL);
+		k_rwlock_write_unlock(p1);
+	} else {
+		zassert_equal(k_rwlock_write_lock(p1, timeout), -EAGAIN, NULL);
+	}
+	done[0] = 1;
+}
+
+static void tThread_entry_read(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_read_lock(p1, K_FOREVER), 0, NULL);
+	k_rwlock_read_unlock(p1);
+	done[1] = 1;
+}
+
+static void tThread_entry_write_held(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_rwlock_write_lock(p1, K_FOREVER), 0, NULL);
+	k_sem_take(&release_sema, K_FOREVER);
+	k_rwlock_write_unlock(p1);
+}
+
+static void tThread_entry_mutex(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mutex_lock(p1, K_FOREVER), 0, NULL);
+	k_mutex_unlock(p1);
+	done[2] = 1;
+}
+
+static void lock_nested(int use_mutex)
+{
+	if (use_mutex) {
+		zassert_equal(k_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	} else {
+		zassert_equal(k_rwlock_write_lock(&rwlock, K_FOREVER), 0, NULL);
+	}
+}
+
+static void unlock_nested(int use_mutex)
+{
+	if (use_mutex) {
+		k_mutex_unlock(&mutex);
+	} else {
+		k_rwlock_write_unlock(&rwlock);
+	}
+}
+
+/* takes the mutex and the lock in the order given, releases the first one
+ * taken first
+ */
+static void tThread_entry_nested_held(void *p1, void *p2, void *p3)
+{
+	int mutex_first = (int)p1;
+
+	lock_nested(mutex_first);
+	lock_nested(!mutex_first);
+
+	k_sem_take(&release_sema, K_FOREVER);
+	unlock_nested(mutex_first);
+
+	k_sem_take(&release_sema, K_FOREVER);
+	unlock_nested(!mutex_first);
+}
+
+static void tThread_entry_poll(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event *events = p2;
+
+	zassert_equal(k_poll(events, 2, K_FOREVER), 0, NULL);
+	done[0] = 1;
+}
+
+static k_tid_t spawn(int i, void (*entry_fn)(void *, void *, void *),
+		     void *p1, void *p2, int prio)
+{
+	done[i] = 0;
+	return k_thread_spawn(tstack[i], STACK_SIZE, entry_fn, p1, p2, NULL,
+			      prio, 0, 0);
+}
+
+static void trwlock_test_read_shared(struct k_rwlock *prwlock)
+{
+	zassert_equal(k_rwlock_read_lock(prwlock, K_FOREVER), 0, NULL);
+
+	spawn(0, tThread_entry_read_no_wait, prwlock, NULL, K_PRIO_PREEMPT(0));
+	k_sleep(50);
+
+	/**TESTPOINT: readers share the lock*/
+	zassert_true(done[0], NULL);
+
+	k_rwlock_read_unlock(prwlock);
+}
+
+/*test cases*/
+void test_rwlock_read_shared(void)
+{
+	/**TESTPOINT: test k_rwlock_init rwlock*/
+	k_rwlock_init(&rwlock);
+	trwlock_test_read_shared(&rwlock);
+
+	/**TESTPOINT: test K_RWLOCK_DEFINE rwlock*/
+	trwlock_test_read_shared(&krwlock);
+}
+
+void test_rwlock_write_exclusive(void)
+{
+	k_rwlock_init(&rwlock);
+	zassert_equal(k_rwlock_write_lock(&rwlock, TIMEOUT), 0, NULL);
+
+	spawn(0, tThread_entry_excluded, &rwlock, NULL, K_PRIO_PREEMPT(0));
+	k_sleep(2 * TIMEOUT);
+
+	/**TESTPOINT: a writer excludes readers and writers*/
+	zassert_true(done[0], NULL);
+
+	k_rwlock_write_unlock(&rwlock);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+	k_rwlock_write_unlock(&rwlock);
+}
+
+void test_rwlock_writer_preference(void)
+{
+	k_rwlock_init(&rwlock);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+
+	spawn(0, tThread_entry_write, &rwlock, (void *)K_FOREVER,
+	      K_PRIO_PREEMPT(0));
+	k_sleep(50);
+
+	/**TESTPOINT: readers wait behind a waiting writer*/
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY, NULL);
+	zassert_false(done[0], NULL);
+
+	/**TESTPOINT: the last reader hands the lock to the writer*/
+	k_rwlock_read_unlock(&rwlock);
+	k_sleep(50);
+	zassert_true(done[0], NULL);
+}
+
+void test_rwlock_writer_timeout(void)
+{
+	k_rwlock_init(&rwlock);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0, NULL);
+
+	spawn(0, tThread_entry_write, &rwlock, (void *)TIMEOUT,
+	      K_PRIO_PREEMPT(0));
+	k_sleep(50);
+	spawn(1, tThread_entry_read, &rwlock, NULL, K_PRIO_PREEMPT(0));
+	k_sleep(50);
+	zassert_false(done[1], NULL);
+
+	/**TESTPOINT: readers get the lock once the writer gives up*/
+	k_sleep(TIMEOUT);
+	zassert_true(done[0], NULL);
+	zassert_true(done[1], NULL);
+
+	k_rwlock_read_unlock(&rwlock);
+}
+
+void test_rwlock_prio_inherit(void)
+{
+	k_tid_t writer;
+
+	k_rwlock_init(&rwlock);
+
+	writer = spawn(0, tThread_entry_write_held, &rwlock, NULL, LOW_PRIO);
+	k_sleep(50);
+	spawn(1, tThread_entry_read, &rwlock, NULL, HIGH_PRIO);
+	k_sleep(50);
+
+	/**TESTPOINT: the writer inherits the priority of the waiter*/
+	zassert_equal(k_thread_priority_get(writer), HIGH_PRIO, NULL);
+
+	k_sem_give(&release_sema);
+	k_sleep(50);
+
+	/**TESTPOINT: the writer gets its priority back on unlock*/
+	zassert_true(done[1], NULL);
+	zassert_equal(k_thread_priority_get(writer), LOW_PRIO, NULL);
+}
+
+static void trwlock_test_prio_inherit_mutex(int mutex_first)
+{
+	k_tid_t holder;
+
+	k_rwlock_init(&rwlock);
+	k_mutex_init(&mutex);
+
+	holder = spawn(0, tThread_entry_nested_held, (void *)mutex_first, NULL,
+		       LOW_PRIO);
+	k_sleep(50);
+
+	/* the lock taken first gets the higher priority waiter */
+	if (mutex_first) {
+		spawn(2, tThread_entry_mutex, &mutex, NULL, HIGH_PRIO);
+		k_sleep(50);
+		spawn(1, tThread_entry_read, &rwlock, NULL, MID_PRIO);
+	} else {
+		spawn(1, tThread_entry_read, &rwlock, NULL, HIGH_PRIO);
+		k_sleep(50);
+		spawn(2, tThread_entry_mutex, &mutex, NULL, MID_PRIO);
+	}
+	k_sleep(50);
+
+	/**TESTPOINT: the holder inherits from the waiters of both locks*/
+	zassert_equal(k_thread_priority_get(holder), HIGH_PRIO, NULL);
+
+	k_sem_give(&release_sema);
+	k_sleep(50);
+
+	/**TESTPOINT: the waiter of the lock still held keeps boosting it*/
+	zassert_equal(k_thread_priority_get(holder), MID_PRIO, NULL);
+
+	k_sem_give(&release_sema);
+	k_sleep(50);
+
+	/**TESTPOINT: the holder gets its priority back on the last unlock*/
+	zassert_true(done[1] && done[2], NULL);
+	zassert_equal(k_thread_priority_get(holder), LOW_PRIO, NULL);
+}
+
+void test_rwlock_prio_inherit_mutex(void)
+{
+	trwlock_test_prio_inherit_mutex(1);
+	trwlock_test_prio_inherit_mutex(0);
+}
+
+void test_rwlock_poll(void)
+{
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_RWLOCK_READABLE,
+					 K_POLL_MODE_NOTIFY_ONLY, &rwlock),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_RWLOCK_WRITABLE,
+					 K_POLL_MODE_NOTIFY_ONLY, &rwlock),
+	};
+
+	k_rwlock_init(&rwlock);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0, NULL);
+
+	spawn(0, tThread_entry_poll, &rwlock, events, K_PRIO_PREEMPT(0));
+	k_sleep(50);
+	zassert_false(done[0], NULL);
+
+	/**TESTPOINT: pollers are notified when the writer unlocks*/
+	k_rwlock_write_unlock(&rwlock);
+	k_sleep(50);
+	zassert_true(done[0], NULL);
+	zassert_equal(events[0].state, K_POLL_STATE_RWLOCK_READABLE, NULL);
+	zassert_equal(events[1].state, K_POLL_STATE_RWLOCK_WRITABLE, NULL);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_kernel_threads
+ * @{
+ * @defgroup t_threads_deadline test_threads_deadline
+ * @brief TestPurpose: verify earliest deadline first scheduling
+ * - API coverage
+ *   -# k_thread_deadline_set
+ * @}
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_THREADS 3
+#define DEADLINE_PRIO CONFIG_SCHED_DEADLINE_PRIO
+
+/*
+ * Periodic workload: execution time and period of each task, in units of
+ * UNIT_MS. The utilization is 3/6 + 4/9 = 94%, above the 83% bound of
+ * rate monotonic scheduling for two tasks. With rate monotonic priorities
+ * the second task misses its first deadline by one unit in every
+ * hyperperiod, while any workload up to 100% is schedulable by EDF.
+ */
+#define UNIT_MS 50
+#define HYPERPERIOD 18
+#define NUM_HYPERPERIODS 2
+
+/* lateness tolerated on top of the deadline, for the tick granularity */
+#define TOLERANCE_MS 20
+
+struct task {
+	int wcet;
+	int period;
+	int jobs;
+	int misses;
+};
+
+static char __noinit __stack tstack[NUM_THREADS][STACK_SIZE];
+static struct task tasks[2];
+static u32_t loops_per_unit;
+static u32_t start_ms;
+static struct k_sem end_sema;
+
+static int order[NUM_THREADS];
+static int num_ran;
+
+static int ms_to_cycles(int ms)
+{
+	return (s64_t)ms * sys_clock_hw_cycles_per_sec / MSEC_PER_SEC;
+}
+
+static void spin(u32_t loops)
+{
+	volatile u32_t i;
+
+	for (i = 0; i < loops; i++) {
+	}
+}
+
+/*
+ * Work is counted in loop iterations instead of elapsed time, so that the
+ * time a task spends preempted does not count as done.
+ */
+static void calibrate(void)
+{
+	u32_t loops = 100000;
+	u32_t cycles = k_cycle_get_32();
+
+	spin(loops);
+	cycles = k_cycle_get_32() - cycles;
+
+	loops_per_unit = (u64_t)loops * ms_to_cycles(UNIT_MS) / cycles;
+}
+
+static void task_entry(void *p1, void *p2, void *p3)
+{
+	struct task *task = p1;
+	u32_t end_ms = start_ms + NUM_HYPERPERIODS * HYPERPERIOD * UNIT_MS;
+	u32_t release = start_ms;
+	int period_ms = task->period * UNIT_MS;
+
+	while (release + period_ms <= end_ms) {
+		s32_t delay = release - k_uptime_get_32();
+
+		if (delay > 0) {
+			k_sleep(delay);
+		}
+
+		k_thread_deadline_set(k_current_get(),
+				      ms_to_cycles(release + period_ms -
+						   k_uptime_get_32()));
+
+		spin(task->wcet * loops_per_unit);
+
+		task->jobs++;
+		if ((s32_t)(k_uptime_get_32() - release) >
+		    period_ms + TOLERANCE_MS) {
+			task->misses++;
+		}
+
+		release += period_ms;
+	}
+
+	k_sem_give(&end_sema);
+}
+
+static void run_workload(int prio1, int prio2)
+{
+	int i;
+
+	tasks[0] = (struct task){ .wcet = 3, .period = 6 };
+	tasks[1] = (struct task){ .wcet = 4, .period = 9 };
+
+	k_sem_init(&end_sema, 0, ARRAY_SIZE(tasks));
+
+	/* start the releases on a tick boundary */
+	k_sleep(1);
+	calibrate();
+	start_ms = k_uptime_get_32() + UNIT_MS;
+
+	k_thread_spawn(tstack[0], STACK_SIZE, task_entry, &tasks[0],
+		       NULL, NULL, prio1, 0, 0);
+	k_thread_spawn(tstack[1], STACK_SIZE, task_entry, &tasks[1],
+		       NULL, NULL, prio2, 0, 0);
+
+	for (i = 0; i < ARRAY_SIZE(tasks); i++) {
+		k_sem_take(&end_sema, K_FOREVER);
+	}
+
+	zassert_equal(tasks[0].jobs, NUM_HYPERPERIODS * HYPERPERIOD / 6, NULL);
+	zassert_equal(tasks[1].jobs, NUM_HYPERPERIODS * HYPERPERIOD / 9, NULL);
+}
+
+static void order_entry(void *p1, void *p2, void *p3)
+{
+	order[num_ran++] = (int)p1;
+}
+
+/*test cases*/
+void test_deadline_order(void)
+{
+	/* relative deadlines in ms, the threads run from the earliest one */
+	static const int deadlines[NUM_THREADS] = { 30, 10, 20 };
+	k_tid_t tid[NUM_THREADS];
+	int i;
+
+	num_ran = 0;
+
+	/* the cooperative test thread keeps running until it sleeps */
+	for (i = 0; i < NUM_THREADS; i++) {
+		tid[i] = k_thread_spawn(tstack[i], STACK_SIZE, order_entry,
+					(void *)i, NULL, NULL, DEADLINE_PRIO,
+					0, 0);
+		k_thread_deadline_set(tid[i], ms_to_cycles(deadlines[i]));
+	}
+
+	k_sleep(100);
+
+	/** TESTPOINT: threads of the deadline prio run by deadline */
+	zassert_equal(num_ran, NUM_THREADS, NULL);
+	zassert_equal(order[0], 1, NULL);
+	zassert_equal(order[1], 2, NULL);
+	zassert_equal(order[2], 0, NULL);
+}
+
+void test_deadline_preempt(void)
+{
+	k_tid_t tid;
+
+	num_ran = 0;
+
+	k_thread_priority_set(k_current_get(), DEADLINE_PRIO);
+	k_thread_deadline_set(k_current_get(), ms_to_cycles(1000));
+
+	/* the new thread is due after the test thread */
+	k_sched_lock();
+	tid = k_thread_spawn(tstack[0], STACK_SIZE, order_entry, (void *)0,
+			     NULL, NULL, DEADLINE_PRIO, 0, 0);
+	k_thread_deadline_set(tid, ms_to_cycles(2000));
+	k_sched_unlock();
+	zassert_equal(num_ran, 0, NULL);
+
+	/** TESTPOINT: an earlier deadline preempts the current thread */
+	k_thread_deadline_set(tid, 0);
+	zassert_equal(num_ran, 1, NULL);
+
+	k_thread_priority_set(k_current_get(), -1);
+}
+
+void test_deadline_edf_workload(void)
+{
+	run_workload(DEADLINE_PRIO, DEADLINE_PRIO);
+
+	/** TESTPOINT: EDF meets every deadline of the workload */
+	zassert_equal(tasks[0].misses, 0, NULL);
+	zassert_equal(tasks[1].misses, 0, NULL);
+}
+
+void test_deadline_rm_workload(void)
+{
+	run_workload(DEADLINE_PRIO + 1, DEADLINE_PRIO + 2);
+
+	/** TESTPOINT: rate monotonic priorities miss deadlines */
+	zassert_equal(tasks[0].misses, 0, NULL);
+	zassert_true(tasks[1].misses >= NUM_HYPERPERIODS, NULL);
+}
+
+void test_main(void *p1, void *p2, void *p3)
+{
+	ztest_test_suite(test_threads_deadline,
+		ztest_unit_test(test_deadline_order),
+		ztest_unit_test(test_deadline_preempt),
+		ztest_unit_test(test_deadline_edf_workload),
+		ztest_unit_test(test_deadline_rm_workload));
+	ztest_run_test_suite(test_threads_deadline);
+}
@@ -30,6 +30,7 @@ void test_main(void *p1, void *p2, void *p3)
 		ztest_unit_test(test_timer_status_get_anytime),
 		ztest_unit_test(test_timer_status_sync),
 		ztest_unit_test(test_timer_k_define),
-		ztest_unit_test(test_timer_user_data));
+		ztest_unit_test(test_timer_user_data),
+		ztest_unit_test(test_timer_slack));
 	ztest_run_test_suite(test_timer_api);
 }
@@ -22,5 +22,6 @@ void test_timer_status_get_anytime(void);
 void test_timer_status_sync(void);
 void test_timer_k_define(void);
 void test_timer_user_data(void);
+void test_timer_slack(void);
 
 #endif /* __TEST_TIMER_H__ */
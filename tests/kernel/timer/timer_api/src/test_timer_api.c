@@ -10,6 +10,10 @@
 #define DURATION 100
 #define PERIOD 50
 #define EXPIRE_TIMES 4
+#define SLACK 30
+#define SLACK_PERIODS 10
+/* tick granularity of the expiry times */
+#define TOLERANCE 20
 static void duration_expire(struct k_timer *timer);
 static void duration_stop(struct k_timer *timer);
 
@@ -72,6 +76,18 @@ static void status_expire(struct k_timer *timer)
 	}
 }
 
+static void slack_expire(struct k_timer *timer)
+{
+	s64_t due = tdata.timestamp + DURATION + tdata.expire_cnt * PERIOD;
+	s64_t now = k_uptime_get();
+
+	/** TESTPOINT: the slack only delays the expiry, by at most itself */
+	TIMER_ASSERT(now >= due, timer);
+	TIMER_ASSERT(now <= due + SLACK + TOLERANCE, timer);
+
+	tdata.expire_cnt++;
+}
+
 static void busy_wait_ms(s32_t ms)
 {
 #ifdef CONFIG_TICKLESS_KERNEL
@@ -210,6 +226,24 @@ void test_timer_k_define(void)
 	k_timer_stop(&ktimer);
 }
 
+void test_timer_slack(void)
+{
+	init_timer_data();
+	k_timer_init(&timer, slack_expire, NULL);
+	/** TESTPOINT: set the slack of a periodic timer */
+	k_timer_slack_set(&timer, SLACK);
+	k_timer_start(&timer, DURATION, PERIOD);
+	tdata.timestamp = k_uptime_get();
+	busy_wait_ms(DURATION + PERIOD * SLACK_PERIODS - 1);
+
+	/** TESTPOINT: the period is kept despite the slack */
+	TIMER_ASSERT(tdata.expire_cnt >= SLACK_PERIODS - 1, &timer);
+	TIMER_ASSERT(tdata.expire_cnt <= SLACK_PERIODS, &timer);
+
+	/* cleanup environment */
+	k_timer_stop(&timer);
+}
+
 /* k_timer_user_data_set/get test */
 
 static void user_data_timer_handler(struct k_timer *timer);
@@ -18,6 +18,7 @@ extern void test_delayed_work_cancel_from_queue_thread(void);
 extern void test_delayed_work_cancel_from_queue_isr(void);
 extern void test_delayed_work_cancel_thread(void);
 extern void test_delayed_work_cancel_isr(void);
+extern void test_work_q_pool(void);
 
 /*test case main entry*/
 void test_main(void *p1, void *p2, void *p3)
@@ -35,6 +36,7 @@ void test_main(void *p1, void *p2, void *p3)
 		ztest_unit_test(test_delayed_work_cancel_from_queue_thread),
 		ztest_unit_test(test_delayed_work_cancel_from_queue_isr),
 		ztest_unit_test(test_delayed_work_cancel_thread),
-		ztest_unit_test(test_delayed_work_cancel_isr));
+		ztest_unit_test(test_delayed_work_cancel_isr),
+		ztest_unit_test(test_work_q_pool));
 	ztest_run_test_suite(test_workq_api);
 }
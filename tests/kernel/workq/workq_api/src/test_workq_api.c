@@ -13,6 +13,7 @@
  *   -# k_work_init
  *   -# k_delayed_work_init
  *   -# k_work_q_start
+ *   -# k_work_q_pool_start
  *   -# k_work_submit_to_queue
  *   -# k_work_submit
  *   -# k_delayed_work_submit_to_queue
@@ -32,7 +33,10 @@
 #define NUM_OF_WORK 2
 
 static char __noinit __stack tstack[STACK_SIZE];
-static struct k_work_q workq;
+static char __noinit __stack pool_stacks[NUM_OF_WORK][STACK_SIZE];
+static struct k_work_q workq, pool_workq;
+static struct k_work pool_work[NUM_OF_WORK];
+static struct k_sem block_sema;
 static struct k_work work[NUM_OF_WORK];
 static struct k_delayed_work delayed_work[NUM_OF_WORK], delayed_work_sleepy;
 static struct k_sem sync_sema;
@@ -48,6 +52,12 @@ static void work_handler(struct k_work *w)
 	k_sem_give(&sync_sema);
 }
 
+static void work_blocking(struct k_work *w)
+{
+	k_sem_take(&block_sema, K_FOREVER);
+	k_sem_give(&sync_sema);
+}
+
 static void twork_submit(void *data)
 {
 	struct k_work_q *work_q = (struct k_work_q *)data;
@@ -275,3 +285,23 @@ void test_delayed_work_cancel_isr(void)
 		k_sem_take(&sync_sema, K_FOREVER);
 	}
 }
+
+void test_work_q_pool(void)
+{
+	k_sem_reset(&sync_sema);
+	k_sem_init(&block_sema, 0, 1);
+	k_work_q_pool_start(&pool_workq, pool_stacks[0], STACK_SIZE,
+			    NUM_OF_WORK, CONFIG_MAIN_THREAD_PRIORITY);
+
+	k_work_init(&pool_work[0], work_blocking);
+	k_work_init(&pool_work[1], work_handler);
+	k_work_submit_to_queue(&pool_workq, &pool_work[0]);
+	k_work_submit_to_queue(&pool_workq, &pool_work[1]);
+
+	/**TESTPOINT: a blocked handler does not stall the pool*/
+	zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0, NULL);
+	zassert_false(k_work_pending(&pool_work[0]), NULL);
+
+	k_sem_give(&block_sema);
+	zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0, NULL);
+}
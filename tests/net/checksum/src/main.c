@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of the Internet checksum
+ *
+ * Reports the cycles per byte net_calc_chksum() takes on UDP packets made
+ * of full fragments and of odd sized fragments, next to a reference that
+ * sums one 16-bit word at a time, and the cost of updating the checksum of
+ * a packet for a change of its UDP header with net_chksum_update().
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include "timestamp.h"
+
+#include "net_private.h"
+
+#define NUM_ROUNDS 20
+#define MAX_LEN 1280
+
+u32_t tm_off;
+
+static const struct in6_addr src_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0,
+					      0, 0, 0, 0, 0, 0, 0, 0,
+					      0, 0x1 } } };
+static const struct in6_addr dst_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0,
+					      0, 0, 0, 0, 0, 0x4e, 0x11,
+					      0, 0, 0x2 } } };
+
+/* Sum one 16-bit big endian word at a time */
+static u16_t ref_chksum(u16_t sum, const u8_t *ptr, u16_t len, bool *odd)
+{
+	u16_t tmp;
+
+	for (; len; len--, ptr++) {
+		tmp = *odd ? *ptr : *ptr << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		*odd = !*odd;
+	}
+
+	return sum;
+}
+
+static u16_t ref_chksum_pkt(struct net_pkt *pkt)
+{
+	struct net_buf *frag = pkt->frags;
+	u16_t hdr_len = net_pkt_ip_hdr_len(pkt);
+	u16_t len = net_pkt_get_len(pkt) - hdr_len;
+	bool odd = false;
+	u16_t sum;
+
+	sum = ref_chksum(len + IPPROTO_UDP,
+			 (u8_t *)&NET_IPV6_HDR(pkt)->src,
+			 2 * sizeof(struct in6_addr), &odd);
+	sum = ref_chksum(sum, frag->data + hdr_len, frag->len - hdr_len,
+			 &odd);
+
+	for (frag = frag->frags; frag; frag = frag->frags) {
+		sum = ref_chksum(sum, frag->data, frag->len, &odd);
+	}
+
+	return htons(sum);
+}
+
+static struct net_pkt *setup_pkt(u16_t len, u16_t frag_len)
+{
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	u16_t hdr_len = sizeof(struct net_ipv6_hdr);
+	u16_t i, n;
+
+	pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, hdr_len);
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	len += hdr_len;
+
+	while (len) {
+		frag = net_pkt_get_reserve_rx_data(0, K_FOREVER);
+		net_pkt_frag_add(pkt, frag);
+
+		n = min(len, frag_len);
+		for (i = 0; i < n; i++) {
+			net_buf_add_u8(frag, sys_rand32_get());
+		}
+
+		len -= n;
+	}
+
+	NET_IPV6_HDR(pkt)->vtc = 0x60;
+	NET_IPV6_HDR(pkt)->nexthdr = IPPROTO_UDP;
+	NET_IPV6_HDR(pkt)->len[0] = (net_pkt_get_len(pkt) - hdr_len) >> 8;
+	NET_IPV6_HDR(pkt)->len[1] = net_pkt_get_len(pkt) - hdr_len;
+	net_ipaddr_copy(&NET_IPV6_HDR(pkt)->src, &src_addr);
+	net_ipaddr_copy(&NET_IPV6_HDR(pkt)->dst, &dst_addr);
+
+	NET_UDP_HDR(pkt)->chksum = 0;
+
+	return pkt;
+}
+
+/* Print the cycles per byte with 2 decimals */
+static void print_cpb(const char *name, u32_t cycles, u32_t bytes)
+{
+	u32_t cpb = (u64_t)cycles * 100 / bytes;
+
+	TC_PRINT("   %s: %u.%02u tcs/byte\n", name, cpb / 100, cpb % 100);
+}
+
+static int measure(u16_t len, u16_t frag_len)
+{
+	struct net_pkt *pkt = setup_pkt(len, frag_len);
+	u32_t ts, cycles = 0, ref_cycles = 0;
+	u16_t chksum = 0, ref = 0;
+	int i;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		ts = TIME_STAMP_DELTA_GET(0);
+		chksum = net_calc_chksum_udp(pkt);
+		cycles += TIME_STAMP_DELTA_GET(ts);
+
+		ts = TIME_STAMP_DELTA_GET(0);
+		ref = ref_chksum_pkt(pkt);
+		ref_cycles += TIME_STAMP_DELTA_GET(ts);
+	}
+
+	net_pkt_unref(pkt);
+
+	TC_PRINT(" %u bytes in fragments of %u bytes:\n", len,
+		 min(frag_len, len + sizeof(struct net_ipv6_hdr)));
+	print_cpb("16-bit words  ", ref_cycles, NUM_ROUNDS * len);
+	print_cpb("net_calc_chksum", cycles, NUM_ROUNDS * len);
+
+	if (chksum != ref) {
+		TC_ERROR("checksum 0x%04x, should be 0x%04x\n", ntohs(chksum),
+			 ntohs(ref));
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+static int measure_update(void)
+{
+	struct net_pkt *pkt = setup_pkt(MAX_LEN, CONFIG_NET_BUF_DATA_SIZE);
+	struct net_udp_hdr orig_hdr, *udp_hdr = NET_UDP_HDR(pkt);
+	u32_t ts, cycles = 0, full_cycles = 0;
+	u16_t chksum = 0, full = 0;
+	int i;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		udp_hdr->chksum = 0;
+		udp_hdr->chksum = ~net_calc_chksum_udp(pkt);
+
+		/* rewrite the ports, as a NAT would */
+		orig_hdr = *udp_hdr;
+		udp_hdr->src_port = htons(sys_rand32_get());
+		udp_hdr->dst_port = htons(sys_rand32_get());
+
+		ts = TIME_STAMP_DELTA_GET(0);
+		chksum = net_chksum_update(udp_hdr->chksum, &orig_hdr, udp_hdr,
+					   sizeof(orig_hdr));
+		cycles += TIME_STAMP_DELTA_GET(ts);
+
+		ts = TIME_STAMP_DELTA_GET(0);
+		udp_hdr->chksum = 0;
+		full = ~net_calc_chksum_udp(pkt);
+		full_cycles += TIME_STAMP_DELTA_GET(ts);
+
+		if (chksum != full) {
+			break;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	TC_PRINT(" Port change in a %u bytes packet: update %u tcs, "
+		 "full %u tcs\n", MAX_LEN, cycles / NUM_ROUNDS,
+		 full_cycles / NUM_ROUNDS);
+
+	if (chksum != full) {
+		TC_ERROR("updated checksum 0x%04x, should be 0x%04x\n",
+			 ntohs(chksum), ntohs(full));
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+void main(void)
+{
+	static const u16_t lens[] = { 64, 256, MAX_LEN };
+	int i, status = TC_PASS;
+
+	TC_START("Internet checksum benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	for (i = 0; i < ARRAY_SIZE(lens) && status == TC_PASS; i++) {
+		status = measure(lens[i], CONFIG_NET_BUF_DATA_SIZE);
+		if (status == TC_PASS) {
+			status = measure(lens[i], 37);
+		}
+	}
+
+	if (status == TC_PASS) {
+		status = measure_update();
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of finding the connection of a received packet
+ *
+ * Registers 8, 64 and then 512 UDP connections, half of them connected to
+ * a remote end point and half of them listening on a local port, and
+ * reports the average time net_conn_input() takes to hand a packet to
+ * each of them.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include "timestamp.h"
+
+#include "connection.h"
+#include "net_private.h"
+
+#define NUM_ROUNDS 10
+
+#define CONNECTED_PORT 10000
+#define LISTEN_PORT 20000
+#define LOCAL_PORT 4242
+
+u32_t tm_off;
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0x4e, 0x11, 0, 0, 0x2 } } };
+
+static int num_conns;
+static int matched;
+
+static enum net_verdict demux_cb(struct net_conn *conn, struct net_pkt *pkt,
+				 void *user_data)
+{
+	matched = POINTER_TO_INT(user_data);
+
+	return NET_OK;
+}
+
+/* even connections are connected to the peer, odd ones are listening */
+static int register_conns(int count)
+{
+	struct sockaddr_in6 remote = { .sin6_family = AF_INET6 };
+	struct sockaddr_in6 local = { .sin6_family = AF_INET6 };
+	int ret;
+
+	net_ipaddr_copy(&remote.sin6_addr, &peer_addr);
+	net_ipaddr_copy(&local.sin6_addr, &my_addr);
+
+	for (; num_conns < count; num_conns++) {
+		if (num_conns % 2 == 0) {
+			ret = net_conn_register(IPPROTO_UDP,
+						(struct sockaddr *)&remote,
+						(struct sockaddr *)&local,
+						CONNECTED_PORT + num_conns,
+						LOCAL_PORT, demux_cb,
+						INT_TO_POINTER(num_conns),
+						NULL);
+		} else {
+			ret = net_conn_register(IPPROTO_UDP, NULL, NULL, 0,
+						LISTEN_PORT + num_conns,
+						demux_cb,
+						INT_TO_POINTER(num_conns),
+						NULL);
+		}
+
+		if (ret < 0) {
+			TC_ERROR("cannot register connection %d (%d)\n",
+				 num_conns, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static struct net_pkt *setup_pkt(void)
+{
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+
+	pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+	frag = net_pkt_get_frag(pkt, K_FOREVER);
+	net_pkt_frag_add(pkt, frag);
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	net_buf_add(frag, sizeof(struct net_ipv6_hdr) +
+		    sizeof(struct net_udp_hdr));
+
+	NET_IPV6_HDR(pkt)->vtc = 0x60;
+	NET_IPV6_HDR(pkt)->nexthdr = IPPROTO_UDP;
+	net_ipaddr_copy(&NET_IPV6_HDR(pkt)->src, &peer_addr);
+	net_ipaddr_copy(&NET_IPV6_HDR(pkt)->dst, &my_addr);
+
+	return pkt;
+}
+
+static int measure(struct net_pkt *pkt)
+{
+	u32_t ts, cycles[2] = { 0, 0 };
+	int i, round;
+
+	for (round = 0; round < NUM_ROUNDS; round++) {
+		for (i = 0; i < num_conns; i++) {
+			if (i % 2 == 0) {
+				NET_UDP_HDR(pkt)->src_port =
+					htons(CONNECTED_PORT + i);
+				NET_UDP_HDR(pkt)->dst_port = htons(LOCAL_PORT);
+			} else {
+				NET_UDP_HDR(pkt)->src_port = htons(1234);
+				NET_UDP_HDR(pkt)->dst_port =
+					htons(LISTEN_PORT + i);
+			}
+
+			matched = -1;
+
+			ts = TIME_STAMP_DELTA_GET(0);
+			net_conn_input(IPPROTO_UDP, pkt);
+			cycles[i % 2] += TIME_STAMP_DELTA_GET(ts);
+
+			if (matched != i) {
+				TC_ERROR("packet for %d matched %d\n", i,
+					 matched);
+				return TC_FAIL;
+			}
+		}
+	}
+
+	TC_PRINT(" %3d connections: connected %u tcs = %u nsec, "
+		 "listening %u tcs = %u nsec\n", num_conns,
+		 cycles[0] / (NUM_ROUNDS * num_conns / 2),
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles[0],
+					       NUM_ROUNDS * num_conns / 2),
+		 cycles[1] / (NUM_ROUNDS * num_conns / 2),
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cycles[1],
+					       NUM_ROUNDS * num_conns / 2));
+
+	return TC_PASS;
+}
+
+void main(void)
+{
+	static const int counts[] = { 8, 64, 512 };
+	struct net_pkt *pkt;
+	int i, status = TC_PASS;
+
+	TC_START("Connection demultiplexing benchmark");
+
+	bench_test_init();
+
+	TC_PRINT("tcs = timer clock cycles: 1 tcs is %u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS(1));
+
+	pkt = setup_pkt();
+
+	for (i = 0; i < ARRAY_SIZE(counts) && status == TC_PASS; i++) {
+		if (register_conns(counts[i]) < 0) {
+			status = TC_FAIL;
+			break;
+		}
+
+		status = measure(pkt);
+	}
+
+	net_pkt_unref(pkt);
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
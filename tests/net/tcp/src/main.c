@@ -1071,6 +1071,247 @@ static bool test_v4_seq_check(void)
 	return true;
 }
 
+static bool test_v6_syn_options(void)
+{
+	struct net_tcp *tcp = v6_ctx->tcp;
+	struct net_tcp_options opts;
+	struct net_pkt *pkt = NULL;
+	u8_t ext = 0;
+	int ret;
+
+	ret = net_tcp_prepare_segment(tcp, NET_TCP_SYN, NULL, 0, NULL,
+				      (struct sockaddr *)&peer_v6_addr, &pkt);
+	if (ret) {
+		printk("Prepare segment failed (%d)\n", ret);
+		return false;
+	}
+
+	ret = net_tcp_parse_opts(pkt, &opts);
+	if (ret) {
+		printk("Cannot parse the SYN options (%d)\n", ret);
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		ext |= NET_TCP_EXT_WSCALE;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		ext |= NET_TCP_EXT_SACK;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS)) {
+		ext |= NET_TCP_EXT_TS;
+	}
+
+	if (opts.mss != net_tcp_get_recv_mss(tcp) || opts.ext != ext) {
+		printk("SYN options do not match (mss %u ext 0x%x)\n",
+		       opts.mss, opts.ext);
+		return false;
+	}
+
+	/* The window of a SYN is never scaled */
+	if (sys_get_be16(NET_TCP_HDR(pkt)->wnd) !=
+	    min(CONFIG_NET_TCP_RECV_WINDOW, 0xffff)) {
+		printk("SYN window does not match (%u)\n",
+		       sys_get_be16(NET_TCP_HDR(pkt)->wnd));
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+/* Received segment of len bytes at offset seq in the stream */
+static struct net_pkt *v6_segment(struct net_tcp *tcp, u32_t seq, u16_t len)
+{
+	struct net_pkt *pkt = NULL;
+
+	if (net_tcp_prepare_segment(tcp, NET_TCP_ACK, NULL, 0, NULL,
+				    (struct sockaddr *)&peer_v6_addr, &pkt)) {
+		return NULL;
+	}
+
+	sys_put_be32(seq, NET_TCP_HDR(pkt)->seq);
+	net_pkt_set_appdatalen(pkt, len);
+
+	return pkt;
+}
+
+static bool test_v6_sack_option(void)
+{
+	struct net_tcp *tcp = v6_ctx->tcp;
+	u32_t base = tcp->send_ack;
+	/* The last segment received goes in the first block */
+	static const u16_t offsets[] = { 600, 200, 300 };
+	static const u32_t blocks[][2] = { { 200, 400 }, { 600, 700 } };
+	struct net_tcp_options opts;
+	struct net_pkt *pkt = NULL;
+	int i, ret;
+
+	tcp->ext = NET_TCP_EXT_SACK;
+
+	for (i = 0; i < ARRAY_SIZE(offsets); i++) {
+		pkt = v6_segment(tcp, base + offsets[i], 100);
+		if (!pkt || net_tcp_ooo_add(tcp, pkt)) {
+			printk("Cannot queue segment at %u\n", offsets[i]);
+			return false;
+		}
+	}
+
+	pkt = v6_segment(tcp, base + 200, 100);
+	if (!pkt || net_tcp_ooo_add(tcp, pkt) != -EALREADY) {
+		printk("Duplicate segment queued\n");
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+	pkt = NULL;
+
+	ret = net_tcp_prepare_ack(tcp, (struct sockaddr *)&peer_v6_addr,
+				  &pkt);
+	if (ret || net_tcp_parse_opts(pkt, &opts)) {
+		printk("Cannot prepare the ACK (%d)\n", ret);
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+
+	if (opts.sack_blocks != ARRAY_SIZE(blocks)) {
+		printk("Wrong number of SACK blocks (%u)\n",
+		       opts.sack_blocks);
+		return false;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (opts.sack[i].left != base + blocks[i][0] ||
+		    opts.sack[i].right != base + blocks[i][1]) {
+			printk("SACK block %d does not match\n", i);
+			return false;
+		}
+	}
+
+	/* Fill the first hole, the segments after it come out in order */
+	tcp->send_ack = base + 200;
+
+	for (i = 0; i < 2; i++) {
+		pkt = net_tcp_ooo_get(tcp);
+		if (!pkt || sys_get_be32(NET_TCP_HDR(pkt)->seq) !=
+		    tcp->send_ack) {
+			printk("Segment at %u not delivered\n",
+			       tcp->send_ack - base);
+			return false;
+		}
+
+		tcp->send_ack += net_pkt_appdatalen(pkt);
+		net_pkt_unref(pkt);
+	}
+
+	if (net_tcp_ooo_get(tcp)) {
+		printk("Segment delivered before the second hole\n");
+		return false;
+	}
+
+	tcp->send_ack = base + 600;
+	pkt = net_tcp_ooo_get(tcp);
+	if (!pkt) {
+		printk("Last segment not delivered\n");
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+
+	tcp->send_ack = base;
+	tcp->ext = 0;
+
+	return true;
+}
+
+/* Segments received in reverse order after a lost one, beyond what the
+ * queue holds
+ */
+#define REORDERED (CONFIG_NET_TCP_OOO_QUEUE_LEN + 2)
+#define REORDERED_LEN 100
+
+static bool test_v6_ooo_queue(void)
+{
+	struct net_tcp *tcp = v6_ctx->tcp;
+	u32_t base = tcp->send_ack;
+	struct net_pkt *pkt;
+	int i, delivered = 0, resent;
+
+	/* Without window scaling the peer was offered at most 64 KiB, a
+	 * segment ending beyond that is out of the window.
+	 */
+	tcp->recv_wscale = 0;
+	pkt = v6_segment(tcp, base + min(CONFIG_NET_TCP_RECV_WINDOW, 0xffff) -
+			 REORDERED_LEN / 2, REORDERED_LEN);
+	if (!pkt || net_tcp_ooo_add(tcp, pkt) != -ENOMEM) {
+		printk("Segment queued beyond the window\n");
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+
+	for (i = REORDERED; i > 0; i--) {
+		pkt = v6_segment(tcp, base + i * REORDERED_LEN,
+				 REORDERED_LEN);
+		if (!pkt || net_tcp_ooo_add(tcp, pkt)) {
+			printk("Cannot queue segment %d\n", i);
+			return false;
+		}
+	}
+
+	if (tcp->ooo_count != CONFIG_NET_TCP_OOO_QUEUE_LEN) {
+		printk("%u segments queued, expected %u\n", tcp->ooo_count,
+		       CONFIG_NET_TCP_OOO_QUEUE_LEN);
+		return false;
+	}
+
+	/* A segment after the ones queued cannot take their place */
+	pkt = v6_segment(tcp, base + (REORDERED + 1) * REORDERED_LEN,
+			 REORDERED_LEN);
+	if (!pkt || net_tcp_ooo_add(tcp, pkt) != -ENOMEM) {
+		printk("Segment queued beyond the limit\n");
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+
+	/* The lost segment comes at last */
+	tcp->send_ack = base + REORDERED_LEN;
+
+	while ((pkt = net_tcp_ooo_get(tcp))) {
+		if (sys_get_be32(NET_TCP_HDR(pkt)->seq) != tcp->send_ack) {
+			printk("Segment delivered out of order\n");
+			return false;
+		}
+
+		tcp->send_ack += net_pkt_appdatalen(pkt);
+		delivered++;
+		net_pkt_unref(pkt);
+	}
+
+	/* The peer sends again the segments dropped, all of them without
+	 * the queue.
+	 */
+	resent = REORDERED - delivered;
+
+	printk("%d segments reordered, %d to send again instead of %d\n",
+	       REORDERED, resent, REORDERED);
+
+	if (delivered != CONFIG_NET_TCP_OOO_QUEUE_LEN || tcp->ooo_count) {
+		printk("%d segments delivered, %u left in the queue\n",
+		       delivered, tcp->ooo_count);
+		return false;
+	}
+
+	tcp->send_ack = base;
+
+	return true;
+}
+
 #if 0
 static void connect_v6_cb(struct net_context *context, void *user_data)
 {
@@ -1463,6 +1704,9 @@ static const struct {
 	{ "test IPv4 TCP fin packet creation", test_create_v4_fin_packet },
 	{ "test IPv6 TCP seq check", test_v6_seq_check },
 	{ "test IPv4 TCP seq check", test_v4_seq_check },
+	{ "test IPv6 TCP SYN options", test_v6_syn_options },
+	{ "test IPv6 TCP SACK option", test_v6_sack_option },
+	{ "test IPv6 TCP out of order queue", test_v6_ooo_queue },
 	{ "test TCP reply context init", test_init_tcp_reply_context },
 	{ "test TCP accept init", test_init_tcp_accept },
 #if 0
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure TCP throughput with and without packet loss
+ *
+ * A client and a server connection talk to each other through a dummy
+ * interface that loops the packets back, and that drops one data segment
+ * out of DROP_INTERVAL in the second run. Each transfer is checked for
+ * data integrity, and the lost segments must be recovered by fast
+ * retransmit rather than by stalling the flow until the retransmission
+ * timer expires.
+ *
+ * In the third run, the interface delivers one data segment out of
+ * REORDER_INTERVAL after the next one. The receiver keeps the segment
+ * that arrives early, so reordering must not make the client send data
+ * again.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/net_context.h>
+
+#include "tcp.h"
+
+#define SERVER_PORT 4242
+
+#define SEGMENT_LEN 256
+#define TRANSFER_LEN (256 * 1024)
+#define MAX_QUEUED 16
+
+/* The drops and the reorderings are in the middle of each interval,
+ * never in the tail
+ */
+#define DROP_INTERVAL 64
+#define REORDER_INTERVAL 64
+
+/* Minimum retransmission timeout of the stack */
+#define MIN_RETRY_MS 200
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_context *client;
+static struct net_context *server;
+
+static K_SEM_DEFINE(accepted, 0, 1);
+static K_SEM_DEFINE(received_all, 0, 1);
+
+static u8_t send_buf[SEGMENT_LEN];
+static u8_t recv_buf[SEGMENT_LEN];
+
+/* updated by the interface TX thread */
+static int drop_interval;
+static int reorder_interval;
+static bool seq_valid;
+static u32_t next_seq;
+static u32_t new_segments;
+static u32_t dropped;
+static u32_t reordered;
+static u32_t resent;
+
+/* segment delivered after the next data segment */
+static struct net_pkt *held;
+
+enum segment_verdict {
+	SEGMENT_OTHER,
+	SEGMENT_DATA,
+	SEGMENT_DROP,
+	SEGMENT_HOLD,
+};
+
+/* updated by the RX thread */
+static u32_t received;
+static u32_t expected;
+static bool corrupted;
+
+struct tcp_loss_context {
+	u8_t mac_addr[6];
+};
+
+static struct tcp_loss_context tcp_loss_context_data;
+
+static int tcp_loss_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static void tcp_loss_iface_init(struct net_if *iface)
+{
+	struct tcp_loss_context *ctx = net_if_get_device(iface)->driver_data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	ctx->mac_addr[0] = 0x00;
+	ctx->mac_addr[1] = 0x00;
+	ctx->mac_addr[2] = 0x5E;
+	ctx->mac_addr[3] = 0x00;
+	ctx->mac_addr[4] = 0x53;
+	ctx->mac_addr[5] = 0x01;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+/* Drop the first transmission of one data segment to the server out of
+ * drop_interval, hold one out of reorder_interval, count the
+ * retransmissions.
+ */
+static enum segment_verdict check_segment(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr *tcphdr = NET_TCP_HDR(pkt);
+	u32_t seq = sys_get_be32(tcphdr->seq);
+	u16_t len;
+
+	len = net_pkt_get_len(pkt) - NET_IPV6H_LEN - 4 * (tcphdr->offset >> 4);
+
+	if (!len || tcphdr->dst_port != htons(SERVER_PORT)) {
+		return SEGMENT_OTHER;
+	}
+
+	if (!seq_valid) {
+		next_seq = seq;
+		seq_valid = true;
+	}
+
+	if (seq != next_seq) {
+		resent++;
+		return SEGMENT_DATA;
+	}
+
+	next_seq += len;
+	new_segments++;
+
+	if (drop_interval &&
+	    new_segments % drop_interval == drop_interval / 2) {
+		dropped++;
+		return SEGMENT_DROP;
+	}
+
+	if (reorder_interval &&
+	    new_segments % reorder_interval == reorder_interval / 2) {
+		reordered++;
+		return SEGMENT_HOLD;
+	}
+
+	return SEGMENT_DATA;
+}
+
+static void deliver(struct net_if *iface, struct net_pkt *pkt)
+{
+	if (net_recv_data(iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static int tester_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	enum segment_verdict verdict;
+	struct net_pkt *rx;
+
+	if (!pkt->frags) {
+		TC_ERROR("No data to send!\n");
+		return -ENODATA;
+	}
+
+	verdict = check_segment(pkt);
+	if (verdict == SEGMENT_DROP) {
+		net_pkt_unref(pkt);
+		return 0;
+	}
+
+	/* Both ends of the connection keep the packets they send for
+	 * retransmission, so hand over a copy.
+	 */
+	rx = net_pkt_get_reserve_rx(0, K_FOREVER);
+	rx->frags = net_pkt_copy_all(pkt, 0, K_FOREVER);
+
+	net_pkt_unref(pkt);
+
+	if (verdict == SEGMENT_HOLD) {
+		held = rx;
+		return 0;
+	}
+
+	deliver(iface, rx);
+
+	if (verdict == SEGMENT_DATA && held) {
+		deliver(iface, held);
+		held = NULL;
+	}
+
+	return 0;
+}
+
+static struct net_if_api tcp_loss_if_api = {
+	.init = tcp_loss_iface_init,
+	.send = tester_send,
+};
+
+#define _ETH_L2_LAYER DUMMY_L2
+#define _ETH_L2_CTX_TYPE NET_L2_GET_CTX_TYPE(DUMMY_L2)
+
+NET_DEVICE_INIT(tcp_loss, "tcp_loss", tcp_loss_dev_init,
+		&tcp_loss_context_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &tcp_loss_if_api,
+		_ETH_L2_LAYER, _ETH_L2_CTX_TYPE, 1280);
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    int status, void *user_data)
+{
+	u16_t len, pos, i;
+
+	if (!pkt) {
+		return;
+	}
+
+	len = min(net_pkt_appdatalen(pkt), sizeof(recv_buf));
+
+	net_frag_read(pkt->frags, net_pkt_get_len(pkt) - len, &pos, len,
+		      recv_buf);
+
+	for (i = 0; i < len; i++) {
+		if (recv_buf[i] != (u8_t)(received + i)) {
+			corrupted = true;
+		}
+	}
+
+	received += len;
+	if (received == expected) {
+		k_sem_give(&received_all);
+	}
+
+	net_pkt_unref(pkt);
+}
+
+static void accept_cb(struct net_context *context, struct sockaddr *addr,
+		      socklen_t addrlen, int status, void *user_data)
+{
+	if (status) {
+		return;
+	}
+
+	server = context;
+
+	net_context_recv(server, recv_cb, K_NO_WAIT, NULL);
+
+	k_sem_give(&accepted);
+}
+
+static bool setup(void)
+{
+	struct sockaddr_in6 server_addr = { .sin6_family = AF_INET6,
+					    .sin6_port = htons(SERVER_PORT) };
+	struct sockaddr_in6 client_addr = { .sin6_family = AF_INET6 };
+	struct net_context *listener;
+	struct net_if *iface = net_if_get_default();
+
+	net_ipaddr_copy(&server_addr.sin6_addr, &peer_addr);
+	net_ipaddr_copy(&client_addr.sin6_addr, &my_addr);
+
+	if (!net_if_ipv6_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0) ||
+	    !net_if_ipv6_addr_add(iface, &peer_addr, NET_ADDR_MANUAL, 0)) {
+		TC_ERROR("Cannot add IPv6 addresses\n");
+		return false;
+	}
+
+	if (net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &listener) ||
+	    net_context_bind(listener, (struct sockaddr *)&server_addr,
+			     sizeof(server_addr)) ||
+	    net_context_listen(listener, 0) ||
+	    net_context_accept(listener, accept_cb, K_NO_WAIT, NULL)) {
+		TC_ERROR("Cannot listen on port %d\n", SERVER_PORT);
+		return false;
+	}
+
+	if (net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &client) ||
+	    net_context_bind(client, (struct sockaddr *)&client_addr,
+			     sizeof(client_addr)) ||
+	    net_context_connect(client, (struct sockaddr *)&server_addr,
+				sizeof(server_addr), NULL, K_SECONDS(1),
+				NULL)) {
+		TC_ERROR("Cannot connect to port %d\n", SERVER_PORT);
+		return false;
+	}
+
+	if (k_sem_take(&accepted, K_SECONDS(1))) {
+		TC_ERROR("Connection not accepted\n");
+		return false;
+	}
+
+	return true;
+}
+
+static int queued_segments(void)
+{
+	struct net_pkt *pkt;
+	unsigned int key;
+	int count = 0;
+
+	key = irq_lock();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&client->tcp->sent_list, pkt,
+				     sent_list) {
+		count++;
+	}
+
+	irq_unlock(key);
+
+	return count;
+}
+
+static bool send_segment(u32_t offset)
+{
+	struct net_pkt *pkt;
+	int i;
+
+	for (i = 0; i < SEGMENT_LEN; i++) {
+		send_buf[i] = (u8_t)(offset + i);
+	}
+
+	pkt = net_pkt_get_tx(client, K_FOREVER);
+
+	if (!net_pkt_append_all(pkt, SEGMENT_LEN, send_buf, K_FOREVER) ||
+	    net_context_send(pkt, NULL, K_NO_WAIT, NULL, NULL) < 0) {
+		net_pkt_unref(pkt);
+		return false;
+	}
+
+	return true;
+}
+
+/* Returns the duration of the transfer in ms, 0 on failure */
+static u32_t transfer(const char *name, int drop, int reorder)
+{
+	u32_t base = expected;
+	u32_t offset, start, ms;
+
+	drop_interval = drop;
+	reorder_interval = reorder;
+	new_segments = 0;
+	dropped = 0;
+	reordered = 0;
+	resent = 0;
+	expected += TRANSFER_LEN;
+
+	start = k_uptime_get_32();
+
+	for (offset = 0; offset < TRANSFER_LEN; offset += SEGMENT_LEN) {
+		/* Leave the pools to the packets in flight and the ACKs */
+		while (queued_segments() >= MAX_QUEUED) {
+			k_sleep(1);
+		}
+
+		if (!send_segment(base + offset)) {
+			TC_ERROR("%s: cannot send data\n", name);
+			return 0;
+		}
+	}
+
+	if (k_sem_take(&received_all, K_SECONDS(30))) {
+		TC_ERROR("%s: %u bytes received out of %u\n", name,
+			 received, expected);
+		return 0;
+	}
+
+	ms = max(k_uptime_get_32() - start, 1);
+
+	TC_PRINT(" %s: %u bytes in %u ms, %u kB/s\n", name, TRANSFER_LEN, ms,
+		 TRANSFER_LEN / ms);
+	TC_PRINT(" %s: %u segments, %u dropped, %u reordered, %u sent again, "
+		 "cwnd %u ssthresh %u rto %u ms\n", name, new_segments,
+		 dropped, reordered, resent, client->tcp->cwnd,
+		 client->tcp->ssthresh, client->tcp->rto);
+
+	return ms;
+}
+
+void main(void)
+{
+	int status = TC_FAIL;
+	u32_t clean_ms, lossy_ms, reordered_ms;
+
+	TC_START("TCP with packet loss and reordering");
+
+	if (!setup()) {
+		goto out;
+	}
+
+	clean_ms = transfer("no loss  ", 0, 0);
+	if (!clean_ms) {
+		goto out;
+	}
+
+	lossy_ms = transfer("1/64 loss", DROP_INTERVAL, 0);
+	if (!lossy_ms) {
+		goto out;
+	}
+
+	/* If every loss stalled the flow until the retransmission timer
+	 * expired, the lossy transfer would take an extra minimum timeout
+	 * per segment dropped.
+	 */
+	if (!dropped || lossy_ms >= clean_ms + dropped * MIN_RETRY_MS / 2) {
+		TC_ERROR("Throughput did not recover from %u losses\n",
+			 dropped);
+		goto out;
+	}
+
+	reordered_ms = transfer("1/64 late", 0, REORDER_INTERVAL);
+	if (!reordered_ms) {
+		goto out;
+	}
+
+	/* Dropping the segments that arrive early would make the client
+	 * send at least one segment again per reordering.
+	 */
+	if (!reordered || resent >= reordered) {
+		TC_ERROR("%u segments sent again for %u reorderings\n",
+			 resent, reordered);
+		goto out;
+	}
+
+	if (corrupted) {
+		TC_ERROR("Received data corrupted\n");
+		goto out;
+	}
+
+	status = TC_PASS;
+
+out:
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
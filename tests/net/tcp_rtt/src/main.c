@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure TCP throughput against the round-trip time
+ *
+ * A client and a server connection talk to each other through a dummy
+ * interface that loops the packets back after a delay, so that the
+ * round-trip time takes each of the values of rtt_ms[] in turn. Without
+ * loss, the throughput is bounded by the receive window divided by the
+ * round-trip time once the congestion window has opened.
+ *
+ * Build with prj.conf for a window of 96 kB, advertised with window
+ * scaling, and with prj_small_window.conf for a window of 1280 bytes.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/net_context.h>
+
+#include "tcp.h"
+
+#define SERVER_PORT 4242
+
+#define SEGMENT_LEN 1024
+#define TRANSFER_LEN (128 * 1024)
+#define MAX_QUEUED 64
+
+#define DELAY_QUEUE_LEN 160
+#define DELAY_STACK_SIZE 1024
+#define DELAY_PRIO K_PRIO_COOP(7)
+
+static const u32_t rtt_ms[] = { 0, 10, 50, 100 };
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_context *client;
+static struct net_context *server;
+
+static K_SEM_DEFINE(accepted, 0, 1);
+static K_SEM_DEFINE(received_all, 0, 1);
+
+static u8_t send_buf[SEGMENT_LEN];
+static u8_t recv_buf[SEGMENT_LEN];
+
+/* packets on their way through the interface */
+struct delayed_pkt {
+	struct net_pkt *pkt;
+	struct net_if *iface;
+	u32_t due;
+};
+
+K_MSGQ_DEFINE(delay_msgq, sizeof(struct delayed_pkt), DELAY_QUEUE_LEN, 4);
+
+/* one-way delay, half the round-trip time */
+static u32_t delay_ms;
+
+/* updated by the RX thread */
+static u32_t received;
+static u32_t expected;
+static bool corrupted;
+
+struct tcp_rtt_context {
+	u8_t mac_addr[6];
+};
+
+static struct tcp_rtt_context tcp_rtt_context_data;
+
+static int tcp_rtt_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static void tcp_rtt_iface_init(struct net_if *iface)
+{
+	struct tcp_rtt_context *ctx = net_if_get_device(iface)->driver_data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	ctx->mac_addr[0] = 0x00;
+	ctx->mac_addr[1] = 0x00;
+	ctx->mac_addr[2] = 0x5E;
+	ctx->mac_addr[3] = 0x00;
+	ctx->mac_addr[4] = 0x53;
+	ctx->mac_addr[5] = 0x01;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int tester_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct delayed_pkt item;
+
+	if (!pkt->frags) {
+		TC_ERROR("No data to send!\n");
+		return -ENODATA;
+	}
+
+	/* Both ends of the connection keep the packets they send for
+	 * retransmission, so hand over a copy.
+	 */
+	item.pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+	item.pkt->frags = net_pkt_copy_all(pkt, 0, K_FOREVER);
+	item.iface = iface;
+	item.due = k_uptime_get_32() + delay_ms;
+
+	net_pkt_unref(pkt);
+
+	k_msgq_put(&delay_msgq, &item, K_FOREVER);
+
+	return 0;
+}
+
+/* Deliver the packets in the order they were sent, each one when its
+ * delay has elapsed.
+ */
+static void delay_thread(void)
+{
+	struct delayed_pkt item;
+	s32_t wait;
+
+	while (1) {
+		k_msgq_get(&delay_msgq, &item, K_FOREVER);
+
+		wait = item.due - k_uptime_get_32();
+		if (wait > 0) {
+			k_sleep(wait);
+		}
+
+		if (net_recv_data(item.iface, item.pkt) < 0) {
+			net_pkt_unref(item.pkt);
+		}
+	}
+}
+
+K_THREAD_DEFINE(delay_tid, DELAY_STACK_SIZE, delay_thread, NULL, NULL, NULL,
+		DELAY_PRIO, 0, K_NO_WAIT);
+
+static struct net_if_api tcp_rtt_if_api = {
+	.init = tcp_rtt_iface_init,
+	.send = tester_send,
+};
+
+#define _ETH_L2_LAYER DUMMY_L2
+#define _ETH_L2_CTX_TYPE NET_L2_GET_CTX_TYPE(DUMMY_L2)
+
+NET_DEVICE_INIT(tcp_rtt, "tcp_rtt", tcp_rtt_dev_init,
+		&tcp_rtt_context_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &tcp_rtt_if_api,
+		_ETH_L2_LAYER, _ETH_L2_CTX_TYPE, 1280);
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    int status, void *user_data)
+{
+	u16_t len, pos, i;
+
+	if (!pkt) {
+		return;
+	}
+
+	len = min(net_pkt_appdatalen(pkt), sizeof(recv_buf));
+
+	net_frag_read(pkt->frags, net_pkt_get_len(pkt) - len, &pos, len,
+		      recv_buf);
+
+	for (i = 0; i < len; i++) {
+		if (recv_buf[i] != (u8_t)(received + i)) {
+			corrupted = true;
+		}
+	}
+
+	received += len;
+	if (received == expected) {
+		k_sem_give(&received_all);
+	}
+
+	net_pkt_unref(pkt);
+}
+
+static void accept_cb(struct net_context *context, struct sockaddr *addr,
+		      socklen_t addrlen, int status, void *user_data)
+{
+	if (status) {
+		return;
+	}
+
+	server = context;
+
+	net_context_recv(server, recv_cb, K_NO_WAIT, NULL);
+
+	k_sem_give(&accepted);
+}
+
+static bool setup(void)
+{
+	struct sockaddr_in6 server_addr = { .sin6_family = AF_INET6,
+					    .sin6_port = htons(SERVER_PORT) };
+	struct sockaddr_in6 client_addr = { .sin6_family = AF_INET6 };
+	struct net_context *listener;
+	struct net_if *iface = net_if_get_default();
+
+	net_ipaddr_copy(&server_addr.sin6_addr, &peer_addr);
+	net_ipaddr_copy(&client_addr.sin6_addr, &my_addr);
+
+	if (!net_if_ipv6_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0) ||
+	    !net_if_ipv6_addr_add(iface, &peer_addr, NET_ADDR_MANUAL, 0)) {
+		TC_ERROR("Cannot add IPv6 addresses\n");
+		return false;
+	}
+
+	if (net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &listener) ||
+	    net_context_bind(listener, (struct sockaddr *)&server_addr,
+			     sizeof(server_addr)) ||
+	    net_context_listen(listener, 0) ||
+	    net_context_accept(listener, accept_cb, K_NO_WAIT, NULL)) {
+		TC_ERROR("Cannot listen on port %d\n", SERVER_PORT);
+		return false;
+	}
+
+	if (net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &client) ||
+	    net_context_bind(client, (struct sockaddr *)&client_addr,
+			     sizeof(client_addr)) ||
+	    net_context_connect(client, (struct sockaddr *)&server_addr,
+				sizeof(server_addr), NULL, K_SECONDS(1),
+				NULL)) {
+		TC_ERROR("Cannot connect to port %d\n", SERVER_PORT);
+		return false;
+	}
+
+	if (k_sem_take(&accepted, K_SECONDS(1))) {
+		TC_ERROR("Connection not accepted\n");
+		return false;
+	}
+
+	return true;
+}
+
+static int queued_segments(void)
+{
+	struct net_pkt *pkt;
+	unsigned int key;
+	int count = 0;
+
+	key = irq_lock();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&client->tcp->sent_list, pkt,
+				     sent_list) {
+		count++;
+	}
+
+	irq_unlock(key);
+
+	return count;
+}
+
+static bool send_segment(u32_t offset)
+{
+	struct net_pkt *pkt;
+	int i;
+
+	for (i = 0; i < SEGMENT_LEN; i++) {
+		send_buf[i] = (u8_t)(offset + i);
+	}
+
+	pkt = net_pkt_get_tx(client, K_FOREVER);
+
+	if (!net_pkt_append_all(pkt, SEGMENT_LEN, send_buf, K_FOREVER) ||
+	    net_context_send(pkt, NULL, K_NO_WAIT, NULL, NULL) < 0) {
+		net_pkt_unref(pkt);
+		return false;
+	}
+
+	return true;
+}
+
+static bool transfer(u32_t rtt)
+{
+	u32_t base = expected;
+	u32_t offset, start, ms;
+
+	delay_ms = rtt / 2;
+	expected += TRANSFER_LEN;
+
+	start = k_uptime_get_32();
+
+	for (offset = 0; offset < TRANSFER_LEN; offset += SEGMENT_LEN) {
+		/* Leave the pools to the packets in flight and the ACKs */
+		while (queued_segments() >= MAX_QUEUED) {
+			k_sleep(1);
+		}
+
+		if (!send_segment(base + offset)) {
+			TC_ERROR("RTT %u ms: cannot send data\n", rtt);
+			return false;
+		}
+	}
+
+	if (k_sem_take(&received_all, K_SECONDS(60))) {
+		TC_ERROR("RTT %u ms: %u bytes received out of %u\n", rtt,
+			 received, expected);
+		return false;
+	}
+
+	ms = max(k_uptime_get_32() - start, 1);
+
+	TC_PRINT(" RTT %3u ms: %u bytes in %5u ms, %5u kB/s, srtt %u ms, "
+		 "cwnd %u\n", rtt, TRANSFER_LEN, ms, TRANSFER_LEN / ms,
+		 client->tcp->srtt >> 3, client->tcp->cwnd);
+
+	return true;
+}
+
+void main(void)
+{
+	int status = TC_FAIL;
+	int i;
+
+	TC_START("TCP throughput against round-trip time");
+
+	if (!setup()) {
+		goto out;
+	}
+
+	TC_PRINT("Receive window %u bytes, window scale %u, sack %d, "
+		 "timestamps %d\n", CONFIG_NET_TCP_RECV_WINDOW,
+		 client->tcp->send_wscale,
+		 !!(client->tcp->ext & NET_TCP_EXT_SACK),
+		 !!(client->tcp->ext & NET_TCP_EXT_TS));
+
+	for (i = 0; i < ARRAY_SIZE(rtt_ms); i++) {
+		if (!transfer(rtt_ms[i])) {
+			goto out;
+		}
+	}
+
+	if (corrupted) {
+		TC_ERROR("Received data corrupted\n");
+		goto out;
+	}
+
+	status = TC_PASS;
+
+out:
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
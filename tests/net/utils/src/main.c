@@ -365,6 +365,74 @@ static bool run_tests(void)
 	}
 	net_pkt_unref(pkt);
 
+	/* Odd sized fragments with an empty one between them */
+	pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+	frag = net_pkt_get_reserve_rx_data(10, K_FOREVER);
+	net_pkt_frag_add(pkt, frag);
+	memcpy(net_buf_add(frag, sizeof(struct net_ipv6_hdr) + 7), pkt1,
+	       sizeof(struct net_ipv6_hdr) + 7);
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	hdr_len = net_pkt_ip_hdr_len(pkt);
+	orig_chksum = (frag->data[hdr_len + 2] << 8) + frag->data[hdr_len + 3];
+	frag->data[hdr_len + 2] = 0;
+	frag->data[hdr_len + 3] = 0;
+
+	frag = net_pkt_get_reserve_rx_data(10, K_FOREVER);
+	net_pkt_frag_add(pkt, frag);
+
+	frag = net_pkt_get_reserve_rx_data(10, K_FOREVER);
+	net_pkt_frag_add(pkt, frag);
+	memcpy(net_buf_add(frag, sizeof(pkt1) - hdr_len - 7),
+	       pkt1 + hdr_len + 7, sizeof(pkt1) - hdr_len - 7);
+
+	chksum = ntohs(~net_calc_chksum(pkt, IPPROTO_ICMPV6));
+	if (chksum != orig_chksum) {
+		printk("Invalid chksum 0x%x in pkt1 with empty fragment, "
+		       "should be 0x%x\n", chksum, orig_chksum);
+		return false;
+	}
+	net_pkt_unref(pkt);
+
+	/* Update the checksum of a packet for a change of its ICMP
+	 * identifier and sequence number, and compare with the checksum
+	 * of the changed packet.
+	 */
+	pkt = net_pkt_get_reserve_rx(0, K_FOREVER);
+	frag = net_pkt_get_reserve_rx_data(10, K_FOREVER);
+	net_pkt_frag_add(pkt, frag);
+	memcpy(net_buf_add(frag, sizeof(pkt1)), pkt1, sizeof(pkt1));
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	hdr_len = net_pkt_ip_hdr_len(pkt);
+	do {
+		u8_t old_data[4], new_data[4] = { 0x12, 0x34, 0xfe, 0xdc };
+		u16_t updated;
+
+		memcpy(old_data, &frag->data[hdr_len + 4], sizeof(old_data));
+		memcpy(&frag->data[hdr_len + 4], new_data, sizeof(new_data));
+
+		updated = ntohs(net_chksum_update(htons(orig_chksum), old_data,
+						  new_data, sizeof(new_data)));
+
+		frag->data[hdr_len + 2] = 0;
+		frag->data[hdr_len + 3] = 0;
+
+		chksum = ntohs(~net_calc_chksum(pkt, IPPROTO_ICMPV6));
+		if (chksum != updated) {
+			printk("Invalid updated chksum 0x%x in pkt1, "
+			       "should be 0x%x\n", updated, chksum);
+			return false;
+		}
+	} while (0);
+	net_pkt_unref(pkt);
+
 	return true;
 }
 
@@ -7,20 +7,74 @@
 #include <ztest.h>
 
 #include <drivers/crc/crc16_sw.c>
+#include <drivers/crc/crc32_sw.c>
+
+static u8_t test0[] = { };
+static u8_t test1[] = { 'A' };
+static u8_t test2[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
 
 void test_crc16(void)
 {
-	u8_t test0[] = { };
-	u8_t test1[] = { 'A' };
-	u8_t test2[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
-
 	zassert(crc16_ccitt(test0, sizeof(test0)) == 0x1d0f, "pass", "fail");
 	zassert(crc16_ccitt(test1, sizeof(test1)) == 0x9479, "pass", "fail");
 	zassert(crc16_ccitt(test2, sizeof(test2)) == 0xe5cc, "pass", "fail");
+
+	zassert(crc16_ansi(test0, sizeof(test0)) == 0x800d, "pass", "fail");
+	zassert(crc16_ansi(test2, sizeof(test2)) == 0x9ecf, "pass", "fail");
+
+	/* polynomial without table */
+	zassert(crc16(test2, sizeof(test2), 0x3d65, 0) == 0x3d48,
+		"pass", "fail");
+}
+
+void test_crc16_update(void)
+{
+	u16_t crc;
+	size_t i;
+
+	for (i = 0; i <= sizeof(test2); i++) {
+		crc = crc16_ccitt(test2, i);
+		crc = crc16_ccitt_update(crc, test2 + i, sizeof(test2) - i);
+		zassert(crc == 0xe5cc, "pass", "fail");
+
+		crc = crc16_ansi(test2, i);
+		crc = crc16_ansi_update(crc, test2 + i, sizeof(test2) - i);
+		zassert(crc == 0x9ecf, "pass", "fail");
+	}
+}
+
+void test_crc32(void)
+{
+	zassert(crc32_ieee(test0, sizeof(test0)) == 0x00000000, "pass", "fail");
+	zassert(crc32_ieee(test1, sizeof(test1)) == 0xd3d99e8b, "pass", "fail");
+	zassert(crc32_ieee(test2, sizeof(test2)) == 0xcbf43926, "pass", "fail");
+
+	zassert(crc32c(test0, sizeof(test0)) == 0x00000000, "pass", "fail");
+	zassert(crc32c(test2, sizeof(test2)) == 0xe3069283, "pass", "fail");
+}
+
+void test_crc32_update(void)
+{
+	u32_t crc;
+	size_t i;
+
+	for (i = 0; i <= sizeof(test2); i++) {
+		crc = crc32_ieee(test2, i);
+		crc = crc32_ieee_update(crc, test2 + i, sizeof(test2) - i);
+		zassert(crc == 0xcbf43926, "pass", "fail");
+
+		crc = crc32c(test2, i);
+		crc = crc32c_update(crc, test2 + i, sizeof(test2) - i);
+		zassert(crc == 0xe3069283, "pass", "fail");
+	}
 }
 
 void test_main(void *p1, void *p2, void *p3)
 {
-	ztest_test_suite(test_crc16, ztest_unit_test(test_crc16));
-	ztest_run_test_suite(test_crc16);
+	ztest_test_suite(test_crc,
+			 ztest_unit_test(test_crc16),
+			 ztest_unit_test(test_crc16_update),
+			 ztest_unit_test(test_crc32),
+			 ztest_unit_test(test_crc32_update));
+	ztest_run_test_suite(test_crc);
 }
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <misc/byte_ring.c>
+
+#define RING_POW 6
+#define RING_SIZE (1 << RING_POW)
+
+#define SPSC_BYTES (1024 * 1024)
+
+SYS_BYTE_RING_DECLARE_POW2(ring, RING_POW);
+
+static u8_t data[RING_SIZE * 2];
+
+static void fill(u8_t *buf, u32_t size, u8_t first)
+{
+	u32_t i;
+
+	for (i = 0; i < size; i++) {
+		buf[i] = first + i;
+	}
+}
+
+static void test_byte_ring_put_get(void)
+{
+	u8_t rx[RING_SIZE * 2];
+
+	sys_byte_ring_init(&ring, RING_SIZE, ring.buf);
+	fill(data, sizeof(data), 0);
+
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+	zassert_equal(sys_byte_ring_get(&ring, rx, sizeof(rx)), 0, NULL);
+
+	/* the whole data area can be used */
+	zassert_equal(sys_byte_ring_put(&ring, data, sizeof(data)), RING_SIZE,
+		      NULL);
+	zassert_equal(sys_byte_ring_space_get(&ring), 0, NULL);
+	zassert_equal(sys_byte_ring_put(&ring, data, 1), 0, NULL);
+
+	zassert_equal(sys_byte_ring_get(&ring, rx, 10), 10, NULL);
+	zassert_equal(sys_byte_ring_used_get(&ring), RING_SIZE - 10, NULL);
+	zassert_equal(sys_byte_ring_get(&ring, rx + 10, sizeof(rx)),
+		      RING_SIZE - 10, NULL);
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+	zassert_equal(memcmp(rx, data, RING_SIZE), 0, NULL);
+}
+
+static void test_byte_ring_wrap(void)
+{
+	static const u32_t sizes[] = { 1, 7, 13, RING_SIZE - 1, RING_SIZE };
+	u8_t rx[RING_SIZE];
+	u8_t next = 0;
+	int i;
+
+	sys_byte_ring_init(&ring, RING_SIZE, ring.buf);
+
+	/* offset the indexes so that they wrap around at 2^32 too */
+	ring.head = ring.tail = 0xfffffff0;
+
+	for (i = 0; i < 200; i++) {
+		u32_t size = sizes[i % ARRAY_SIZE(sizes)];
+
+		fill(data, size, next);
+		zassert_equal(sys_byte_ring_put(&ring, data, size), size, NULL);
+		zassert_equal(sys_byte_ring_used_get(&ring), size, NULL);
+		zassert_equal(sys_byte_ring_get(&ring, rx, sizeof(rx)), size,
+			      NULL);
+		zassert_equal(memcmp(rx, data, size), 0, NULL);
+		next += size;
+	}
+}
+
+static void test_byte_ring_claim(void)
+{
+	u8_t *region;
+	u32_t size;
+
+	sys_byte_ring_init(&ring, RING_SIZE, ring.buf);
+	fill(data, sizeof(data), 0);
+
+	/* move the indexes 10 bytes before the end of the data area */
+	sys_byte_ring_put(&ring, data, RING_SIZE - 10);
+	sys_byte_ring_get_commit(&ring, RING_SIZE - 10);
+
+	/* the free space is split at the end of the data area */
+	size = sys_byte_ring_put_claim(&ring, &region, RING_SIZE);
+	zassert_equal(size, 10, NULL);
+	zassert_equal(region, ring.buf + RING_SIZE - 10, NULL);
+	memcpy(region, data, size);
+	sys_byte_ring_put_commit(&ring, size);
+
+	size = sys_byte_ring_put_claim(&ring, &region, RING_SIZE);
+	zassert_equal(size, RING_SIZE - 10, NULL);
+	zassert_equal(region, ring.buf, NULL);
+
+	/* only part of the claimed region may be committed */
+	memcpy(region, data + 10, 20);
+	sys_byte_ring_put_commit(&ring, 20);
+	zassert_equal(sys_byte_ring_used_get(&ring), 30, NULL);
+
+	/* so is the data */
+	size = sys_byte_ring_get_claim(&ring, &region, RING_SIZE);
+	zassert_equal(size, 10, NULL);
+	zassert_equal(memcmp(region, data, size), 0, NULL);
+	sys_byte_ring_get_commit(&ring, size);
+
+	size = sys_byte_ring_get_claim(&ring, &region, 5);
+	zassert_equal(size, 5, NULL);
+	zassert_equal(memcmp(region, data + 10, size), 0, NULL);
+	sys_byte_ring_get_commit(&ring, size);
+
+	size = sys_byte_ring_get_claim(&ring, &region, RING_SIZE);
+	zassert_equal(size, 15, NULL);
+	zassert_equal(memcmp(region, data + 15, size), 0, NULL);
+	sys_byte_ring_get_commit(&ring, size);
+
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+	zassert_equal(sys_byte_ring_get_claim(&ring, &region, RING_SIZE), 0,
+		      NULL);
+}
+
+static void *producer(void *arg)
+{
+	u32_t sent = 0;
+	u8_t *region;
+	u32_t size, i;
+
+	/* alternate copies and in place writes of varying sizes */
+	while (sent < SPSC_BYTES) {
+		if (sent & 1) {
+			u8_t chunk[17];
+
+			size = min(sizeof(chunk), SPSC_BYTES - sent);
+			fill(chunk, size, sent);
+			sent += sys_byte_ring_put(&ring, chunk, size);
+			continue;
+		}
+
+		size = sys_byte_ring_put_claim(&ring, &region,
+					       SPSC_BYTES - sent);
+		for (i = 0; i < size; i++) {
+			region[i] = sent + i;
+		}
+		sys_byte_ring_put_commit(&ring, size);
+		sent += size;
+
+		if (!size) {
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void test_byte_ring_spsc(void)
+{
+	pthread_t thread;
+	u32_t received = 0;
+	u32_t errors = 0;
+	u8_t *region;
+	u32_t size, i;
+
+	sys_byte_ring_init(&ring, RING_SIZE, ring.buf);
+
+	zassert_equal(pthread_create(&thread, NULL, producer, NULL), 0, NULL);
+
+	while (received < SPSC_BYTES) {
+		u8_t chunk[23];
+
+		if (received & 1) {
+			size = sys_byte_ring_get(&ring, chunk, sizeof(chunk));
+			region = chunk;
+		} else {
+			size = sys_byte_ring_get_claim(&ring, &region,
+						       RING_SIZE);
+		}
+
+		for (i = 0; i < size; i++) {
+			if (region[i] != (u8_t)(received + i)) {
+				errors++;
+			}
+		}
+
+		if (region != chunk) {
+			sys_byte_ring_get_commit(&ring, size);
+		}
+		received += size;
+
+		if (!size) {
+			sched_yield();
+		}
+	}
+
+	pthread_join(thread, NULL);
+
+	zassert_equal(errors, 0, "bytes corrupted");
+	zassert_true(sys_byte_ring_is_empty(&ring), NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(byte_ring_test,
+			 ztest_unit_test(test_byte_ring_put_get),
+			 ztest_unit_test(test_byte_ring_wrap),
+			 ztest_unit_test(test_byte_ring_claim),
+			 ztest_unit_test(test_byte_ring_spsc));
+
+	ztest_run_test_suite(byte_ring_test);
+}